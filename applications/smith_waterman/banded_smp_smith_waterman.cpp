@@ -0,0 +1,772 @@
+//  Copyright (c) 2012 Stephanie Crillo and Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <hpxla/local_matrix.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+#include <hpxla/wavefront.hpp>
+
+#include "winner.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <boost/spirit/include/qi.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// Smith-Waterman for extending alignments around a known seed, where only
+// the cells near one diagonal of H matter. There are two modes:
+//
+// banded: Only the cells within a fixed distance of the diagonal are scored
+// (and stored). H is split into blocks as in the blocked implementation, but
+// the blocks which miss the band are never created, so the runtime is
+// proportional to the band's area, not to H's.
+//
+// x-drop: The alignment is extended from the start of both sequences one
+// anti-diagonal at a time, like BLAST's gapped extension. Cells which score
+// more than X below the best score so far are dropped, and the extension
+// stops when a whole anti-diagonal has been dropped. Only the live part of
+// the last two anti-diagonals is stored.
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C)
+{
+    return (std::max)((std::max)(A, B), C);
+}
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C, T const& D)
+{
+    return (std::max)((std::max)((std::max)(A, B), C), D);
+}
+
+enum gap_scoring
+{
+    gap      = -1,
+    match    = +2,
+    mismatch = -1
+};
+
+boost::int64_t score(char a, char b)
+{
+    return (a == b) ? match : mismatch;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The cells (i, j) with |j - i - offset| <= width, e.g. those within width
+// of the diagonal through the seed.
+struct band
+{
+    band(boost::int64_t offset_, boost::uint64_t width_)
+      : offset(offset_), width(width_)
+    {}
+
+    // The first and last columns of row i in the band (last may be less than
+    // first, if the band misses the row).
+    boost::int64_t first(boost::int64_t i) const
+    {
+        return i + offset - boost::int64_t(width);
+    }
+
+    boost::int64_t last(boost::int64_t i) const
+    {
+        return i + offset + boost::int64_t(width);
+    }
+
+    boost::int64_t offset;
+    boost::uint64_t width;
+};
+
+// The band of H, stored as one row of 2 * width + 1 cells for each row of H.
+// The cells outside of the band read as 0, which, as H is never negative,
+// is the same as leaving them out of the recurrence. The cells in the band
+// are only read once they have been scored, so they aren't initialized.
+struct banded_matrix
+{
+    banded_matrix(
+        std::string const& a_
+      , std::string const& b_
+      , band const& shape_
+      , boost::uint64_t grain_size_
+        )
+      : a(a_)
+      , b(b_)
+      , shape(shape_)
+      , grain_size(grain_size_)
+      , H(a_.size() + 1, 2 * shape_.width + 1, hpxla::uninitialized)
+      , winners((a_.size() + grain_size_ - 1) / grain_size_)
+    {}
+
+    boost::int64_t operator()(boost::uint64_t i, boost::uint64_t j) const
+    {
+        boost::int64_t const x = boost::int64_t(j) - shape.first(i);
+
+        if (  i == 0 || j == 0 || x < 0
+           || x > boost::int64_t(2 * shape.width))
+            return 0;
+
+        return H(i, x);
+    }
+
+    std::string const& a;
+    std::string const& b;
+
+    band const shape;
+    boost::uint64_t const grain_size;
+
+    hpxla::local_matrix<
+        boost::int64_t
+      , hpxla::local_matrix_policy<
+            hpxla::policy::row_major_indexing
+          , hpxla::policy::default_init_allocator<
+                std::allocator<hpx::util::unused_type>
+            >
+        >
+    > H;
+
+    // The best cell of each row of blocks. The blocks of a row run left to
+    // right, one at a time, so they can share this without atomics.
+    std::vector<winner> winners;
+};
+
+// The columns of blocks of each row of blocks which the band touches. A
+// block also has to run after the one above and to the left of it, if the
+// band holds the cell on its top-left corner's diagonal; so the band of the
+// row above the block row is included too, which makes the block to the left
+// part of the range.
+struct band_columns
+{
+    explicit band_columns(banded_matrix const& M_) : M(M_) {}
+
+    std::pair<boost::uint64_t, boost::uint64_t> operator()(
+        boost::uint64_t I
+        ) const
+    {
+        boost::int64_t const g = M.grain_size;
+        boost::int64_t const n = M.b.size();
+
+        boost::int64_t const first_row = I * g + 1;
+        boost::int64_t const last_row
+            = (std::min)(first_row + g, boost::int64_t(M.a.size() + 1)) - 1;
+
+        boost::int64_t const first
+            = (std::max)(M.shape.first(first_row - 1), boost::int64_t(1));
+        boost::int64_t const last
+            = (std::min)(M.shape.last(last_row), n);
+
+        if (first > last)
+            return std::make_pair(boost::uint64_t(0), boost::uint64_t(0));
+
+        return std::make_pair(boost::uint64_t((first - 1) / g)
+                            , boost::uint64_t((last - 1) / g + 1));
+    }
+
+    banded_matrix const& M;
+};
+
+// Scores the cells of the band in block (I, J).
+struct calc_block
+{
+    typedef void result_type;
+
+    explicit calc_block(banded_matrix& M_) : M(M_) {}
+
+    void operator()(
+        boost::uint64_t I
+      , boost::uint64_t J
+        ) const
+    {
+        boost::int64_t const g = M.grain_size;
+
+        boost::int64_t const i_begin = I * g + 1;
+        boost::int64_t const i_end
+            = (std::min)(i_begin + g, boost::int64_t(M.a.size() + 1));
+        boost::int64_t const j_begin = J * g + 1;
+        boost::int64_t const j_end
+            = (std::min)(j_begin + g, boost::int64_t(M.b.size() + 1));
+
+        winner& best = M.winners[I];
+
+        for (boost::int64_t i = i_begin; i < i_end; ++i)
+        {
+            boost::int64_t const first = (std::max)(j_begin, M.shape.first(i));
+            boost::int64_t const last
+                = (std::min)(j_end - 1, M.shape.last(i));
+
+            if (first > last)
+                continue;
+
+            char const ai = M.a[i-1];
+
+            boost::int64_t left = M(i, first - 1);
+
+            for (boost::int64_t j = first; j <= last; ++j)
+            {
+                boost::int64_t const value = maximum(boost::int64_t(0)
+                  , M(i-1, j-1) + score(ai, M.b[j-1])
+                  , M(i-1, j) + gap
+                  , left + gap);
+
+                M.H(i, j - M.shape.first(i)) = value;
+                left = value;
+
+                if (value >= best.value && better(winner(value, i, j), best))
+                    best = winner(value, i, j);
+            }
+        }
+    }
+
+    banded_matrix& M;
+};
+
+winner banded_sw(
+    std::string const& a
+  , std::string const& b
+  , band const& shape
+  , boost::uint64_t grain_size
+    )
+{
+    BOOST_ASSERT(grain_size != 0);
+
+    banded_matrix M(a, b, shape, grain_size);
+
+    boost::uint64_t const block_rows = (a.size() + grain_size - 1) / grain_size;
+    boost::uint64_t const block_cols = (b.size() + grain_size - 1) / grain_size;
+
+    hpxla::for_each_wavefront(hpxla::matrix_bounds(block_rows, block_cols)
+                            , calc_block(M), band_columns(M));
+
+    winner best;
+
+    for (boost::uint64_t I = 0; I < M.winners.size(); ++I)
+        if (better(M.winners[I], best))
+            best = M.winners[I];
+
+    return best;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Scores lower than this have been dropped.
+boost::int64_t const dropped = (std::numeric_limits<boost::int64_t>::min)() / 2;
+
+// The live cells of an anti-diagonal: those in rows [first, first + size()).
+struct antidiagonal
+{
+    antidiagonal() : first(0) {}
+
+    boost::int64_t operator[](boost::int64_t i) const
+    {
+        if (i < first || i >= first + boost::int64_t(cells.size()))
+            return dropped;
+
+        return cells[i - first];
+    }
+
+    boost::int64_t first;
+    std::vector<boost::int64_t> cells;
+};
+
+// Extends an alignment from the start of a and b. Unlike Smith-Waterman, the
+// alignment must start at (0, 0), so scores can be negative. Returns the best
+// cell.
+winner xdrop_sw(
+    std::string const& a
+  , std::string const& b
+  , boost::int64_t x_drop
+    )
+{
+    boost::int64_t const m = a.size();
+    boost::int64_t const n = b.size();
+
+    // Anti-diagonals t - 2 and t - 1, and t.
+    antidiagonal previous2, previous, current;
+
+    previous.cells.push_back(0);
+
+    winner best;
+
+    for (boost::int64_t t = 1; t <= m + n; ++t)
+    {
+        if (previous.cells.empty() && previous2.cells.empty())
+            break;
+
+        // A live cell can be reached from the live cells of the previous
+        // anti-diagonal by moving right (same i) or down (i + 1), or from the
+        // one before that by moving diagonally (i + 1).
+        boost::int64_t first = previous.first;
+        boost::int64_t last = previous.first + previous.cells.size();
+
+        if (!previous2.cells.empty())
+        {
+            if (previous.cells.empty())
+                first = previous2.first + 1;
+            else
+                first = (std::min)(first, previous2.first + 1);
+
+            last = (std::max)(last
+                , boost::int64_t(previous2.first + previous2.cells.size()) + 1);
+        }
+
+        first = (std::max)(first, t - n);
+        last = (std::min)(last, m);
+
+        boost::int64_t const floor = best.value - x_drop;
+
+        current.cells.clear();
+        current.first = first;
+
+        winner current_best = best;
+
+        for (boost::int64_t i = first; i <= last; ++i)
+        {
+            boost::int64_t const j = t - i;
+
+            boost::int64_t value = dropped;
+
+            if (i > 0 && j > 0)
+                value = (std::max)(value
+                                 , previous2[i-1] + score(a[i-1], b[j-1]));
+            if (i > 0)
+                value = (std::max)(value, previous[i-1] + gap);
+            if (j > 0)
+                value = (std::max)(value, previous[i] + gap);
+
+            if (value < floor)
+                value = dropped;
+
+            current.cells.push_back(value);
+
+            if (  value >= current_best.value
+               && better(winner(value, i, j), current_best))
+                current_best = winner(value, i, j);
+        }
+
+        // Trim the dropped cells from both ends.
+        std::vector<boost::int64_t>::iterator live_first
+            = current.cells.begin();
+        std::vector<boost::int64_t>::iterator live_last = current.cells.end();
+
+        while (live_first != live_last && *live_first == dropped)
+            ++live_first;
+        while (live_first != live_last && *(live_last - 1) == dropped)
+            --live_last;
+
+        current.first += live_first - current.cells.begin();
+        current.cells.erase(live_last, current.cells.end());
+        current.cells.erase(current.cells.begin(), live_first);
+
+        best = current_best;
+
+        std::swap(previous2, previous);
+        std::swap(previous, current);
+    }
+
+    return best;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Plain implementations with the whole of H, to check the others against.
+winner reference_banded_sw(
+    std::string const& a
+  , std::string const& b
+  , band const& shape
+    )
+{
+    hpxla::local_matrix<boost::int64_t> H(a.size() + 1, b.size() + 1, 0);
+
+    winner best;
+
+    for (boost::int64_t i = 1; i <= boost::int64_t(a.size()); ++i)
+    {
+        for (boost::int64_t j = 1; j <= boost::int64_t(b.size()); ++j)
+        {
+            if (j < shape.first(i) || j > shape.last(i))
+                continue;
+
+            H(i, j) = maximum(boost::int64_t(0)
+                            , H(i-1, j-1) + score(a[i-1], b[j-1])
+                            , H(i-1, j) + gap
+                            , H(i, j-1) + gap);
+
+            if (H(i, j) > best.value)
+                best = winner(H(i, j), i, j);
+        }
+    }
+
+    return best;
+}
+
+winner reference_xdrop_sw(
+    std::string const& a
+  , std::string const& b
+  , boost::int64_t x_drop
+    )
+{
+    boost::int64_t const m = a.size();
+    boost::int64_t const n = b.size();
+
+    hpxla::local_matrix<boost::int64_t> H(m + 1, n + 1, dropped);
+    H(0, 0) = 0;
+
+    winner best;
+
+    for (boost::int64_t t = 1; t <= m + n; ++t)
+    {
+        boost::int64_t const floor = best.value - x_drop;
+
+        winner current_best = best;
+
+        for (boost::int64_t i = (std::max)(t - n, boost::int64_t(0))
+           ; i <= (std::min)(t, m); ++i)
+        {
+            boost::int64_t const j = t - i;
+
+            boost::int64_t value = dropped;
+
+            if (i > 0 && j > 0)
+                value = (std::max)(value
+                                 , H(i-1, j-1) + score(a[i-1], b[j-1]));
+            if (i > 0)
+                value = (std::max)(value, H(i-1, j) + gap);
+            if (j > 0)
+                value = (std::max)(value, H(i, j-1) + gap);
+
+            H(i, j) = (value < floor) ? dropped : value;
+
+            if (  H(i, j) != dropped
+               && better(winner(H(i, j), i, j), current_best))
+                current_best = winner(H(i, j), i, j);
+        }
+
+        best = current_best;
+    }
+
+    return best;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string random_sequence(
+    boost::random::mt19937& rng
+  , boost::uint64_t length
+    )
+{
+    std::string const chars("ATGC");
+
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    std::string s;
+
+    for (boost::uint64_t x = 0; x < length; ++x)
+        s += chars[index_dist(rng)];
+
+    return s;
+}
+
+// Returns a copy of s with about one in ten characters substituted, and one
+// in a hundred inserted or deleted, which is what the band has to absorb.
+std::string mutate(
+    boost::random::mt19937& rng
+  , std::string const& s
+    )
+{
+    std::string const chars("ATGC");
+
+    boost::random::uniform_int_distribution<boost::uint32_t> percent(0, 99);
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    std::string t;
+
+    for (std::size_t x = 0; x < s.size(); ++x)
+    {
+        boost::uint32_t const p = percent(rng);
+
+        if (p < 10)
+            t += chars[index_dist(rng)];
+        else if (p == 10)
+            t += chars[index_dist(rng)] + s.substr(x, 1);
+        else if (p != 11)
+            t += s[x];
+    }
+
+    return t;
+}
+
+bool validate_banded_sw(
+    boost::random::mt19937& rng
+  , boost::uint64_t length
+  , boost::int64_t offset
+  , boost::uint64_t width
+  , boost::uint64_t grain_size
+    )
+{
+    std::string const a = random_sequence(rng, length);
+    std::string const b = mutate(rng, a);
+
+    band const shape(offset, width);
+
+    winner const expected = reference_banded_sw(a, b, shape);
+    winner const actual = banded_sw(a, b, shape, grain_size);
+
+    bool const valid = expected.value == actual.value
+                    && expected.i == actual.i
+                    && expected.j == actual.j;
+
+    std::cout << "banded validation, lengths " << a.size() << " x "
+              << b.size() << ", diagonal " << offset << ", band width "
+              << width << ", grain-size " << grain_size << ": "
+              << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
+bool validate_xdrop_sw(
+    boost::random::mt19937& rng
+  , boost::uint64_t length
+  , boost::int64_t x_drop
+  , bool related
+    )
+{
+    std::string const a = random_sequence(rng, length);
+    std::string const b = related ? mutate(rng, a)
+                                  : random_sequence(rng, length);
+
+    winner const expected = reference_xdrop_sw(a, b, x_drop);
+    winner const actual = xdrop_sw(a, b, x_drop);
+
+    bool const valid = expected.value == actual.value
+                    && expected.i == actual.i
+                    && expected.j == actual.j;
+
+    std::cout << "x-drop validation, lengths " << a.size() << " x "
+              << b.size() << ", " << (related ? "related" : "unrelated")
+              << ", x-drop " << x_drop << ": "
+              << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
+void benchmark_sw(
+    boost::random::mt19937& rng
+  , boost::uint32_t seed
+  , boost::uint32_t length
+  , boost::uint32_t grain_size
+  , bool xdrop
+  , boost::uint64_t width
+  , boost::int64_t x_drop
+  , boost::uint32_t iterations = 1 << 10
+    )
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Generate our sequences using the mt19937 random number generator.
+    std::string const a = random_sequence(rng, length);
+    std::string const b = mutate(rng, a);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Run the benchmark.
+    hpx::util::high_resolution_timer t;
+
+    for (boost::uint32_t x = 0; x < iterations; ++x)
+    {
+        if (xdrop)
+            xdrop_sw(a, b, x_drop);
+        else
+            banded_sw(a, b, band(0, width), grain_size);
+    }
+
+    double runtime = t.elapsed();
+
+    std::cout << seed << ","
+              << hpx::get_os_thread_count() << ","
+              << length << ","
+              << grain_size << ","
+              << (xdrop ? x_drop : boost::int64_t(width)) << ","
+              << iterations << ","
+              << runtime << "\n";
+}
+
+template <typename Iterator>
+bool read_list(Iterator first, Iterator last, std::vector<boost::uint32_t>& v)
+{
+    using boost::spirit::qi::uint_parser;
+    using boost::spirit::qi::phrase_parse;
+    using boost::spirit::qi::_1;
+    using boost::spirit::ascii::space;
+
+    uint_parser<boost::uint32_t> size_t_;
+
+    bool r = phrase_parse(first, last, size_t_ % ',', space, v);
+
+    if (first != last)
+        return false;
+
+    return r;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    ///////////////////////////////////////////////////////////////////////
+    // Handle commandline options.
+
+    // Initialize the PRNG seed.
+    boost::uint32_t seed = vm["seed"].as<boost::uint32_t>();
+
+    if (!seed)
+        seed = boost::uint32_t(std::time(0));
+
+    boost::uint32_t iterations = vm["iterations"].as<boost::uint32_t>();
+
+    // Parse lengths.
+    std::string raw_lengths = vm["lengths"].as<std::string>();
+
+    std::vector<boost::uint32_t> lengths;
+
+    if (!read_list(raw_lengths.begin(), raw_lengths.end(), lengths))
+        throw std::invalid_argument("--lengths argument not be parsed\n");
+
+    // Parse grain sizes.
+    std::string raw_grain_sizes = vm["grain-sizes"].as<std::string>();
+
+    std::vector<boost::uint32_t> grain_sizes;
+
+    if (!read_list(raw_grain_sizes.begin(), raw_grain_sizes.end(), grain_sizes))
+        throw std::invalid_argument("--grain-sizes could not be parsed\n");
+
+    if (grain_sizes.size() != lengths.size())
+        throw std::invalid_argument(
+            "--grain-sizes must have as many elements as --lengths\n");
+
+    if (std::count(grain_sizes.begin(), grain_sizes.end(), 0u))
+        throw std::invalid_argument("--grain-sizes must be greater than 0\n");
+
+    // Select the mode.
+    std::string const raw_mode = vm["mode"].as<std::string>();
+
+    if (raw_mode != "banded" && raw_mode != "x-drop")
+        throw std::invalid_argument("--mode must be banded or x-drop\n");
+
+    bool const xdrop = (raw_mode == "x-drop");
+
+    boost::uint64_t const width = vm["band-width"].as<boost::uint32_t>();
+    boost::int64_t const x_drop = vm["x-drop"].as<boost::uint32_t>();
+
+    boost::random::mt19937 rng(seed);
+
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Validate implementation.
+        if (vm.count("validate"))
+        {
+            bool valid = true;
+
+            valid = validate_banded_sw(rng, 8, 0, 0, 1) && valid;
+            valid = validate_banded_sw(rng, 100, 0, 3, 4) && valid;
+            valid = validate_banded_sw(rng, 100, 0, 3, 5) && valid;
+            valid = validate_banded_sw(rng, 300, 7, 16, 16) && valid;
+            valid = validate_banded_sw(rng, 300, -20, 9, 8) && valid;
+            valid = validate_banded_sw(rng, 500, 0, 32, 13) && valid;
+
+            // A band wider than H is the whole of H.
+            valid = validate_banded_sw(rng, 200, 0, 1000, 16) && valid;
+
+            valid = validate_xdrop_sw(rng, 100, 0, true) && valid;
+            valid = validate_xdrop_sw(rng, 300, 10, true) && valid;
+            valid = validate_xdrop_sw(rng, 300, 10, false) && valid;
+            valid = validate_xdrop_sw(rng, 500, 30, true) && valid;
+            valid = validate_xdrop_sw(rng, 500, 5, false) && valid;
+
+            // Nothing is ever dropped.
+            valid = validate_xdrop_sw(rng, 200, 1 << 20, false) && valid;
+
+            if (!valid)
+                throw std::runtime_error("validation failed\n");
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Benchmark implementation.
+
+        // Print out header rows.
+        if (!vm.count("no-header"))
+            std::cout
+                << "HPX Banded SMP Smith-Waterman Performance ("
+                << raw_mode << ")\n"
+                << "Seed,OS-Threads,Sequence Length,Grain Size,"
+                << (xdrop ? "X-Drop" : "Band Width") << ","
+                   "Iterations,Total Walltime (s)\n";
+
+        for (boost::uint32_t x = 0; x < lengths.size(); ++x)
+            benchmark_sw(rng, seed, lengths[x], grain_sizes[x], xdrop, width
+                       , x_drop, iterations);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char** argv)
+{
+    using namespace boost::program_options;
+
+    variables_map vm;
+
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "lengths"
+        , value<std::string>()->default_value("1024,16384,262144")
+        , "sequence lengths to use (comma seperated list); the second "
+          "sequence is a mutated copy of the first")
+
+        ( "grain-sizes"
+        , value<std::string>()->default_value("64,128,256")
+        , "rows and columns of each block of the banded mode to use (comma "
+          "seperated list, must have the same number of elements as "
+          "--lengths)")
+
+        ( "mode"
+        , value<std::string>()->default_value("banded")
+        , "alignment mode (banded: a band of fixed width around the main "
+          "diagonal, x-drop: extension from the start of both sequences "
+          "until the scores drop too far below the best)")
+
+        ( "band-width"
+        , value<boost::uint32_t>()->default_value(64)
+        , "cells on either side of the diagonal which are scored in the "
+          "banded mode")
+
+        ( "x-drop"
+        , value<boost::uint32_t>()->default_value(20)
+        , "how far below the best score a cell may be before it is dropped, "
+          "in the x-drop mode")
+
+        ( "validate"
+        , "run validation code before performing benchmarks")
+
+        ( "no-header"
+        , "do not print out the CSV header for the benchmark data")
+
+        ( "iterations"
+        , value<boost::uint32_t>()->default_value(64)
+        , "number of tests to perform for each sequence length")
+
+        ( "seed"
+        , value<boost::uint32_t>()->default_value(0)
+        , "seed for the pseudo random number generator (if 0, a seed is "
+          "choosen based on the current system time)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
+
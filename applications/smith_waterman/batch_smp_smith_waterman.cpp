@@ -0,0 +1,842 @@
+//  Copyright (c) 2012 Stephanie Crillo and Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include "fasta.hpp"
+#include "scoring.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <boost/ref.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// Many-to-many Smith-Waterman. Every query in one FASTA file is aligned with
+// every sequence of another (the database), and the best score of each pair
+// is written out as a line of tab-separated values.
+//
+// The database is read a chunk of sequences at a time. Each chunk is sorted
+// by length and split into groups of sequences, one per SIMD lane, which are
+// scored against a query together: lane l of every vector belongs to the l-th
+// sequence of the group (inter-sequence SIMD). Each (query, chunk) pair is an
+// HPX task, and the results are written in input order as the tasks finish.
+//
+// The scoring schemes are in scoring.hpp.
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C)
+{
+    return (std::max)((std::max)(A, B), C);
+}
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C, T const& D)
+{
+    return (std::max)((std::max)((std::max)(A, B), C), D);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The residues which appear in the queries. The profiles of the database
+// sequences only need a row for each of these.
+struct alphabet
+{
+    alphabet() : residues()
+    {
+        std::fill(codes, codes + 256, 0);
+    }
+
+    // Returns the code of c, adding it if it hasn't been seen.
+    boost::uint8_t add(char c)
+    {
+        std::size_t const x = residues.find(c);
+
+        if (x != std::string::npos)
+            return codes[static_cast<unsigned char>(c)];
+
+        BOOST_ASSERT(residues.size() < 256);
+
+        codes[static_cast<unsigned char>(c)] = boost::uint8_t(residues.size());
+        residues += c;
+
+        return codes[static_cast<unsigned char>(c)];
+    }
+
+    std::string residues;
+    boost::uint8_t codes[256];
+};
+
+struct query
+{
+    std::string name;
+    std::string sequence;
+
+    // The sequence, as codes of the alphabet.
+    std::vector<boost::uint8_t> codes;
+};
+
+struct target
+{
+    std::string name;
+    std::string sequence;
+};
+
+// The profile of a group of database sequences for lanes of type T: the
+// score of each residue of the alphabet against column j of each sequence,
+// laid out as [j][residue][lane]. Lanes past the end of their sequence (or
+// past the end of the group) get the lowest score.
+template <
+    typename T
+  , typename Scoring
+>
+std::vector<T> build_profile(
+    alphabet const& residues
+  , std::vector<target const*> const& group
+  , std::size_t length
+  , boost::int32_t bias
+  , Scoring const& scoring
+    )
+{
+    std::size_t const width = simd::lanes<T>::width;
+    std::size_t const K = residues.residues.size();
+
+    BOOST_ASSERT(group.size() <= width);
+
+    std::vector<T> profile(length * K * width, T(Scoring::min_score + bias));
+
+    for (std::size_t l = 0; l < group.size(); ++l)
+    {
+        std::string const& s = group[l]->sequence;
+
+        for (std::size_t j = 0; j < s.size(); ++j)
+            for (std::size_t k = 0; k < K; ++k)
+                profile[(j * K + k) * width + l]
+                    = T(scoring.score(residues.residues[k], s[j]) + bias);
+    }
+
+    return profile;
+}
+
+// Scores q against the sequences of a group at once, using the profile of the
+// group. Returns false if a score could have saturated; the group must then
+// be rescored with wider lanes. H, E and F are as in Gotoh's algorithm; 8-bit
+// lanes are unsigned, and their profile is biased as in the striped kernel.
+template <
+    typename T
+  , typename Scoring
+>
+bool score_group(
+    query const& q
+  , std::size_t K
+  , std::vector<T> const& profile
+  , std::size_t length
+  , Scoring const& scoring
+  , boost::int64_t* scores
+    )
+{
+    typedef simd::lanes<T> L;
+    typedef typename L::type vector_type;
+
+    std::size_t const width = L::width;
+    std::size_t const m = q.codes.size();
+
+    boost::int32_t const bias
+        = std::numeric_limits<T>::is_signed ? 0 : -Scoring::min_score;
+
+    // If no score is above this, none of them saturated.
+    boost::int32_t const ceiling = L::limit - (Scoring::max_score + bias);
+
+    T const floor
+        = std::numeric_limits<T>::is_signed ? T(-scoring.gap_open()) : T(0);
+
+    // H and E for the previous column.
+    std::vector<T> H(m * width, T(0));
+    std::vector<T> E(m * width, floor);
+
+    vector_type const zero = L::splat(T(0));
+    vector_type const v_bias = L::splat(T(bias));
+    vector_type const v_gap_open = L::splat(T(scoring.gap_open()));
+    vector_type const v_gap_extend = L::splat(T(scoring.gap_extend()));
+
+    vector_type H_max = zero;
+
+    for (std::size_t j = 0; j < length; ++j)
+    {
+        T const* P = &profile[j * K * width];
+
+        vector_type diagonal = zero;
+        vector_type F = L::splat(floor);
+
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            vector_type const left = L::load(&H[i * width]);
+            vector_type const e = L::load(&E[i * width]);
+
+            vector_type h = L::adds(diagonal, L::load(P + q.codes[i] * width));
+            h = L::subs(h, v_bias);
+            h = L::max(L::max(h, zero), L::max(e, F));
+
+            H_max = L::max(H_max, h);
+            L::store(&H[i * width], h);
+
+            diagonal = left;
+
+            h = L::subs(h, v_gap_open);
+            L::store(&E[i * width], L::max(L::subs(e, v_gap_extend), h));
+            F = L::max(L::subs(F, v_gap_extend), h);
+        }
+    }
+
+    T best[simd::lanes<T>::width];
+    L::store(best, H_max);
+
+    for (std::size_t l = 0; l < width; ++l)
+    {
+        if (best[l] > ceiling)
+            return false;
+
+        scores[l] = best[l];
+    }
+
+    return true;
+}
+
+// The lanes to retry with when a score saturates T's.
+template <typename T>
+struct wider;
+
+template <>
+struct wider<boost::uint8_t> { typedef boost::int16_t type; };
+
+template <>
+struct wider<boost::int16_t> { typedef boost::int32_t type; };
+
+template <>
+struct wider<boost::int32_t> { typedef boost::int32_t type; };
+
+// Scores q against a group with lanes of type T, splitting it into groups
+// that fit T's lanes, and rescoring the groups with wider lanes if any of
+// their scores saturate.
+template <
+    typename T
+  , typename Scoring
+>
+void score_subgroups(
+    query const& q
+  , alphabet const& residues
+  , std::vector<target const*> const& group
+  , Scoring const& scoring
+  , boost::int64_t* scores
+    )
+{
+    std::size_t const width = simd::lanes<T>::width;
+
+    boost::int32_t const bias
+        = std::numeric_limits<T>::is_signed ? 0 : -Scoring::min_score;
+
+    for (std::size_t first = 0; first < group.size(); first += width)
+    {
+        std::vector<target const*> const subgroup(group.begin() + first
+          , group.begin() + (std::min)(first + width, group.size()));
+
+        std::size_t length = 0;
+
+        for (std::size_t l = 0; l < subgroup.size(); ++l)
+            length = (std::max)(length, subgroup[l]->sequence.size());
+
+        std::vector<T> const profile
+            = build_profile<T>(residues, subgroup, length, bias, scoring);
+
+        boost::int64_t lane_scores[simd::lanes<T>::width];
+
+        if (score_group<T>(q, residues.residues.size(), profile, length
+                         , scoring, lane_scores))
+            std::copy(lane_scores, lane_scores + subgroup.size()
+                    , scores + first);
+
+        else
+        {
+            // 32-bit lanes don't saturate for any sequences we can hold.
+            BOOST_ASSERT(sizeof(T) < sizeof(boost::int32_t));
+
+            score_subgroups<typename wider<T>::type>(q, residues, subgroup
+                                                   , scoring, scores + first);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A chunk of the database, split into groups of similar lengths, with the
+// profiles of the groups for 8-bit lanes; these are shared by all of the
+// queries.
+struct chunk
+{
+    std::vector<target> targets;
+
+    // The members of each group (as indices into targets), and its profile.
+    std::vector<std::vector<std::size_t> > groups;
+    std::vector<std::vector<boost::uint8_t> > profiles;
+    std::vector<std::size_t> lengths;
+};
+
+template <typename Scoring>
+boost::shared_ptr<chunk> read_chunk(
+    fasta::reader& database
+  , std::size_t chunk_size
+  , alphabet const& residues
+  , Scoring const& scoring
+    )
+{
+    boost::shared_ptr<chunk> c = boost::make_shared<chunk>();
+
+    fasta::record r;
+
+    while (c->targets.size() < chunk_size && database.next(r))
+    {
+        target t;
+        t.name = r.name();
+        t.sequence = r.sequence();
+        c->targets.push_back(t);
+    }
+
+    // Sort by length, so that the sequences in a group are similar in length
+    // and little of each group is padding.
+    std::vector<std::pair<std::size_t, std::size_t> > order;
+
+    for (std::size_t x = 0; x < c->targets.size(); ++x)
+        order.push_back(std::make_pair(c->targets[x].sequence.size(), x));
+
+    std::sort(order.begin(), order.end());
+
+    std::size_t const width = simd::lanes<boost::uint8_t>::width;
+
+    for (std::size_t first = 0; first < order.size(); first += width)
+    {
+        std::size_t const last = (std::min)(first + width, order.size());
+
+        std::vector<std::size_t> members;
+        std::vector<target const*> group;
+
+        for (std::size_t x = first; x < last; ++x)
+        {
+            members.push_back(order[x].second);
+            group.push_back(&c->targets[order[x].second]);
+        }
+
+        std::size_t const length = order[last - 1].first;
+
+        c->groups.push_back(members);
+        c->lengths.push_back(length);
+        c->profiles.push_back(build_profile<boost::uint8_t>(
+            residues, group, length, -Scoring::min_score, scoring));
+    }
+
+    return c;
+}
+
+/// Returns the scores of q against each sequence of c, in the order of the
+/// database.
+template <typename Scoring>
+std::vector<boost::int64_t> score_chunk(
+    query const& q
+  , alphabet const& residues
+  , boost::shared_ptr<chunk const> c
+  , Scoring const& scoring
+    )
+{
+    std::vector<boost::int64_t> scores(c->targets.size(), 0);
+
+    std::size_t const width = simd::lanes<boost::uint8_t>::width;
+
+    for (std::size_t g = 0; g < c->groups.size(); ++g)
+    {
+        std::vector<std::size_t> const& members = c->groups[g];
+
+        boost::int64_t lane_scores[simd::lanes<boost::uint8_t>::width];
+
+        bool const fits = score_group<boost::uint8_t>(q
+          , residues.residues.size(), c->profiles[g], c->lengths[g], scoring
+          , lane_scores);
+
+        if (!fits)
+        {
+            std::vector<target const*> group;
+
+            for (std::size_t x = 0; x < members.size(); ++x)
+                group.push_back(&c->targets[members[x]]);
+
+            score_subgroups<boost::int16_t>(q, residues
+              , group, scoring, lane_scores);
+        }
+
+        BOOST_ASSERT(members.size() <= width);
+
+        for (std::size_t x = 0; x < members.size(); ++x)
+            scores[members[x]] = lane_scores[x];
+    }
+
+    return scores;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<query> read_queries(
+    fasta::reader queries
+  , alphabet& residues
+    )
+{
+    std::vector<query> v;
+
+    fasta::record r;
+
+    while (queries.next(r))
+    {
+        query q;
+        q.name = r.name();
+        q.sequence = r.sequence();
+
+        for (std::size_t i = 0; i < q.sequence.size(); ++i)
+            q.codes.push_back(residues.add(q.sequence[i]));
+
+        v.push_back(q);
+    }
+
+    return v;
+}
+
+void write_results(
+    std::ostream& out
+  , std::vector<query> const& queries
+  , chunk const& c
+  , std::vector<hpx::lcos::future<std::vector<boost::int64_t> > >& tasks
+    )
+{
+    for (std::size_t x = 0; x < queries.size(); ++x)
+    {
+        std::vector<boost::int64_t> const scores = tasks[x].get();
+
+        for (std::size_t t = 0; t < c.targets.size(); ++t)
+            out << queries[x].name << "\t"
+                << c.targets[t].name << "\t"
+                << scores[t] << "\t"
+                << queries[x].sequence.size() << "\t"
+                << c.targets[t].sequence.size() << "\n";
+    }
+
+    out.flush();
+}
+
+template <typename Scoring>
+void align_all(
+    boost::program_options::variables_map& vm
+  , Scoring const& scoring
+    )
+{
+    fasta::file const query_file(vm["queries"].as<std::string>());
+    fasta::file const database_file(vm["database"].as<std::string>());
+
+    std::size_t const chunk_size = vm["chunk-size"].as<boost::uint32_t>();
+
+    std::string const output = vm["output"].as<std::string>();
+
+    std::ofstream output_file;
+
+    if (output != "-")
+    {
+        output_file.open(output.c_str());
+
+        if (!output_file)
+            throw std::runtime_error("could not open " + output + "\n");
+    }
+
+    std::ostream& out = (output == "-") ? std::cout : output_file;
+
+    if (!vm.count("no-header"))
+        out << "# query\ttarget\tscore\tquery length\ttarget length\n";
+
+    hpx::util::high_resolution_timer t;
+
+    alphabet residues;
+    std::vector<query> const queries
+        = read_queries(query_file.records(), residues);
+
+    boost::uint64_t query_residues = 0;
+
+    for (std::size_t x = 0; x < queries.size(); ++x)
+        query_residues += queries[x].sequence.size();
+
+    fasta::reader database = database_file.records();
+
+    boost::uint64_t pairs = 0, cells = 0;
+
+    // The results of the previous chunk are written while the next one is
+    // scored.
+    boost::shared_ptr<chunk const> previous;
+    std::vector<hpx::lcos::future<std::vector<boost::int64_t> > > pending;
+
+    while (true)
+    {
+        boost::shared_ptr<chunk const> const current
+            = read_chunk(database, chunk_size, residues, scoring);
+
+        if (current->targets.empty())
+            break;
+
+        std::vector<hpx::lcos::future<std::vector<boost::int64_t> > > tasks;
+
+        for (std::size_t x = 0; x < queries.size(); ++x)
+            tasks.push_back(hpx::async(&score_chunk<Scoring>
+              , boost::cref(queries[x]), boost::cref(residues), current
+              , boost::cref(scoring)));
+
+        for (std::size_t x = 0; x < current->targets.size(); ++x)
+            cells += query_residues * current->targets[x].sequence.size();
+
+        pairs += queries.size() * current->targets.size();
+
+        if (previous)
+            write_results(out, queries, *previous, pending);
+
+        previous = current;
+        pending.swap(tasks);
+    }
+
+    if (previous)
+        write_results(out, queries, *previous, pending);
+
+    double const runtime = t.elapsed();
+
+    std::cerr << pairs << " alignments, " << cells << " cells in " << runtime
+              << " s (" << (cells / runtime) * 1e-9 << " GCUPS)\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A plain, one row at a time implementation of Gotoh's algorithm to check the
+// batch one against.
+template <typename Scoring>
+boost::int64_t reference_sw(
+    std::string const& a
+  , std::string const& b
+  , Scoring const& scoring
+    )
+{
+    boost::int64_t const open = scoring.gap_open();
+    boost::int64_t const extend = scoring.gap_extend();
+
+    // No alignment can score this low.
+    boost::int64_t const never
+        = -open * boost::int64_t(a.size() + b.size() + 2);
+
+    std::vector<boost::int64_t> H_up(b.size() + 1, 0), H_row(b.size() + 1, 0);
+    std::vector<boost::int64_t> F(b.size() + 1, never);
+
+    boost::int64_t best = 0;
+
+    for (std::size_t i = 1; i <= a.size(); ++i)
+    {
+        boost::int64_t E = never;
+
+        for (std::size_t j = 1; j <= b.size(); ++j)
+        {
+            E = (std::max)(E - extend, H_row[j-1] - open);
+            F[j] = (std::max)(F[j] - extend, H_up[j] - open);
+
+            H_row[j] = maximum(boost::int64_t(0)
+                             , H_up[j-1] + scoring.score(a[i-1], b[j-1])
+                             , E, F[j]);
+
+            best = (std::max)(best, H_row[j]);
+        }
+
+        std::swap(H_up, H_row);
+    }
+
+    return best;
+}
+
+template <typename Scoring>
+std::string random_sequence(
+    boost::random::mt19937& rng
+  , boost::uint32_t length
+    )
+{
+    std::string const chars(Scoring::alphabet());
+
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    std::string s;
+
+    for (boost::uint32_t x = 0; x < length; ++x)
+        s += chars[index_dist(rng)];
+
+    return s;
+}
+
+// Checks that the FASTA reader handles wrapped lines, CRLF line breaks, blank
+// lines and empty sequences.
+bool validate_fasta()
+{
+    std::string const text =
+        "junk before the first record\n"
+        ">first some description\r\n"
+        "ACGT\r\n"
+        "ac\n"
+        "\n"
+        ">empty\n"
+        ">last\n"
+        "GG TT";
+
+    fasta::reader r(text.data(), text.data() + text.size());
+
+    fasta::record first, empty, last, none;
+
+    bool const valid = r.next(first) && r.next(empty) && r.next(last)
+                    && !r.next(none)
+                    && first.name() == "first"
+                    && first.sequence() == "ACGTAC"
+                    && empty.name() == "empty"
+                    && empty.sequence().empty()
+                    && last.name() == "last"
+                    && last.sequence() == "GGTT";
+
+    std::cout << "FASTA validation: " << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
+// Aligns some queries with a database of random sequences (plus copies of
+// the queries, which have high scores), through the same chunks and tasks
+// as align_all(), and checks each score against reference_sw().
+template <typename Scoring>
+bool validate_sw(
+    boost::random::mt19937& rng
+  , Scoring const& scoring
+  , std::vector<boost::uint32_t> const& query_lengths
+  , boost::uint32_t targets
+  , boost::uint32_t max_target_length
+  , std::size_t chunk_size
+    )
+{
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        length_dist(0, max_target_length);
+
+    std::ostringstream query_text, database_text;
+
+    std::vector<std::string> query_sequences;
+
+    for (std::size_t x = 0; x < query_lengths.size(); ++x)
+    {
+        query_sequences.push_back(
+            random_sequence<Scoring>(rng, query_lengths[x]));
+
+        query_text << ">q" << x << "\n" << query_sequences[x] << "\n";
+        database_text << ">copy" << x << "\n" << query_sequences[x] << "\n";
+    }
+
+    for (boost::uint32_t x = 0; x < targets; ++x)
+        database_text << ">t" << x << "\n"
+                      << random_sequence<Scoring>(rng, length_dist(rng))
+                      << "\n";
+
+    std::string const qt = query_text.str(), dt = database_text.str();
+
+    alphabet residues;
+    std::vector<query> const queries
+        = read_queries(fasta::reader(qt.data(), qt.data() + qt.size())
+                     , residues);
+
+    fasta::reader database(dt.data(), dt.data() + dt.size());
+
+    bool valid = true;
+    std::size_t pairs = 0;
+
+    while (true)
+    {
+        boost::shared_ptr<chunk const> const c
+            = read_chunk(database, chunk_size, residues, scoring);
+
+        if (c->targets.empty())
+            break;
+
+        for (std::size_t x = 0; x < queries.size(); ++x)
+        {
+            std::vector<boost::int64_t> const scores = hpx::async(
+                &score_chunk<Scoring>, boost::cref(queries[x])
+              , boost::cref(residues), c, boost::cref(scoring)).get();
+
+            for (std::size_t t = 0; t < c->targets.size(); ++t, ++pairs)
+                valid = valid && scores[t] == reference_sw(
+                    queries[x].sequence, c->targets[t].sequence, scoring);
+        }
+    }
+
+    std::cout << "validation (" << simd::lanes_name() << ", "
+              << Scoring::name() << ", gaps " << scoring.gap_open() << "/"
+              << scoring.gap_extend() << "), " << pairs << " pairs: "
+              << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    ///////////////////////////////////////////////////////////////////////
+    // Handle commandline options.
+
+    // Initialize the PRNG seed.
+    boost::uint32_t seed = vm["seed"].as<boost::uint32_t>();
+
+    if (!seed)
+        seed = boost::uint32_t(std::time(0));
+
+    if (vm["chunk-size"].as<boost::uint32_t>() == 0)
+        throw std::invalid_argument("--chunk-size must be greater than 0\n");
+
+    // Select the scoring scheme. DNA uses linear gaps unless a gap penalty is
+    // given; the amino acid tables always use affine gaps.
+    std::string const raw_scoring = vm["scoring"].as<std::string>();
+
+    if (  raw_scoring != "dna" && raw_scoring != "blosum62"
+       && raw_scoring != "pam250")
+        throw std::invalid_argument(
+            "--scoring must be dna, blosum62 or pam250\n");
+
+    boost::int32_t const gap_open = vm["gap-open"].as<boost::int32_t>();
+    boost::int32_t const gap_extend = vm["gap-extend"].as<boost::int32_t>();
+
+    if (gap_extend <= 0 || gap_open < gap_extend)
+        throw std::invalid_argument(
+            "--gap-extend must be positive, and no greater than --gap-open\n");
+
+    bool const affine_gaps = !vm["gap-open"].defaulted()
+                          || !vm["gap-extend"].defaulted();
+
+    boost::random::mt19937 rng(seed);
+
+    {
+        using scoring::affine;
+        using scoring::linear_dna;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Validate implementation.
+        if (vm.count("validate"))
+        {
+            bool valid = validate_fasta();
+
+            std::vector<boost::uint32_t> lengths;
+            lengths.push_back(1);
+            lengths.push_back(37);
+            lengths.push_back(200);
+
+            valid = validate_sw(rng, linear_dna(), lengths, 100, 300, 48)
+                 && valid;
+            valid = validate_sw(rng, affine<scoring::dna>(3, 1), lengths
+                              , 70, 250, 1000) && valid;
+            valid = validate_sw(rng, affine<scoring::blosum62>(11, 1)
+                              , lengths, 70, 250, 33) && valid;
+            valid = validate_sw(rng, affine<scoring::pam250>(10, 2)
+                              , lengths, 70, 250, 64) && valid;
+
+            // This overflows the 8-bit and then the 16-bit lanes.
+            valid = validate_sw(rng, linear_dna()
+                              , std::vector<boost::uint32_t>(1, 17000)
+                              , 3, 100, 16) && valid;
+
+            if (!valid)
+                throw std::runtime_error("batch validation failed\n");
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Align the files.
+        if (vm.count("queries") || vm.count("database"))
+        {
+            if (!vm.count("queries") || !vm.count("database"))
+                throw std::invalid_argument(
+                    "--queries and --database must be given together\n");
+
+            if (raw_scoring == "dna" && !affine_gaps)
+                align_all(vm, linear_dna());
+            else if (raw_scoring == "dna")
+                align_all(vm, affine<scoring::dna>(gap_open, gap_extend));
+            else if (raw_scoring == "blosum62")
+                align_all(vm, affine<scoring::blosum62>(gap_open, gap_extend));
+            else
+                align_all(vm, affine<scoring::pam250>(gap_open, gap_extend));
+        }
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char** argv)
+{
+    using namespace boost::program_options;
+
+    variables_map vm;
+
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "queries"
+        , value<std::string>()
+        , "FASTA file with the query sequences")
+
+        ( "database"
+        , value<std::string>()
+        , "FASTA file with the database sequences")
+
+        ( "output"
+        , value<std::string>()->default_value("-")
+        , "file to write the scores to, as tab-separated values (- for "
+          "standard output)")
+
+        ( "chunk-size"
+        , value<boost::uint32_t>()->default_value(1024)
+        , "number of database sequences to read at a time; each query is "
+          "aligned with a chunk in one task")
+
+        ( "scoring"
+        , value<std::string>()->default_value("dna")
+        , "scoring scheme to use (dna: +2 for a match, -1 for a mismatch, "
+          "blosum62 or pam250)")
+
+        ( "gap-open"
+        , value<boost::int32_t>()->default_value(11)
+        , "penalty for the first character of a gap (for dna, gaps cost 1 "
+          "per character unless this or --gap-extend is given)")
+
+        ( "gap-extend"
+        , value<boost::int32_t>()->default_value(1)
+        , "penalty for each further character of a gap")
+
+        ( "validate"
+        , "check the batch kernel against a plain implementation, with "
+          "each scoring scheme, before aligning the files")
+
+        ( "no-header"
+        , "do not print out the header line of the output")
+
+        ( "seed"
+        , value<boost::uint32_t>()->default_value(0)
+        , "seed for the pseudo random number generator used by --validate "
+          "(if 0, a seed is choosen based on the current system time)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
+
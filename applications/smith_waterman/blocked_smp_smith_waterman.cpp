@@ -8,11 +8,18 @@
 #include <hpx/util/high_resolution_timer.hpp>
 
 #include <hpxla/local_matrix.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+#include <hpxla/wavefront.hpp>
+
+#include "simd.hpp"
+#include "winner.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <unistd.h>
 
-#include <boost/format.hpp>
-#include <boost/ref.hpp>
 #include <boost/spirit/include/qi.hpp>
-#include <boost/atomic.hpp>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 
@@ -63,29 +70,47 @@ std::ostream& operator<<(std::ostream& out, coords const& c)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+// Every cell of H is written before it is read, so H's elements aren't
+// initialized when it is created.
+typedef hpxla::local_matrix_policy<
+    hpxla::policy::column_major_indexing
+  , hpxla::policy::default_init_allocator<
+        std::allocator<hpx::util::unused_type>
+    >
+> score_policy;
+
 struct alignment
 { 
-    hpxla::local_matrix<boost::int64_t> H;
+    hpxla::local_matrix<boost::int64_t, score_policy> H;
+    winner best;
     std::vector<coords> backpath;
 };
 
-// Keep this under 128 bits and it'll be lockfree when used with boost::atomic<>
-// on (modern) x86-64 platforms.
-struct winner
+enum kernel_type
 {
-    winner() : value(0), i(0), j(0) {}
+    scalar_kernel,    // Row by row, one cell at a time.
+    wavefront_kernel  // Anti-diagonal by anti-diagonal, with SIMD.
+};
 
-    winner(boost::int64_t value_, boost::uint32_t i_, boost::uint32_t j_)
-      : value(value_), i(i_), j(j_)
+// The input sequences, plus the copies of them that the wavefront kernel
+// uses: a as 32-bit codes, and b reversed as 32-bit codes. Along an
+// anti-diagonal, i increases while j decreases, so both of these are read
+// contiguously.
+struct sequences
+{
+    sequences(std::string const& a_, std::string const& b_)
+      : a(a_)
+      , b(b_)
+      , a_codes(a_.begin(), a_.end())
+      , b_codes_reversed(b_.rbegin(), b_.rend())
     {}
 
-    boost::int64_t value;
-    boost::uint32_t i;
-    boost::uint32_t j;
+    std::string a;
+    std::string b;
+    std::vector<boost::int32_t> a_codes;
+    std::vector<boost::int32_t> b_codes_reversed;
 };
 
-boost::atomic<winner> H_best(winner(0, 0, 0));
-
 boost::int64_t calc_cell(
     boost::uint32_t i
   , boost::uint32_t j
@@ -114,29 +139,20 @@ boost::int64_t calc_cell(
     return ij_value;
 }
 
-void calc_block(
-    hpxla::local_matrix_view<boost::int64_t>& H 
-  , hpxla::local_matrix_view<hpx::shared_future<void> >& C // Control matrix.
-  , coords start   // The start of our cell block. 
-  , coords end     // The end of our cell block.
-  , coords control // Our location in the control matrix.
-  , std::string const& a
-  , std::string const& b
+winner score_block_scalar(
+    hpxla::local_matrix_view<boost::int64_t, score_policy>& H 
+  , coords start
+  , coords end
+  , sequences const& s
     )
 {
-    // TODO: Handle this with hpx::wait_all?
-    C(control.i,   control.j-1).get(); 
-    C(control.i-1, control.j-1).get(); 
-    C(control.i-1, control.j  ).get(); 
+    winner local_best;
 
-    winner local_best = H_best.load();
-
-    // Generate scores.
     for (boost::uint32_t i = start.i; i < end.i; ++i)
     {
         for (boost::uint32_t j = start.j; j < end.j; ++j)
         {
-            H(i, j) = calc_cell(i, j, a[i-1], b[j-1]
+            H(i, j) = calc_cell(i, j, s.a[i-1], s.b[j-1]
               , H(i,   j-1) // left
               , H(i-1, j-1) // diagonal 
               , H(i-1, j  ) // up
@@ -151,93 +167,342 @@ void calc_block(
         }
     }
 
-    winner H_best_old = H_best.load(); 
+    return local_best;
+}
 
-    while (true)
+// Scores the strip [start, end) of a block one anti-diagonal at a time, and
+// returns the best score in it. The cells of an anti-diagonal only depend on
+// the previous two anti-diagonals, so they are scored simd::width at a time.
+//
+// The anti-diagonals are kept in three buffers, indexed by the row within the
+// strip plus one. Each buffer also holds the two cells of its anti-diagonal
+// which lie just outside of the strip (in the row above and the column to the
+// left), so the edges of the strip need no special cases.
+//
+// The scores are collected in tile, a column-major matrix with the dimensions
+// of the strip, before they are copied into H.
+boost::int32_t score_strip_wavefront(
+    hpxla::local_matrix_view<boost::int64_t, score_policy>& H 
+  , coords start
+  , coords end
+  , sequences const& s
+  , boost::int32_t* prev2
+  , boost::int32_t* prev
+  , boost::int32_t* cur
+  , boost::int32_t* tile
+    )
+{
+    boost::uint32_t const rows = end.i - start.i;
+    boost::uint32_t const cols = end.j - start.j;
+    boost::uint32_t const n = s.b.size();
+
+    // Anti-diagonal -2 only holds the corner above and to the left of the
+    // strip.
+    prev2[0] = H(start.i-1, start.j-1);
+
+    simd::int32v const v_zero     = simd::splat(0);
+    simd::int32v const v_gap      = simd::splat(gap);
+    simd::int32v const v_match    = simd::splat(match);
+    simd::int32v const v_mismatch = simd::splat(mismatch);
+
+    simd::int32v v_best = v_zero;
+    boost::int32_t best = 0;
+
+    for (boost::uint32_t t = 0; t < rows + cols - 1; ++t)
     {
-        if (local_best.value > H_best_old.value)
+        // The cells of anti-diagonal t-1 just outside of the strip, which
+        // are the up and left neighbours of the first and last cells of
+        // anti-diagonal t.
+        if (t < cols)
+            prev[0] = H(start.i-1, start.j+t);
+        if (t < rows)
+            prev[t+1] = H(start.i+t, start.j-1);
+
+        // The rows of the strip which anti-diagonal t crosses.
+        boost::uint32_t const first = (t < cols) ? 0 : t - (cols - 1);
+        boost::uint32_t const last = (std::min)(rows - 1, t);
+
+        // Cell r of the anti-diagonal is (start.i + r, start.j + t - r). It
+        // compares a[start.i + r - 1] with b[start.j + t - r - 1], which is
+        // b_codes_reversed[n - start.j - t + r].
+        boost::int32_t const* ai = &s.a_codes[start.i - 1 + first];
+        boost::int32_t const* bj = &s.b_codes_reversed[n - start.j - t + first];
+
+        boost::uint32_t r = first;
+
+        for (; r + simd::width <= last + 1; r += simd::width)
         {
-            if (H_best.compare_exchange_weak(H_best_old, local_best))
-                break;
+            simd::int32v const diagonal = simd::load(prev2 + r);
+            simd::int32v const up       = simd::load(prev + r);
+            simd::int32v const left     = simd::load(prev + r + 1);
+
+            simd::int32v const substitution = simd::select_equal(
+                simd::load(ai + (r - first)), simd::load(bj + (r - first))
+              , v_match, v_mismatch);
+
+            simd::int32v h = simd::max(v_zero
+                                     , simd::add(diagonal, substitution));
+            h = simd::max(h, simd::add(up, v_gap));
+            h = simd::max(h, simd::add(left, v_gap));
+
+            simd::store(cur + r + 1, h);
+            v_best = simd::max(v_best, h);
         }
-        else
-            break;
+
+        for (; r <= last; ++r)
+        {
+            boost::int32_t const substitution
+                = (ai[r - first] == bj[r - first]) ? match : mismatch;
+
+            boost::int32_t const h
+                = maximum(boost::int32_t(0), prev2[r] + substitution
+                        , prev[r] + gap, prev[r+1] + gap);
+
+            cur[r+1] = h;
+            best = (std::max)(best, h);
+        }
+
+        // Moving one cell along the anti-diagonal moves down one row and left
+        // one column of the (column-major) tile.
+        boost::int32_t* out = tile + (t - first) * rows + first;
+
+        for (r = first; r <= last; ++r, out -= rows - 1)
+            *out = cur[r+1];
+
+        boost::int32_t* const recycled = prev2;
+        prev2 = prev;
+        prev = cur;
+        cur = recycled;
+    }
+
+    // Copy the strip into H a column at a time. Writing it to H along the
+    // anti-diagonals would touch a different page of H for every cell.
+    for (boost::uint32_t c = 0; c < cols; ++c)
+    {
+        boost::int64_t* h = &H(start.i, start.j + c);
+
+        for (boost::uint32_t r = 0; r < rows; ++r)
+            h[r] = tile[c * rows + r];
     }
+
+    return (std::max)(best, simd::reduce_max(v_best));
+}
+
+// Scores the block in horizontal strips of strip_rows rows, which keeps each
+// anti-diagonal short enough for its part of the tile to stay in cache. Cells
+// scoring less than bound can't be the winner, so if the block's best is less
+// than bound, it isn't looked for, and a winner with a value of 0 is
+// returned.
+winner score_block_wavefront(
+    hpxla::local_matrix_view<boost::int64_t, score_policy>& H 
+  , coords start
+  , coords end
+  , sequences const& s
+  , boost::int64_t bound
+    )
+{
+    boost::uint32_t const strip_rows = 16 * simd::width;
+
+    std::vector<boost::int32_t> buffers(3 * (strip_rows + 1));
+    std::vector<boost::int32_t> tile(strip_rows * (end.j - start.j));
+
+    // The best score in the block, and the first strip which holds it.
+    boost::int32_t best = 0;
+    boost::uint32_t best_strip = start.i;
+
+    for (boost::uint32_t i = start.i; i < end.i; i += strip_rows)
+    {
+        coords const strip_start(i, start.j);
+        coords const strip_end((std::min)(i + strip_rows, end.i), end.j);
+
+        boost::int32_t const strip_best = score_strip_wavefront(H
+          , strip_start, strip_end, s
+          , &buffers[0]
+          , &buffers[strip_rows + 1]
+          , &buffers[2 * (strip_rows + 1)]
+          , &tile[0]);
+
+        if (strip_best > best)
+        {
+            best = strip_best;
+            best_strip = i;
+        }
+    }
+
+    // Find where the best score is. The scalar kernel keeps the first cell,
+    // in row-major order, which has the best score, so that strip is searched
+    // in the same order.
+    if (best == 0 || best < bound)
+        return winner();
+
+    boost::uint32_t const best_strip_end
+        = (std::min)(best_strip + strip_rows, end.i);
+
+    for (boost::uint32_t i = best_strip; i < best_strip_end; ++i)
+        for (boost::uint32_t j = start.j; j < end.j; ++j)
+            if (H(i, j) == best)
+                return winner(best, i, j);
+
+    BOOST_ASSERT(false);
+    return winner();
 }
 
+// Scores block (I, J) of H, once the blocks above it and to the left of it
+// are done. The blocks are step rows by step columns, except for those in the
+// last row and column of blocks, which hold whatever is left of H.
+//
+// The best cell is reduced along the wavefront instead of through a shared
+// atomic: winners(I, J) is the best cell of the blocks above and to the left
+// of (I, J), inclusive, so winners(g - 1, g - 1) is the best cell of H. As
+// better() breaks ties, the result doesn't depend on the order in which the
+// blocks run.
+struct calc_block
+{
+    typedef void result_type;
+
+    calc_block(
+        hpxla::local_matrix_view<boost::int64_t, score_policy>& H_
+      , hpxla::local_matrix_view<winner>& winners_
+      , boost::uint32_t step_
+      , sequences const& s_
+      , kernel_type kernel_
+        )
+      : H(H_)
+      , winners(winners_)
+      , step(step_)
+      , s(s_)
+      , kernel(kernel_)
+    {}
+
+    void operator()(
+        boost::uint64_t I
+      , boost::uint64_t J
+        ) const
+    {
+        coords const start((I*step)+1, (J*step)+1);
+        coords const end(
+            (std::min)(boost::uint64_t(start.i) + step, H.rows())
+          , (std::min)(boost::uint64_t(start.j) + step, H.columns()));
+
+        winner previous_best;
+
+        if (I != 0 && better(winners(I-1, J), previous_best))
+            previous_best = winners(I-1, J);
+        if (J != 0 && better(winners(I, J-1), previous_best))
+            previous_best = winners(I, J-1);
+
+        // Generate scores.
+        winner const local_best = (wavefront_kernel == kernel)
+            ? score_block_wavefront(H, start, end, s, previous_best.value)
+            : score_block_scalar(H, start, end, s);
+
+        winners(I, J) = better(local_best, previous_best)
+                      ? local_best : previous_best;
+    }
+
+    hpxla::local_matrix_view<boost::int64_t, score_policy>& H;
+    hpxla::local_matrix_view<winner>& winners;
+    boost::uint32_t step;
+    sequences const& s;
+    kernel_type kernel;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
-alignment smith_waterman(
-    std::string const& a
-  , std::string const& b
-  , boost::uint32_t grain_size
+// The size of the L2 cache of this machine, in bytes.
+boost::uint64_t l2_cache_size()
+{
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    long const size = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+
+    if (size > 0)
+        return size;
+#endif
+
+    return 256 * 1024;
+}
+
+// Picks a grain size for an m by n H. A block should fit in half of the L2
+// cache, leaving the rest for the sequences and the blocks next to it; but
+// there should also be enough blocks along each anti-diagonal of blocks to
+// keep all of the OS-threads busy, so smaller blocks are used for small
+// matrices.
+boost::uint32_t default_grain_size(
+    boost::uint64_t m
+  , boost::uint64_t n
     )
 {
-    // Make sure that a and b have the same size (e.g. m == n), for now.
-    BOOST_ASSERT(a.size() == b.size());
+    boost::uint64_t const threads = hpx::get_os_thread_count();
+    boost::uint64_t const shortest = (std::min)(m, n);
 
-    if (a.size() % grain_size)
-        throw std::invalid_argument(boost::str(boost::format(
-            "grain size of %1% is invalid for a sequence of length %2%")
-            % grain_size % a.size()));
+    boost::uint64_t grain_size = 16;
 
-    // j is the length of our input sequences plus one. This is number of
-    // rows and columns in our square matrix. The extra, zero-filled row is
-    // needed because the algorithm backtracks until it reaches a zero number.
-    boost::uint32_t k = a.size() + 1; 
+    while (  (2 * grain_size) * (2 * grain_size) * sizeof(boost::int64_t)
+                <= l2_cache_size() / 2
+          && shortest / (2 * grain_size) >= 4 * threads)
+        grain_size *= 2;
 
-    // Create our matrix and fill it with zeros.
+    return grain_size;
+}
+
+alignment smith_waterman(
+    std::string const& a
+  , std::string const& b
+  , boost::uint32_t grain_size = 0
+  , kernel_type kernel = wavefront_kernel
+    )
+{
+    // A grain size of 0 lets us choose.
+    if (grain_size == 0)
+        grain_size = default_grain_size(a.size(), b.size());
+
+    // H has one more row than the length of a, and one more column than the
+    // length of b. The extra, zero-filled row and column are needed because
+    // the algorithm backtracks until it reaches a zero number.
+    boost::uint32_t const m = a.size() + 1; 
+    boost::uint32_t const n = b.size() + 1; 
+
+    // Create our matrix. The blocks write every other cell, so only the
+    // extra row and column are filled with zeros.
     alignment result;
 
-    // k * k matrix
-    result.H = hpxla::local_matrix<boost::int64_t>(k, k, 0); 
+    sequences const seqs(a, b);
+
+    // m * n matrix
+    result.H = hpxla::local_matrix<boost::int64_t, score_policy>(m, n
+                                                  , hpxla::uninitialized); 
 
     // Declare a matrix view (e.g. an "alias") called H which refers to
     // result.H.
-    hpxla::local_matrix_view<boost::int64_t> H = result.H.view();
+    hpxla::local_matrix_view<boost::int64_t, score_policy> H = result.H.view();
 
-    // Control matrix, for synchronizing the blocked, parallel operations.
-    boost::uint32_t g = (grain_size % a.size()) + 1;
-    hpxla::local_matrix<hpx::shared_future<void> > control_matrix(g, g); 
+    for (boost::uint32_t i = 0; i < m; ++i)
+        H(i, 0) = 0;
 
-    hpxla::local_matrix_view<hpx::shared_future<void> > C = control_matrix.view();
+    for (boost::uint32_t j = 0; j < n; ++j)
+        H(0, j) = 0;
 
-    for (boost::uint32_t x = 0; x < g; ++x)
-    {
-        C(0, x) = hpx::lcos::make_ready_future();
-        C(x, 0) = hpx::lcos::make_ready_future();
-    }
+    // The number of blocks along each side of H. The last row and column of
+    // blocks may be smaller than the others.
+    boost::uint32_t const rows = (a.size() + grain_size - 1) / grain_size;
+    boost::uint32_t const cols = (b.size() + grain_size - 1) / grain_size;
 
     ///////////////////////////////////////////////////////////////////////////
     // Generate scoring matrix.
 
-    for (boost::uint32_t i = 1; i < g; ++i)
-    {
-        for (boost::uint32_t j = 1; j < g; ++j)
-        {
-            boost::uint32_t const step = a.size() / grain_size;
+    hpxla::local_matrix<winner> block_winners(rows, cols);
+    hpxla::local_matrix_view<winner> winners = block_winners.view();
 
-            coords const start( ((i-1)*step)+1, ((j-1)*step)+1 ); 
-            coords const end(   ((i)*step)+1,   ((j)*step)+1   ); 
+    hpxla::for_each_wavefront(hpxla::matrix_bounds(rows, cols)
+      , calc_block(H, winners, grain_size, seqs, kernel));
 
-            coords const control(i, j);
-
-            //calc_block(H, C, start, end, control, a, b);
-            C(i, j) = hpx::async(calc_block, 
-                    boost::reference_wrapper<hpxla::local_matrix_view<boost::int64_t> >(H), 
-                    boost::reference_wrapper<hpxla::local_matrix_view<hpx::shared_future<void> > >(C), 
-                    start, end, control, a, b);
-        } 
-    }  
-
-    for (boost::uint32_t i = 1; i < g; ++i)
-        for (boost::uint32_t j = 1; j < g; ++j)
-            C(i, j).get(); 
+    if (rows != 0 && cols != 0)
+        result.best = winners(rows - 1, cols - 1);
 
     ///////////////////////////////////////////////////////////////////////////
     // Backtracking.
 
     // 0.) Make a vector to hold coords.
-    // 1.) We want to start at H_best, or the coordinate of H_best, so
+    // 1.) We want to start at the best cell, or the coordinate of it, so
     //     (i_max, j_max).
     // 2.) Then, determine which value is largest (where i is initially i_max,
     //     and j is initially j_max):
@@ -246,7 +511,7 @@ alignment smith_waterman(
     //        (i, j-1)   for a deletion. 
     // 3.) Reset the current i and j coords to equal next i and j coords. 
    
-    winner H_max = H_best.load();
+    winner const H_max = result.best;
  
     std::vector<coords>& backpath = result.backpath;
     backpath.push_back(coords(H_max.i, H_max.j)); 
@@ -254,6 +519,10 @@ alignment smith_waterman(
     while (true)
     {
         coords last = backpath.back();
+
+        if (last.i == 0 || last.j == 0)
+            break;
+
         boost::int64_t match_mismatch = H(last.i-1, last.j-1); 
         boost::int64_t insertion = H(last.i, last.j-1);
         boost::int64_t deletion = H(last.i-1, last.j);
@@ -284,7 +553,9 @@ void benchmark_sw(
     boost::random::mt19937& rng
   , boost::uint32_t seed 
   , boost::uint32_t length
+  , boost::uint32_t length_b
   , boost::uint32_t grain_size
+  , kernel_type kernel
   , boost::uint32_t iterations = 1 << 10
     )
 { 
@@ -298,23 +569,27 @@ void benchmark_sw(
     std::string a, b;
 
     for (boost::uint32_t x = 0; x < length; ++x)
-    {
         a += chars[index_dist(rng)];
+
+    for (boost::uint32_t x = 0; x < length_b; ++x)
         b += chars[index_dist(rng)];
-    }
+
+    if (grain_size == 0)
+        grain_size = default_grain_size(length, length_b);
 
     ///////////////////////////////////////////////////////////////////////////
     // Generate our sequences using the mt19937 random number generator.
     hpx::util::high_resolution_timer t;
 
     for (boost::uint32_t x = 0; x < iterations; ++x)
-        smith_waterman(a, b, grain_size);
+        smith_waterman(a, b, grain_size, kernel);
 
     double runtime = t.elapsed();
 
     std::cout << seed << ","
               << hpx::get_os_thread_count() << "," 
               << length << ","
+              << length_b << ","
               << grain_size << ","
               << iterations << ","
               << runtime << "\n";
@@ -336,18 +611,19 @@ void validate_sw(
     alignment align = smith_waterman(a, b, grain_size);
 
     boost::uint32_t p = a.size() + 1;
+    boost::uint32_t q = b.size() + 1;
 
     // H_path is a matrix of bools that is the same size as align.H. Each cell
     // of H_path has a boolean. The cells that are in align.backpath are true,
     // and all the others are false.
-    hpxla::local_matrix<bool> H_path(p, p, false); // p * p matrix
+    hpxla::local_matrix<bool> H_path(p, q, false); // p * q matrix
 
     for (boost::uint32_t x = 0; x < align.backpath.size(); ++x)
         H_path(align.backpath[x].i, align.backpath[x].j) = true;
 
     for (boost::uint32_t i = 0; i < p; ++i)
     {
-        for (boost::uint32_t j = 0; j < p; ++j)
+        for (boost::uint32_t j = 0; j < q; ++j)
         {
             // Check if the current element align.H(i, j) is part of the optimal
             // alignment.
@@ -363,6 +639,64 @@ void validate_sw(
     std::cout << "\n";
 }
 
+// Checks that the wavefront kernel produces exactly the same H and best cell
+// as the scalar kernel, and that both of them match the scalar kernel run on
+// H as a single block.
+bool cross_validate_sw(
+    boost::random::mt19937& rng
+  , boost::uint32_t length
+  , boost::uint32_t length_b
+  , boost::uint32_t grain_size
+    )
+{
+    std::string const chars("ATGC");
+  
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    std::string a, b;
+
+    for (boost::uint32_t x = 0; x < length; ++x)
+        a += chars[index_dist(rng)];
+
+    for (boost::uint32_t x = 0; x < length_b; ++x)
+        b += chars[index_dist(rng)];
+
+    alignment const single = smith_waterman(a, b
+      , (std::max)((std::max)(length, length_b), 1u), scalar_kernel);
+
+    alignment const scalar = smith_waterman(a, b, grain_size, scalar_kernel);
+
+    alignment const wavefront
+        = smith_waterman(a, b, grain_size, wavefront_kernel);
+
+    bool valid = true;
+
+    alignment const* const results[] = { &scalar, &wavefront };
+
+    for (std::size_t r = 0; r < 2; ++r)
+    {
+        alignment const& result = *results[r];
+
+        valid = valid
+             && single.best.value == result.best.value
+             && single.best.i == result.best.i
+             && single.best.j == result.best.j
+             && single.backpath.size() == result.backpath.size();
+
+        for (boost::uint32_t i = 0; i <= length; ++i)
+            for (boost::uint32_t j = 0; j <= length_b; ++j)
+                valid = valid && single.H(i, j) == result.H(i, j);
+    }
+
+    std::cout << "cross-validation (" << simd::name() << "), lengths "
+              << length << " x " << length_b << ", grain-size "
+              << grain_size << ": "
+              << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
 template <typename Iterator>
 bool read_list(Iterator first, Iterator last, std::vector<boost::uint32_t>& v)
 {
@@ -402,6 +736,25 @@ int hpx_main(boost::program_options::variables_map& vm)
     if (!read_list(raw_lengths.begin(), raw_lengths.end(), lengths))
         throw std::invalid_argument("--lengths argument not be parsed\n");
 
+    // Parse the lengths of the second sequences, which default to those of
+    // the first ones.
+    std::vector<boost::uint32_t> lengths_b(lengths);
+
+    if (vm.count("second-lengths"))
+    {
+        std::string raw_lengths_b = vm["second-lengths"].as<std::string>();
+
+        lengths_b.clear();
+
+        if (!read_list(raw_lengths_b.begin(), raw_lengths_b.end(), lengths_b))
+            throw std::invalid_argument(
+                "--second-lengths could not be parsed\n");
+
+        if (lengths_b.size() != lengths.size())
+            throw std::invalid_argument(
+                "--second-lengths must have as many elements as --lengths\n");
+    }
+
     // Parse grain sizes.
     std::string raw_grain_sizes = vm["grain-sizes"].as<std::string>();
 
@@ -410,6 +763,16 @@ int hpx_main(boost::program_options::variables_map& vm)
     if (!read_list(raw_grain_sizes.begin(), raw_grain_sizes.end(), grain_sizes))
         throw std::invalid_argument("--grain-sizes could not be parsed\n");
 
+    // Select the scoring kernel.
+    std::string const raw_kernel = vm["kernel"].as<std::string>();
+
+    kernel_type kernel = wavefront_kernel;
+
+    if (raw_kernel == "scalar")
+        kernel = scalar_kernel;
+    else if (raw_kernel != "wavefront")
+        throw std::invalid_argument("--kernel must be scalar or wavefront\n");
+
     boost::random::mt19937 rng(seed);
 
     {
@@ -419,6 +782,25 @@ int hpx_main(boost::program_options::variables_map& vm)
         {
             validate_sw(1);
             validate_sw(2);
+
+            bool valid = true;
+
+            valid = cross_validate_sw(rng, 8, 8, 1) && valid;
+            valid = cross_validate_sw(rng, 61, 61, 1) && valid;
+            valid = cross_validate_sw(rng, 64, 64, 4) && valid;
+            valid = cross_validate_sw(rng, 255, 255, 5) && valid;
+            valid = cross_validate_sw(rng, 600, 600, 2) && valid;
+
+            // Unequal lengths, and blocks which don't divide them.
+            valid = cross_validate_sw(rng, 100, 37, 16) && valid;
+            valid = cross_validate_sw(rng, 37, 100, 16) && valid;
+            valid = cross_validate_sw(rng, 250, 999, 64) && valid;
+            valid = cross_validate_sw(rng, 999, 250, 0) && valid;
+            valid = cross_validate_sw(rng, 1, 300, 7) && valid;
+            valid = cross_validate_sw(rng, 0, 50, 8) && valid;
+
+            if (!valid)
+                throw std::runtime_error("kernel cross-validation failed\n");
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -428,11 +810,12 @@ int hpx_main(boost::program_options::variables_map& vm)
         if (!vm.count("no-header"))
             std::cout
                 << "HPX Blocked SMP Smith-Waterman Performance\n"
-                << "Seed,OS-Threads,Sequence Length,Grain Size,Iterations,"
-                   "Total Walltime (s)\n";
+                << "Seed,OS-Threads,Sequence Length,Second Sequence Length,"
+                   "Grain Size,Iterations,Total Walltime (s)\n";
     
         for (boost::uint32_t x = 0; x < lengths.size(); ++x)
-            benchmark_sw(rng, seed, lengths[x], grain_sizes[x], iterations);
+            benchmark_sw(rng, seed, lengths[x], lengths_b[x], grain_sizes[x]
+                       , kernel, iterations);
     }
 
     return hpx::finalize();
@@ -452,13 +835,26 @@ int main(int argc, char** argv)
         , "sequence lengths to use (comma seperated list, maximum length "
           " currently allowed is 2^32)")
 
+        ( "second-lengths"
+        , value<std::string>()
+        , "lengths of the second sequences to use (comma seperated list, "
+          "must have the same number of elements as --lengths, defaults to "
+          "--lengths)")
+
         ( "grain-sizes"
         , value<std::string>()->default_value("4,4,4,4")
         , "grain sizes to use (comma seperated list, must have the same "
-          " number of elements as --lengths)")
+          " number of elements as --lengths; 0 chooses one from the size "
+          "of the L2 cache and the number of OS-threads)")
+
+        ( "kernel"
+        , value<std::string>()->default_value("wavefront")
+        , "block scoring kernel to use (scalar: row by row, wavefront: "
+          "anti-diagonals with SIMD)")
 
         ( "validate"
-        , "run validation code before performing benchmarks")
+        , "run validation code, and check that the kernels agree, before "
+          "performing benchmarks")
 
         ( "no-header"
         , "do not print out the CSV header for the benchmark data")
@@ -0,0 +1,627 @@
+//  Copyright (c) 2012 Stephanie Crillo and Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include "winner.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include <boost/ref.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/spirit/include/qi.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// Smith-Waterman across localities. The columns of the matrix are split into
+// strips, and each strip is a component which can live on any locality. A
+// strip scores its columns one block of rows at a time, in tiles, and as the
+// last tile of each block finishes, sends the column of scores along its
+// right edge to the next strip. So the strips work along the wavefront
+// together: strip k can start on block r as soon as strip k-1 has finished
+// it. A strip only keeps one row of its columns, so the scores (but not the
+// alignment) of sequences too big for one node can be computed.
+//
+// The best score of each strip is found by its tiles, and these are reduced
+// to the global best.
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C)
+{
+    return (std::max)((std::max)(A, B), C);
+}
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C, T const& D)
+{
+    return (std::max)((std::max)((std::max)(A, B), C), D);
+}
+
+enum gap_scoring
+{
+    gap      = -1,
+    match    = +2,
+    mismatch = -1
+};
+
+///////////////////////////////////////////////////////////////////////////////
+boost::int64_t calc_cell(
+    char ai
+  , char bj
+  , boost::int64_t left      // H(i, j-1)
+  , boost::int64_t diagonal  // H(i-1, j-1)
+  , boost::int64_t up        // H(i-1, j)
+    )
+{
+    boost::int64_t const match_mismatch
+        = diagonal + ((ai == bj) ? match : mismatch);
+
+    return maximum(boost::int64_t(0), match_mismatch, up + gap, left + gap);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace server
+{
+
+/// A strip of the columns of the matrix.
+struct HPX_COMPONENT_EXPORT strip
+  : hpx::components::managed_component_base<strip>
+{
+    /// The scores along an edge of a tile: the cell above the tile, then a
+    /// cell for each of its rows.
+    typedef std::vector<boost::int64_t> column;
+
+    strip() : first_column(0), grain_size(0), tiles(0), blocks(0) {}
+
+    /// \a a is the whole of the first sequence, and \a b is the part of the
+    /// second one which this strip covers, starting at column
+    /// \a first_column_. Blocks and tiles are \a grain_size_ rows and
+    /// columns wide. The scores along the right edge of the strip are sent
+    /// to \a next_ (unless it is invalid_id).
+    void initialize(
+        std::string const& a_
+      , std::string const& b_
+      , boost::uint64_t first_column_
+      , boost::uint32_t grain_size_
+      , hpx::naming::id_type const& next_
+        )
+    {
+        BOOST_ASSERT(!b_.empty());
+        BOOST_ASSERT(grain_size_ != 0);
+
+        a = a_;
+        b = b_;
+        first_column = first_column_;
+        grain_size = grain_size_;
+        next = next_;
+
+        tiles = (b.size() + grain_size - 1) / grain_size;
+        blocks = (a.size() + grain_size - 1) / grain_size;
+
+        bottom.assign(b.size(), 0);
+        bests.assign(tiles, winner());
+
+        incoming.clear();
+
+        for (boost::uint64_t r = 0; r < blocks; ++r)
+            incoming.push_back(boost::make_shared<
+                hpx::lcos::local::promise<column> >());
+    }
+
+    /// Receives the scores along the left edge of block \a r.
+    void receive(
+        boost::uint64_t r
+      , column const& left
+        )
+    {
+        BOOST_ASSERT(r < blocks);
+        incoming[r]->set_value(left);
+    }
+
+    /// Scores the strip, and returns the best cell in it.
+    winner run()
+    {
+        // Blocks are only started when the block this many blocks before
+        // them has finished; otherwise, the tiles of every block of the
+        // strip could be waiting in memory for the previous strip.
+        std::size_t const window = blocks_in_flight;
+
+        std::vector<hpx::shared_future<column> > above(tiles
+          , hpx::lcos::make_ready_future(column()));
+
+        std::deque<hpx::shared_future<column> > started;
+
+        for (boost::uint64_t r = 0; r < blocks; ++r)
+        {
+            if (started.size() == window)
+            {
+                started.front().get();
+                started.pop_front();
+            }
+
+            hpx::shared_future<column> left;
+
+            // The first strip's left edge is the column of zeros.
+            if (first_column == 1)
+                left = hpx::lcos::make_ready_future(column(rows(r) + 1, 0));
+            else
+                left = incoming[r]->get_future();
+
+            // A tile is only scheduled once its left edge has arrived and the
+            // tile above it has finished, so no task waits on another.
+            for (boost::uint64_t t = 0; t < tiles; ++t)
+                above[t] = left = hpx::lcos::local::dataflow(
+                    hpx::launch::async, &score_tile, boost::ref(*this)
+                  , r, t, left, above[t]);
+
+            started.push_back(left);
+        }
+
+        // Each tile waits for the one above it, so the last row of tiles
+        // finishes last.
+        for (boost::uint64_t t = 0; t < tiles; ++t)
+            above[t].get();
+
+        winner best;
+
+        for (boost::uint64_t t = 0; t < tiles; ++t)
+            if (better(bests[t], best))
+                best = bests[t];
+
+        return best;
+    }
+
+    HPX_DEFINE_COMPONENT_ACTION(strip, initialize);
+    HPX_DEFINE_COMPONENT_ACTION(strip, receive);
+    HPX_DEFINE_COMPONENT_ACTION(strip, run);
+
+  private:
+    boost::uint64_t rows(boost::uint64_t r) const
+    {
+        return (std::min)(boost::uint64_t(grain_size)
+                        , boost::uint64_t(a.size() - r * grain_size));
+    }
+
+    // The number of blocks which can be started before the first of them has
+    // finished.
+    static std::size_t const blocks_in_flight = 4;
+
+    // Scores tile t of block r, once the tile to the left of it has given it
+    // its left edge, and the tile above it has finished (both futures are
+    // ready); the tile works on bottom, the row above it, in place. Returns
+    // the right edge of the tile.
+    static column score_tile(
+        strip& s
+      , boost::uint64_t r
+      , boost::uint64_t t
+      , hpx::shared_future<column> left_edge
+      , hpx::shared_future<column> up
+        )
+    {
+        up.get();
+        column const& left = left_edge.get();
+
+        boost::uint64_t const first_row = r * s.grain_size + 1;
+        boost::uint64_t const rows = s.rows(r);
+
+        boost::uint64_t const first = t * s.grain_size;
+        boost::uint64_t const last
+            = (std::min)(first + s.grain_size, boost::uint64_t(s.b.size()));
+
+        BOOST_ASSERT(left.size() == rows + 1);
+
+        column right(rows + 1);
+        right[0] = s.bottom[last - 1];
+
+        // Only this tile's column of the strip writes to bests[t].
+        winner& best = s.bests[t];
+
+        for (boost::uint64_t i = 0; i < rows; ++i)
+        {
+            char const ai = s.a[first_row + i - 1];
+
+            boost::int64_t diagonal = left[i];
+            boost::int64_t h = left[i + 1];
+
+            for (boost::uint64_t j = first; j < last; ++j)
+            {
+                boost::int64_t const up = s.bottom[j];
+
+                h = calc_cell(ai, s.b[j], h, diagonal, up);
+
+                diagonal = up;
+                s.bottom[j] = h;
+
+                if (h > best.value)
+                    best = winner(h, first_row + i, s.first_column + j);
+            }
+
+            right[i + 1] = h;
+        }
+
+        if (t == s.tiles - 1 && s.next != hpx::naming::invalid_id)
+            hpx::apply<receive_action>(s.next, r, right);
+
+        return right;
+    }
+
+    std::string a;
+    std::string b;
+    boost::uint64_t first_column;
+    boost::uint32_t grain_size;
+    hpx::naming::id_type next;
+
+    boost::uint64_t tiles;
+    boost::uint64_t blocks;
+
+    // The last row which has been scored in each column.
+    std::vector<boost::int64_t> bottom;
+
+    // The best cell found by each column of tiles.
+    std::vector<winner> bests;
+
+    // The left edges of the blocks, from the previous strip.
+    std::vector<boost::shared_ptr<hpx::lcos::local::promise<column> > >
+        incoming;
+};
+
+}
+
+HPX_REGISTER_COMPONENT_MODULE();
+
+typedef hpx::components::managed_component<server::strip> strip_type;
+
+HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(strip_type, smith_waterman_strip);
+
+HPX_REGISTER_ACTION_DECLARATION(
+    server::strip::initialize_action
+  , smith_waterman_strip_initialize_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    server::strip::receive_action
+  , smith_waterman_strip_receive_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    server::strip::run_action
+  , smith_waterman_strip_run_action);
+
+HPX_REGISTER_ACTION(
+    server::strip::initialize_action
+  , smith_waterman_strip_initialize_action);
+HPX_REGISTER_ACTION(
+    server::strip::receive_action
+  , smith_waterman_strip_receive_action);
+HPX_REGISTER_ACTION(
+    server::strip::run_action
+  , smith_waterman_strip_run_action);
+
+///////////////////////////////////////////////////////////////////////////////
+/// Returns the best cell of the matrix for \a a and \a b, which is split into
+/// \a strips strips (one per locality if 0), dealt out to the localities in
+/// turn.
+winner smith_waterman(
+    std::string const& a
+  , std::string const& b
+  , boost::uint32_t grain_size
+  , boost::uint32_t strips = 0
+    )
+{
+    std::vector<hpx::naming::id_type> const localities
+        = hpx::find_all_localities();
+
+    if (strips == 0)
+        strips = localities.size();
+
+    if (a.empty() || b.empty())
+        return winner();
+
+    // Every strip needs at least one column.
+    strips = (std::min)(boost::uint64_t(strips), boost::uint64_t(b.size()));
+
+    std::vector<hpx::lcos::future<hpx::naming::id_type> > created;
+
+    for (boost::uint32_t k = 0; k < strips; ++k)
+        created.push_back(hpx::components::new_<server::strip>(
+            localities[k % localities.size()]));
+
+    std::vector<hpx::naming::id_type> ids;
+
+    for (boost::uint32_t k = 0; k < strips; ++k)
+        ids.push_back(created[k].get());
+
+    // The columns are split evenly; strip k gets [offset(k), offset(k+1)).
+    std::vector<boost::uint64_t> offsets;
+
+    for (boost::uint64_t k = 0; k <= strips; ++k)
+        offsets.push_back((k * b.size()) / strips);
+
+    std::vector<hpx::lcos::future<void> > initialized;
+
+    for (boost::uint32_t k = 0; k < strips; ++k)
+        initialized.push_back(hpx::async<server::strip::initialize_action>(
+            ids[k], a, b.substr(offsets[k], offsets[k + 1] - offsets[k])
+          , offsets[k] + 1, grain_size
+          , (k + 1 < strips) ? ids[k + 1] : hpx::naming::invalid_id));
+
+    for (boost::uint32_t k = 0; k < strips; ++k)
+        initialized[k].get();
+
+    std::vector<hpx::lcos::future<winner> > bests;
+
+    for (boost::uint32_t k = 0; k < strips; ++k)
+        bests.push_back(hpx::async<server::strip::run_action>(ids[k]));
+
+    winner best;
+
+    for (boost::uint32_t k = 0; k < strips; ++k)
+    {
+        winner const w = bests[k].get();
+
+        if (better(w, best))
+            best = w;
+    }
+
+    return best;
+}
+
+std::string random_sequence(
+    boost::random::mt19937& rng
+  , boost::uint64_t length
+    )
+{
+    std::string const chars("ATGC");
+
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    std::string s;
+
+    for (boost::uint64_t x = 0; x < length; ++x)
+        s += chars[index_dist(rng)];
+
+    return s;
+}
+
+void benchmark_sw(
+    boost::random::mt19937& rng
+  , boost::uint32_t seed
+  , boost::uint32_t length
+  , boost::uint32_t grain_size
+  , boost::uint32_t strips
+  , boost::uint32_t iterations = 1 << 10
+    )
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Generate our sequences using the mt19937 random number generator.
+    std::string const a = random_sequence(rng, length);
+    std::string const b = random_sequence(rng, length);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Run the benchmark.
+    hpx::util::high_resolution_timer t;
+
+    for (boost::uint32_t x = 0; x < iterations; ++x)
+        smith_waterman(a, b, grain_size, strips);
+
+    double runtime = t.elapsed();
+
+    std::cout << seed << ","
+              << hpx::find_all_localities().size() << ","
+              << hpx::get_os_thread_count() << ","
+              << length << ","
+              << grain_size << ","
+              << iterations << ","
+              << runtime << "\n";
+}
+
+// A plain, one row at a time implementation, which keeps the first cell (in
+// row-major order) with the best score.
+winner reference_sw(
+    std::string const& a
+  , std::string const& b
+    )
+{
+    std::vector<boost::int64_t> row(b.size() + 1, 0);
+
+    winner best;
+
+    for (boost::uint64_t i = 1; i <= a.size(); ++i)
+    {
+        boost::int64_t diagonal = 0;
+
+        for (boost::uint64_t j = 1; j <= b.size(); ++j)
+        {
+            boost::int64_t const up = row[j];
+
+            row[j] = calc_cell(a[i-1], b[j-1], row[j-1], diagonal, up);
+            diagonal = up;
+
+            if (row[j] > best.value)
+                best = winner(row[j], i, j);
+        }
+    }
+
+    return best;
+}
+
+// Checks the distributed implementation against reference_sw().
+bool validate_sw(
+    boost::random::mt19937& rng
+  , boost::uint64_t m
+  , boost::uint64_t n
+  , boost::uint32_t grain_size
+  , boost::uint32_t strips
+    )
+{
+    std::string const a = random_sequence(rng, m);
+    std::string const b = random_sequence(rng, n);
+
+    winner const expected = reference_sw(a, b);
+    winner const actual = smith_waterman(a, b, grain_size, strips);
+
+    bool const valid = expected.value == actual.value
+                    && expected.i == actual.i
+                    && expected.j == actual.j;
+
+    std::cout << "validation, " << m << "x" << n << ", grain-size "
+              << grain_size << ", " << strips << " strips: "
+              << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
+template <typename Iterator>
+bool read_list(Iterator first, Iterator last, std::vector<boost::uint32_t>& v)
+{
+    using boost::spirit::qi::uint_parser;
+    using boost::spirit::qi::phrase_parse;
+    using boost::spirit::qi::_1;
+    using boost::spirit::ascii::space;
+
+    uint_parser<boost::uint32_t> size_t_;
+
+    bool r = phrase_parse(first, last, size_t_ % ',', space, v);
+
+    if (first != last)
+        return false;
+
+    return r;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    ///////////////////////////////////////////////////////////////////////
+    // Handle commandline options.
+
+    // Initialize the PRNG seed.
+    boost::uint32_t seed = vm["seed"].as<boost::uint32_t>();
+
+    if (!seed)
+        seed = boost::uint32_t(std::time(0));
+
+    boost::uint32_t iterations = vm["iterations"].as<boost::uint32_t>();
+
+    boost::uint32_t strips = vm["strips"].as<boost::uint32_t>();
+
+    // Parse lengths.
+    std::string raw_lengths = vm["lengths"].as<std::string>();
+
+    std::vector<boost::uint32_t> lengths;
+
+    if (!read_list(raw_lengths.begin(), raw_lengths.end(), lengths))
+        throw std::invalid_argument("--lengths argument not be parsed\n");
+
+    // Parse grain sizes.
+    std::string raw_grain_sizes = vm["grain-sizes"].as<std::string>();
+
+    std::vector<boost::uint32_t> grain_sizes;
+
+    if (!read_list(raw_grain_sizes.begin(), raw_grain_sizes.end(), grain_sizes))
+        throw std::invalid_argument("--grain-sizes could not be parsed\n");
+
+    if (grain_sizes.size() != lengths.size())
+        throw std::invalid_argument(
+            "--grain-sizes must have as many elements as --lengths\n");
+
+    if (std::count(grain_sizes.begin(), grain_sizes.end(), 0u))
+        throw std::invalid_argument("--grain-sizes must be greater than 0\n");
+
+    boost::random::mt19937 rng(seed);
+
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Validate implementation.
+        if (vm.count("validate"))
+        {
+            bool valid = true;
+
+            valid = validate_sw(rng, 8, 8, 1, 1) && valid;
+            valid = validate_sw(rng, 61, 61, 4, 3) && valid;
+            valid = validate_sw(rng, 100, 37, 16, 5) && valid;
+            valid = validate_sw(rng, 37, 100, 16, 5) && valid;
+            valid = validate_sw(rng, 500, 500, 7, 1) && valid;
+            valid = validate_sw(rng, 1000, 900, 32, 8) && valid;
+
+            // More strips than columns.
+            valid = validate_sw(rng, 20, 3, 2, 6) && valid;
+
+            if (!valid)
+                throw std::runtime_error("validation failed\n");
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Benchmark implementation.
+
+        // Print out header rows.
+        if (!vm.count("no-header"))
+            std::cout
+                << "HPX Distributed Smith-Waterman Performance\n"
+                << "Seed,Localities,OS-Threads,Sequence Length,Grain Size,"
+                   "Iterations,Total Walltime (s)\n";
+
+        for (boost::uint32_t x = 0; x < lengths.size(); ++x)
+            benchmark_sw(rng, seed, lengths[x], grain_sizes[x], strips
+                       , iterations);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char** argv)
+{
+    using namespace boost::program_options;
+
+    variables_map vm;
+
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "lengths"
+        , value<std::string>()->default_value("1024,4096,16384")
+        , "sequence lengths to use (comma seperated list)")
+
+        ( "grain-sizes"
+        , value<std::string>()->default_value("128,256,512")
+        , "rows in each block, and columns in each tile, to use (comma "
+          "seperated list, must have the same number of elements as "
+          "--lengths)")
+
+        ( "strips"
+        , value<boost::uint32_t>()->default_value(0)
+        , "number of strips to split the columns into; the strips are dealt "
+          "out to the localities in turn (if 0, one per locality)")
+
+        ( "validate"
+        , "run validation code before performing benchmarks")
+
+        ( "no-header"
+        , "do not print out the CSV header for the benchmark data")
+
+        ( "iterations"
+        , value<boost::uint32_t>()->default_value(16)
+        , "number of tests to perform for each sequence length")
+
+        ( "seed"
+        , value<boost::uint32_t>()->default_value(0)
+        , "seed for the pseudo random number generator (if 0, a seed is "
+          "choosen based on the current system time)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
+
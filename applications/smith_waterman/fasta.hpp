@@ -0,0 +1,170 @@
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPXLA_B4E1D7C2_8F36_4A0B_9D5E_71C3A6F2E048)
+#define HPXLA_B4E1D7C2_8F36_4A0B_9D5E_71C3A6F2E048
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/assert.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+// Streaming FASTA input. A fasta::file maps the whole file into memory, and a
+// fasta::reader walks through it one record at a time. Records are views into
+// the mapping; the sequence of a record is only extracted (without the line
+// breaks) when it is asked for.
+
+namespace fasta
+{
+
+/// A record of a FASTA file: a header line, starting with '>', and the lines
+/// of the sequence that follow it.
+struct record
+{
+    record()
+      : header_first(0), header_last(0), body_first(0), body_last(0)
+    {}
+
+    /// Returns the first word of the header.
+    std::string name() const
+    {
+        char const* last = header_first;
+
+        while (  last != header_last
+              && !std::isspace(static_cast<unsigned char>(*last)))
+            ++last;
+
+        return std::string(header_first, last);
+    }
+
+    /// Returns the sequence, in uppercase, with whitespace removed.
+    std::string sequence() const
+    {
+        std::string s;
+        s.reserve(body_last - body_first);
+
+        for (char const* p = body_first; p != body_last; ++p)
+            if (!std::isspace(static_cast<unsigned char>(*p)))
+                s += char(std::toupper(static_cast<unsigned char>(*p)));
+
+        return s;
+    }
+
+    // The header, without the '>' and the line break.
+    char const* header_first;
+    char const* header_last;
+
+    // The lines of the sequence, with their line breaks.
+    char const* body_first;
+    char const* body_last;
+};
+
+/// Reads records from the FASTA text in [first, last). Anything before the
+/// first '>' is ignored.
+struct reader
+{
+    reader(char const* first, char const* last)
+      : current(first), last_(last)
+    {
+        // Find the first header.
+        while (current != last_ && *current != '>')
+            current = next_line(current);
+    }
+
+    /// Reads the next record into \a r. Returns false at the end of the text.
+    bool next(record& r)
+    {
+        if (current == last_)
+            return false;
+
+        BOOST_ASSERT(*current == '>');
+
+        r.header_first = current + 1;
+        r.body_first = next_line(current);
+        r.header_last = r.body_first;
+
+        // Don't include the line break in the header.
+        while (  r.header_last != r.header_first
+              && std::isspace(static_cast<unsigned char>(r.header_last[-1])))
+            --r.header_last;
+
+        current = r.body_first;
+
+        while (current != last_ && *current != '>')
+            current = next_line(current);
+
+        r.body_last = current;
+
+        return true;
+    }
+
+  private:
+    // Returns the start of the line after the one which p is on.
+    char const* next_line(char const* p) const
+    {
+        char const* eol = static_cast<char const*>(
+            std::memchr(p, '\n', last_ - p));
+
+        return eol ? eol + 1 : last_;
+    }
+
+    char const* current;
+    char const* last_;
+};
+
+/// A FASTA file, mapped into memory.
+struct file : boost::noncopyable
+{
+    explicit file(std::string const& path)
+    {
+        // Empty files can't be mapped.
+        std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+
+        if (!in)
+            throw std::runtime_error("could not open " + path + "\n");
+
+        if (in.tellg() == std::streampos(0))
+            return;
+
+        using namespace boost::interprocess;
+
+        mapping.reset(new file_mapping(path.c_str(), read_only));
+        region.reset(new mapped_region(*mapping, read_only));
+
+        // The file is read front to back.
+        region->advise(mapped_region::advice_sequential);
+    }
+
+    char const* begin() const
+    {
+        return region ? static_cast<char const*>(region->get_address()) : 0;
+    }
+
+    char const* end() const
+    {
+        return region ? begin() + region->get_size() : 0;
+    }
+
+    reader records() const
+    {
+        return reader(begin(), end());
+    }
+
+  private:
+    boost::scoped_ptr<boost::interprocess::file_mapping> mapping;
+    boost::scoped_ptr<boost::interprocess::mapped_region> region;
+};
+
+}
+
+#endif // HPXLA_B4E1D7C2_8F36_4A0B_9D5E_71C3A6F2E048
+
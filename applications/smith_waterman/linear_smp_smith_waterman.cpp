@@ -0,0 +1,825 @@
+//  Copyright (c) 2012 Stephanie Crillo and Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <hpxla/local_matrix.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+#include <hpxla/wavefront.hpp>
+
+#include "winner.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/ref.hpp>
+#include <boost/spirit/include/qi.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// Utility stuff written by Bryce. Instructions for Stephie:
+//
+// maximum() is a function that takes three or four arguments and returns the
+// highest of the three or four arguments.
+//
+// gap, match and mismatch are (like) global const variables that define the gap
+// scoring scheme. They are just like the const chars used in the calculator
+// example from Bjarne's book.
+//
+// Unlike the other implementations, this one never stores H. The forward pass
+// keeps one row per block, plus the edges between the blocks, and the
+// alignment is recovered afterwards with Hirschberg's algorithm. Memory use
+// is linear in the lengths of the sequences, and coordinates are 64-bit, so
+// sequences longer than 2^32 are fine.
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C)
+{
+    return (std::max)((std::max)(A, B), C);
+}
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C, T const& D)
+{
+    return (std::max)((std::max)((std::max)(A, B), C), D);
+}
+
+enum gap_scoring
+{
+    gap      = -1,
+    match    = +2,
+    mismatch = -1
+};
+
+inline boost::int64_t score(char ai, char bj)
+{
+    return (ai == bj) ? match : mismatch;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct coords
+{
+    coords() : i(0), j(0) {}
+
+    coords(boost::uint64_t i_, boost::uint64_t j_) : i(i_), j(j_) {}
+
+    boost::uint64_t i;
+    boost::uint64_t j;
+};
+
+std::ostream& operator<<(std::ostream& out, coords const& c)
+{
+    out << "(" << c.i << "," << c.j << ")";
+    return out;
+}
+
+// A cell of H, and the zero cell of H that the best alignment ending in it
+// starts from.
+struct cell
+{
+    cell() : value(0), start() {}
+
+    cell(boost::int64_t value_, coords start_)
+      : value(value_), start(start_)
+    {}
+
+    boost::int64_t value;
+    coords start;
+};
+
+// The best cell, and the cell where the local alignment which ends there
+// starts.
+struct anchored_winner : winner
+{
+    anchored_winner() : winner(), start() {}
+
+    anchored_winner(
+        boost::int64_t value_
+      , boost::uint64_t i_
+      , boost::uint64_t j_
+      , coords start_
+        )
+      : winner(value_, i_, j_), start(start_)
+    {}
+
+    coords start;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct alignment
+{
+    anchored_winner best;
+    std::vector<coords> backpath;
+};
+
+// The blocks of the forward pass, and the state that they share: the bottom
+// row of the blocks above (rows), the right column of the blocks to the left
+// (cols), and the bottom-right cell of each block (corners), which is the
+// diagonal neighbour of the top-left cell of the block below and to the
+// right of it.
+struct forward_pass
+{
+    forward_pass(
+        std::string const& a_
+      , std::string const& b_
+      , boost::uint64_t grain_size
+        )
+      : a(a_)
+      , b(b_)
+      , block_rows((a_.size() + grain_size - 1) / grain_size)
+      , block_cols((b_.size() + grain_size - 1) / grain_size)
+      , rows(b_.size() + 1)
+      , cols(a_.size() + 1)
+      , corners(block_rows + 1, block_cols + 1)
+      , winners(block_rows, block_cols)
+    {
+        for (boost::uint64_t j = 0; j <= b.size(); ++j)
+            rows[j] = cell(0, coords(0, j));
+
+        for (boost::uint64_t i = 0; i <= a.size(); ++i)
+            cols[i] = cell(0, coords(i, 0));
+
+        for (boost::uint64_t x = 0; x <= block_rows; ++x)
+            corners(x, 0) = cell(0, coords(row_offset(x), 0));
+
+        for (boost::uint64_t x = 0; x <= block_cols; ++x)
+            corners(0, x) = cell(0, coords(0, col_offset(x)));
+    }
+
+    // The blocks are as even as possible, with sides of at most grain_size
+    // cells; their edges are H coordinates.
+    boost::uint64_t row_offset(boost::uint64_t I) const
+    {
+        return I * a.size() / block_rows;
+    }
+
+    boost::uint64_t col_offset(boost::uint64_t J) const
+    {
+        return J * b.size() / block_cols;
+    }
+
+    std::string const& a;
+    std::string const& b;
+
+    boost::uint64_t const block_rows;
+    boost::uint64_t const block_cols;
+
+    std::vector<cell> rows;
+    std::vector<cell> cols;
+    hpxla::local_matrix<cell> corners;
+
+    // The best cell of each block, combined once all of them are done.
+    hpxla::local_matrix<anchored_winner> winners;
+};
+
+// Scores block (I, J) of the forward pass, once the blocks above it and to
+// the left of it are done; the one on the diagonal is done before either of
+// them starts.
+void calc_block(
+    forward_pass& f
+  , boost::uint64_t I
+  , boost::uint64_t J
+    )
+{
+    boost::uint64_t const i_begin = f.row_offset(I) + 1;
+    boost::uint64_t const i_end = f.row_offset(I + 1) + 1;
+    boost::uint64_t const j_begin = f.col_offset(J) + 1;
+    boost::uint64_t const j_end = f.col_offset(J + 1) + 1;
+
+    // up holds row i - 1 of the block, and left holds row i. Both start with
+    // the cell in column j_begin - 1. That cell of up comes from corners, not
+    // rows; block (I + 1, J - 1) may be writing it to rows concurrently.
+    std::vector<cell> up(j_end - j_begin + 1);
+    std::vector<cell> left(up.size());
+
+    up[0] = f.corners(I, J);
+    std::copy(f.rows.begin() + j_begin, f.rows.begin() + j_end, up.begin() + 1);
+
+    anchored_winner local_best;
+
+    for (boost::uint64_t i = i_begin; i < i_end; ++i)
+    {
+        left[0] = f.cols[i];
+
+        for (boost::uint64_t j = j_begin; j < j_end; ++j)
+        {
+            boost::uint64_t const x = j - j_begin + 1;
+
+            boost::int64_t const diagonal
+                = up[x-1].value + score(f.a[i-1], f.b[j-1]);
+            boost::int64_t const deletion = up[x].value + gap;
+            boost::int64_t const insertion = left[x-1].value + gap;
+
+            boost::int64_t const value = maximum(boost::int64_t(0)
+                                               , diagonal, deletion, insertion);
+
+            // Follow the same move that the backtracking in the other
+            // implementations would.
+            if (value == 0)
+                left[x] = cell(0, coords(i, j));
+            else if (value == diagonal)
+                left[x] = cell(value, up[x-1].start);
+            else if (value == insertion)
+                left[x] = cell(value, left[x-1].start);
+            else
+                left[x] = cell(value, up[x].start);
+
+            if (value > local_best.value)
+                local_best = anchored_winner(value, i, j, left[x].start);
+        }
+
+        f.cols[i] = left.back();
+
+        std::swap(up, left);
+    }
+
+    std::copy(up.begin() + 1, up.end(), f.rows.begin() + j_begin);
+
+    f.corners(I + 1, J + 1) = up.back();
+    f.winners(I, J) = local_best;
+}
+
+struct forward_block
+{
+    typedef void result_type;
+
+    explicit forward_block(forward_pass& f_) : f(f_) {}
+
+    void operator()(
+        boost::uint64_t I
+      , boost::uint64_t J
+        ) const
+    {
+        calc_block(f, I, J);
+    }
+
+    forward_pass& f;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Hirschberg's algorithm: a global alignment in linear space. The moves of an
+// alignment are written as a string: 'M' consumes a character from both
+// sequences, 'U' (up) one from a only and 'L' (left) one from b only.
+
+// Problems with fewer cells than this are aligned with a full matrix.
+boost::uint64_t const hirschberg_cutoff = 1 << 14;
+
+// Problems with more cells than this are split across two tasks.
+boost::uint64_t const hirschberg_parallel_cutoff = 1 << 18;
+
+// Returns the last row of the global alignment scores of [a_first, a_last)
+// against each prefix of [b_first, b_last).
+template <typename Iterator>
+std::vector<boost::int64_t> last_row(
+    Iterator a_first
+  , Iterator a_last
+  , Iterator b_first
+  , Iterator b_last
+    )
+{
+    std::size_t const n = b_last - b_first;
+
+    std::vector<boost::int64_t> row(n + 1);
+
+    for (std::size_t k = 0; k <= n; ++k)
+        row[k] = boost::int64_t(k) * gap;
+
+    for (; a_first != a_last; ++a_first)
+    {
+        boost::int64_t diagonal = row[0];
+        row[0] += gap;
+
+        for (std::size_t k = 1; k <= n; ++k)
+        {
+            boost::int64_t const up = row[k];
+
+            row[k] = maximum(diagonal + score(*a_first, b_first[k-1])
+                           , up + gap, row[k-1] + gap);
+
+            diagonal = up;
+        }
+    }
+
+    return row;
+}
+
+std::vector<boost::int64_t> forward_row(
+    std::string const& a
+  , std::string const& b
+  , coords begin
+  , coords end
+    )
+{
+    return last_row(a.begin() + begin.i, a.begin() + end.i
+                  , b.begin() + begin.j, b.begin() + end.j);
+}
+
+std::vector<boost::int64_t> reverse_row(
+    std::string const& a
+  , std::string const& b
+  , coords begin
+  , coords end
+    )
+{
+    return last_row(a.rbegin() + (a.size() - end.i)
+                  , a.rbegin() + (a.size() - begin.i)
+                  , b.rbegin() + (b.size() - end.j)
+                  , b.rbegin() + (b.size() - begin.j));
+}
+
+// Aligns a[begin.i, end.i) with b[begin.j, end.j) with a full matrix.
+std::string align_small(
+    std::string const& a
+  , std::string const& b
+  , coords begin
+  , coords end
+    )
+{
+    boost::uint64_t const m = end.i - begin.i;
+    boost::uint64_t const n = end.j - begin.j;
+
+    // Every cell is written before it is read.
+    hpxla::local_matrix<
+        boost::int64_t
+      , hpxla::local_matrix_policy<
+            hpxla::policy::column_major_indexing
+          , hpxla::policy::default_init_allocator<
+                std::allocator<hpx::util::unused_type>
+            >
+        >
+    > H(m + 1, n + 1, hpxla::uninitialized);
+
+    for (boost::uint64_t i = 0; i <= m; ++i)
+        H(i, 0) = boost::int64_t(i) * gap;
+
+    for (boost::uint64_t j = 0; j <= n; ++j)
+        H(0, j) = boost::int64_t(j) * gap;
+
+    for (boost::uint64_t j = 1; j <= n; ++j)
+        for (boost::uint64_t i = 1; i <= m; ++i)
+            H(i, j) = maximum(
+                H(i-1, j-1) + score(a[begin.i+i-1], b[begin.j+j-1])
+              , H(i-1, j) + gap
+              , H(i, j-1) + gap);
+
+    std::string moves;
+
+    boost::uint64_t i = m, j = n;
+
+    while (i != 0 || j != 0)
+    {
+        if (  i != 0 && j != 0
+           && H(i, j) == H(i-1, j-1) + score(a[begin.i+i-1], b[begin.j+j-1]))
+        {
+            moves += 'M';
+            --i;
+            --j;
+        }
+        else if (i != 0 && H(i, j) == H(i-1, j) + gap)
+        {
+            moves += 'U';
+            --i;
+        }
+        else
+        {
+            moves += 'L';
+            --j;
+        }
+    }
+
+    std::reverse(moves.begin(), moves.end());
+
+    return moves;
+}
+
+std::string hirschberg(
+    std::string const& a
+  , std::string const& b
+  , coords begin
+  , coords end
+    )
+{
+    boost::uint64_t const m = end.i - begin.i;
+    boost::uint64_t const n = end.j - begin.j;
+
+    if (m <= 1 || n <= 1 || m * n <= hirschberg_cutoff)
+        return align_small(a, b, begin, end);
+
+    bool const parallel = m * n > hirschberg_parallel_cutoff;
+
+    // Split a in half, and find where the optimal alignment crosses the
+    // middle row by scoring the top half forwards and the bottom half
+    // backwards.
+    boost::uint64_t const middle = begin.i + m / 2;
+
+    // The rows are freed before recursing, so that only one pair of them per
+    // level of the recursion is live at a time.
+    boost::uint64_t split = 0;
+
+    {
+        std::vector<boost::int64_t> top, bottom;
+
+        if (parallel)
+        {
+            hpx::lcos::future<std::vector<boost::int64_t> > top_future
+                = hpx::async(&forward_row, boost::cref(a), boost::cref(b)
+                           , begin, coords(middle, end.j));
+
+            bottom = reverse_row(a, b, coords(middle, begin.j), end);
+            top = top_future.get();
+        }
+        else
+        {
+            top = forward_row(a, b, begin, coords(middle, end.j));
+            bottom = reverse_row(a, b, coords(middle, begin.j), end);
+        }
+
+        for (boost::uint64_t k = 1; k <= n; ++k)
+            if (top[k] + bottom[n-k] > top[split] + bottom[n-split])
+                split = k;
+    }
+
+    coords const cross(middle, begin.j + split);
+
+    if (parallel)
+    {
+        hpx::lcos::future<std::string> first
+            = hpx::async(&hirschberg, boost::cref(a), boost::cref(b)
+                       , begin, cross);
+
+        std::string const second = hirschberg(a, b, cross, end);
+
+        return first.get() + second;
+    }
+
+    return hirschberg(a, b, begin, cross) + hirschberg(a, b, cross, end);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+alignment smith_waterman(
+    std::string const& a
+  , std::string const& b
+  , boost::uint64_t grain_size
+    )
+{
+    BOOST_ASSERT(grain_size != 0);
+
+    alignment result;
+
+    if (a.empty() || b.empty())
+        return result;
+
+    forward_pass f(a, b, grain_size);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Find the best score, and where its alignment starts.
+
+    hpxla::for_each_wavefront(hpxla::matrix_bounds(f.block_rows, f.block_cols)
+                            , forward_block(f));
+
+    for (boost::uint64_t I = 0; I < f.block_rows; ++I)
+        for (boost::uint64_t J = 0; J < f.block_cols; ++J)
+            if (better(f.winners(I, J), result.best))
+                result.best = f.winners(I, J);
+
+    if (result.best.value == 0)
+        return result;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Backtracking. The best alignment is the best global alignment of the
+    // pieces of a and b between its start and its end.
+    coords const end(result.best.i, result.best.j);
+
+    std::string const moves = hirschberg(a, b, result.best.start, end);
+
+    coords last = end;
+    result.backpath.push_back(last);
+
+    // Walk backwards from the end, up to the first aligned cell.
+    for (std::size_t x = moves.size() - 1; x != 0; --x)
+    {
+        if (moves[x] != 'L')
+            --last.i;
+        if (moves[x] != 'U')
+            --last.j;
+
+        result.backpath.push_back(last);
+    }
+
+    return result;
+}
+
+void benchmark_sw(
+    boost::random::mt19937& rng
+  , boost::uint32_t seed
+  , boost::uint32_t length
+  , boost::uint32_t grain_size
+  , boost::uint32_t iterations = 1 << 10
+    )
+{
+    std::string const chars("ATGC");
+
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Generate our sequences using the mt19937 random number generator.
+    std::string a, b;
+
+    for (boost::uint32_t x = 0; x < length; ++x)
+    {
+        a += chars[index_dist(rng)];
+        b += chars[index_dist(rng)];
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Generate our sequences using the mt19937 random number generator.
+    hpx::util::high_resolution_timer t;
+
+    for (boost::uint32_t x = 0; x < iterations; ++x)
+        smith_waterman(a, b, grain_size);
+
+    double runtime = t.elapsed();
+
+    std::cout << seed << ","
+              << hpx::get_os_thread_count() << ","
+              << length << ","
+              << grain_size << ","
+              << iterations << ","
+              << runtime << "\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A plain implementation with a full H, to check the linear one against.
+anchored_winner reference_sw(
+    std::string const& a
+  , std::string const& b
+    )
+{
+    hpxla::local_matrix<boost::int64_t> H(a.size() + 1, b.size() + 1, 0);
+
+    anchored_winner best;
+
+    for (boost::uint64_t i = 1; i <= a.size(); ++i)
+        for (boost::uint64_t j = 1; j <= b.size(); ++j)
+        {
+            H(i, j) = maximum(boost::int64_t(0)
+                            , H(i-1, j-1) + score(a[i-1], b[j-1])
+                            , H(i-1, j) + gap
+                            , H(i, j-1) + gap);
+
+            if (H(i, j) > best.value)
+                best = anchored_winner(H(i, j), i, j, coords());
+        }
+
+    return best;
+}
+
+// Returns true if backpath is a path through H, from the best cell back to
+// the first cell of an alignment, which scores as much as the best cell.
+bool check_backpath(
+    std::string const& a
+  , std::string const& b
+  , alignment const& align
+    )
+{
+    std::vector<coords> const& path = align.backpath;
+
+    if (path.empty())
+        return align.best.value == 0;
+
+    if (path.front().i != align.best.i || path.front().j != align.best.j)
+        return false;
+
+    // The first aligned cell always matches.
+    coords const first = path.back();
+
+    if (first.i == 0 || first.j == 0 || a[first.i-1] != b[first.j-1])
+        return false;
+
+    boost::int64_t total = match;
+
+    for (std::size_t x = path.size() - 1; x != 0; --x)
+    {
+        coords const from = path[x];
+        coords const to = path[x-1];
+
+        if (to.i == from.i + 1 && to.j == from.j + 1)
+            total += score(a[to.i-1], b[to.j-1]);
+        else if (  (to.i == from.i + 1 && to.j == from.j)
+                || (to.i == from.i && to.j == from.j + 1))
+            total += gap;
+        else
+            return false;
+    }
+
+    return total == align.best.value;
+}
+
+void validate_sw(
+    boost::uint32_t grain_size = 1
+  , std::string const& a = "AGCACACA"
+  , std::string const& b = "ACACACTA"
+    )
+{
+    std::cout << "A: " << a << "\n"
+              << "B: " << b << "\n"
+              << "grain-size: " << grain_size << "\n\n";
+
+    alignment const align = smith_waterman(a, b, grain_size);
+
+    // Print the alignment, with gaps as '-'.
+    std::string top, bottom;
+
+    for (std::size_t x = align.backpath.size(); x != 0; --x)
+    {
+        coords const c = align.backpath[x-1];
+        coords const previous = (x == align.backpath.size())
+                              ? coords(c.i - 1, c.j - 1)
+                              : align.backpath[x];
+
+        top += (c.i != previous.i) ? a[c.i-1] : '-';
+        bottom += (c.j != previous.j) ? b[c.j-1] : '-';
+    }
+
+    std::cout << "score: " << align.best.value << "\n"
+              << "\t" << top << "\n"
+              << "\t" << bottom << "\n\n";
+}
+
+// Checks that the linear implementation finds the same best cell as one which
+// stores all of H, and that its alignment really scores that much.
+bool cross_validate_sw(
+    boost::random::mt19937& rng
+  , boost::uint32_t a_length
+  , boost::uint32_t b_length
+  , boost::uint32_t grain_size
+    )
+{
+    std::string const chars("ATGC");
+
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    std::string a, b;
+
+    for (boost::uint32_t x = 0; x < a_length; ++x)
+        a += chars[index_dist(rng)];
+
+    for (boost::uint32_t x = 0; x < b_length; ++x)
+        b += chars[index_dist(rng)];
+
+    alignment const align = smith_waterman(a, b, grain_size);
+    anchored_winner const reference = reference_sw(a, b);
+
+    bool const valid = align.best.value == reference.value
+                    && align.best.i == reference.i
+                    && align.best.j == reference.j
+                    && check_backpath(a, b, align);
+
+    std::cout << "cross-validation, lengths " << a_length << " x " << b_length
+              << ", grain-size " << grain_size << ": "
+              << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
+template <typename Iterator>
+bool read_list(Iterator first, Iterator last, std::vector<boost::uint32_t>& v)
+{
+    using boost::spirit::qi::uint_parser;
+    using boost::spirit::qi::phrase_parse;
+    using boost::spirit::qi::_1;
+    using boost::spirit::ascii::space;
+
+    uint_parser<boost::uint32_t> size_t_;
+
+    bool r = phrase_parse(first, last, size_t_ % ',', space, v);
+
+    if (first != last)
+        return false;
+
+    return r;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    ///////////////////////////////////////////////////////////////////////
+    // Handle commandline options.
+
+    // Initialize the PRNG seed.
+    boost::uint32_t seed = vm["seed"].as<boost::uint32_t>();
+
+    if (!seed)
+        seed = boost::uint32_t(std::time(0));
+
+    boost::uint32_t iterations = vm["iterations"].as<boost::uint32_t>();
+
+    // Parse lengths.
+    std::string raw_lengths = vm["lengths"].as<std::string>();
+
+    std::vector<boost::uint32_t> lengths;
+
+    if (!read_list(raw_lengths.begin(), raw_lengths.end(), lengths))
+        throw std::invalid_argument("--lengths argument not be parsed\n");
+
+    // Parse grain sizes.
+    std::string raw_grain_sizes = vm["grain-sizes"].as<std::string>();
+
+    std::vector<boost::uint32_t> grain_sizes;
+
+    if (!read_list(raw_grain_sizes.begin(), raw_grain_sizes.end(), grain_sizes))
+        throw std::invalid_argument("--grain-sizes could not be parsed\n");
+
+    if (grain_sizes.size() != lengths.size())
+        throw std::invalid_argument(
+            "--grain-sizes must have as many elements as --lengths\n");
+
+    if (std::count(grain_sizes.begin(), grain_sizes.end(), 0u))
+        throw std::invalid_argument("--grain-sizes must be greater than 0\n");
+
+    boost::random::mt19937 rng(seed);
+
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Validate implementation.
+        if (vm.count("validate"))
+        {
+            validate_sw(1);
+            validate_sw(2);
+
+            bool valid = true;
+
+            valid = cross_validate_sw(rng, 8, 8, 1) && valid;
+            valid = cross_validate_sw(rng, 1, 30, 3) && valid;
+            valid = cross_validate_sw(rng, 61, 17, 4) && valid;
+            valid = cross_validate_sw(rng, 255, 256, 5) && valid;
+            valid = cross_validate_sw(rng, 600, 1000, 70) && valid;
+            valid = cross_validate_sw(rng, 2000, 2000, 256) && valid;
+
+            if (!valid)
+                throw std::runtime_error("linear cross-validation failed\n");
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Benchmark implementation.
+
+        // Print out header rows.
+        if (!vm.count("no-header"))
+            std::cout
+                << "HPX Linear SMP Smith-Waterman Performance\n"
+                << "Seed,OS-Threads,Sequence Length,Grain Size,Iterations,"
+                   "Total Walltime (s)\n";
+
+        for (boost::uint32_t x = 0; x < lengths.size(); ++x)
+            benchmark_sw(rng, seed, lengths[x], grain_sizes[x], iterations);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char** argv)
+{
+    using namespace boost::program_options;
+
+    variables_map vm;
+
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "lengths"
+        , value<std::string>()->default_value("32,64,128,256")
+        , "sequence lengths to use (comma seperated list)")
+
+        ( "grain-sizes"
+        , value<std::string>()->default_value("4,4,4,4")
+        , "grain sizes to use, in cells per side of a block, as in the "
+          "blocked implementation (comma seperated list, must have the same "
+          "number of elements as --lengths)")
+
+        ( "validate"
+        , "run validation code, and check the results against a full "
+          "matrix, before performing benchmarks")
+
+        ( "no-header"
+        , "do not print out the CSV header for the benchmark data")
+
+        ( "iterations"
+        , value<boost::uint32_t>()->default_value(1024)
+        , "number of tests to perform for each sequence length")
+
+        ( "seed"
+        , value<boost::uint32_t>()->default_value(0)
+        , "seed for the pseudo random number generator (if 0, a seed is "
+          "choosen based on the current system time)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
+
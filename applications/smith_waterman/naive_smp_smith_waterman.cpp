@@ -10,8 +10,9 @@
 #include <hpxla/local_matrix.hpp>
 #include <hpxla/local_matrix_view.hpp>
 
+#include "winner.hpp"
+
 #include <boost/spirit/include/qi.hpp>
-#include <boost/atomic.hpp>
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/ref.hpp>
@@ -69,27 +70,8 @@ struct alignment
     std::vector<coords> backpath;
 };
 
-// Keep this under 128 bits and it'll be lockfree when used with boost::atomic<>
-// on (modern) x86-64 platforms.
-struct winner
-{
-    winner() : value(0), i(0), j(0) {}
-
-    winner(boost::int64_t value_, boost::uint32_t i_, boost::uint32_t j_)
-      : value(value_), i(i_), j(j_)
-    {}
-
-    boost::int64_t value;
-    boost::uint32_t i;
-    boost::uint32_t j;
-};
-
-boost::atomic<winner> H_best(winner(0, 0, 0));
-
 boost::int64_t calc_cell(
-    boost::uint32_t i
-  , boost::uint32_t j
-  , char ai
+    char ai
   , char bj
   , hpx::shared_future<boost::int64_t> const &left      // H(i, j-1)
   , hpx::shared_future<boost::int64_t> const &diagonal  // H(i-1, j-1)
@@ -111,21 +93,6 @@ boost::int64_t calc_cell(
     boost::int64_t ij_value
         = maximum(boost::int64_t(0), match_mismatch, deletion, insertion);
 
-    winner H_best_old = H_best.load(); 
-
-    while (true)
-    {
-        winner H_best_new(ij_value, i, j);
-
-        if (H_best_new.value > H_best_old.value)
-        {
-            if (H_best.compare_exchange_weak(H_best_old, H_best_new))
-                break;
-        }
-        else
-            break;
-    }
-
     return ij_value;
 }
 
@@ -164,22 +131,33 @@ alignment smith_waterman(std::string const& a, std::string const& b)
         for (boost::uint32_t j = 1; j < k; ++j)
         {
             typedef hpxla::local_matrix_view<hpx::shared_future<boost::int64_t> >::value_type mtx_type;
-            H(i, j) = hpx::async(calc_cell, i, j, a[i-1], b[j-1]
+            H(i, j) = hpx::async(calc_cell, a[i-1], b[j-1]
                                , boost::reference_wrapper<mtx_type>(H(i, j-1))   // left dependency
                                , boost::reference_wrapper<mtx_type>(H(i-1, j-1)) // dgnl dependency 
                                , boost::reference_wrapper<mtx_type>(H(i-1, j))); // top dependency
         } 
     }  
 
+    // Each cell is a task, so the best one is found once they are all done,
+    // instead of every task competing to update a shared best.
+    winner H_max;
+
     for (boost::uint32_t i = 1; i < k; ++i)
+    {
         for (boost::uint32_t j = 1; j < k; ++j)
-            H(i, j).get(); 
+        {
+            winner const w(H(i, j).get(), i, j);
+
+            if (better(w, H_max))
+                H_max = w;
+        }
+    }
 
     ///////////////////////////////////////////////////////////////////////////
     // Backtracking.
 
     // 0.) Make a vector to hold coords.
-    // 1.) We want to start at H_best, or the coordinate of H_best, so
+    // 1.) We want to start at H_max, or the coordinate of H_max, so
     //     (i_max, j_max).
     // 2.) Then, determine which value is largest (where i is initially i_max,
     //     and j is initially j_max):
@@ -187,9 +165,7 @@ alignment smith_waterman(std::string const& a, std::string const& b)
     //        (i-1, j)   for an insertion, and
     //        (i, j-1)   for a deletion. 
     // 3.) Reset the current i and j coords to equal next i and j coords. 
-   
-    winner H_max = H_best.load();
- 
+
     std::vector<coords>& backpath = result.backpath;
     backpath.push_back(coords(H_max.i, H_max.j)); 
 
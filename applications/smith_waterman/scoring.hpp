@@ -0,0 +1,220 @@
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPXLA_9E0C4F7A_51B2_4E86_A3D5_2C7B18F06E94)
+#define HPXLA_9E0C4F7A_51B2_4E86_A3D5_2C7B18F06E94
+
+#include <cctype>
+#include <cstddef>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+
+// Scoring schemes for the Smith-Waterman kernels. A scoring scheme is a
+// substitution scheme plus gap penalties, and provides:
+//
+//     score(a, b)   - The score for aligning a with b.
+//     max_score     - The largest value score() can return.
+//     min_score     - The smallest value score() can return.
+//     gap_open()    - The penalty (a positive number) for the first character
+//                     of a gap.
+//     gap_extend()  - The penalty for each further character of a gap.
+//     alphabet()    - The characters that random sequences are drawn from.
+//     name()
+//
+// So a gap of length k costs gap_open() + (k - 1) * gap_extend(). With
+// linear<>, both penalties are compile-time constants and are equal, so the
+// kernels compile to the same code as with hard-coded scores. With affine<>,
+// they are set at runtime (Gotoh's algorithm).
+
+namespace scoring
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Substitution schemes.
+
+/// Nucleotides: +2 for a match, -1 for a mismatch.
+struct dna
+{
+    static boost::int32_t const max_score = 2;
+    static boost::int32_t const min_score = -1;
+
+    static boost::int32_t score(char a, char b)
+    {
+        return (a == b) ? max_score : min_score;
+    }
+
+    static char const* alphabet() { return "ATGC"; }
+    static char const* name() { return "DNA"; }
+};
+
+namespace detail
+{
+
+// The rows and columns of the amino acid tables, in NCBI order.
+char const residues[] = "ARNDCQEGHILKMFPSTWYVBZX*";
+
+std::size_t const residue_count = 24;
+
+// The row of the tables for each character. Lowercase letters are treated
+// like uppercase ones, and unknown characters like X.
+struct residue_indices
+{
+    residue_indices()
+    {
+        for (std::size_t c = 0; c < 256; ++c)
+            index[c] = 22; // X
+
+        for (std::size_t r = 0; r < residue_count; ++r)
+        {
+            unsigned char const c = residues[r];
+            index[c] = boost::uint8_t(r);
+            index[std::tolower(c)] = boost::uint8_t(r);
+        }
+    }
+
+    boost::uint8_t index[256];
+};
+
+inline std::size_t residue_index(char c)
+{
+    static residue_indices const indices;
+    return indices.index[static_cast<unsigned char>(c)];
+}
+
+boost::int8_t const blosum62_table[24][24] = {
+//     A  R  N  D  C  Q  E  G  H  I  L  K  M  F  P  S  T  W  Y  V  B  Z  X  *
+    {  4,-1,-2,-2, 0,-1,-1, 0,-2,-1,-1,-1,-1,-2,-1, 1, 0,-3,-2, 0,-2,-1, 0,-4}
+  , { -1, 5, 0,-2,-3, 1, 0,-2, 0,-3,-2, 2,-1,-3,-2,-1,-1,-3,-2,-3,-1, 0,-1,-4}
+  , { -2, 0, 6, 1,-3, 0, 0, 0, 1,-3,-3, 0,-2,-3,-2, 1, 0,-4,-2,-3, 3, 0,-1,-4}
+  , { -2,-2, 1, 6,-3, 0, 2,-1,-1,-3,-4,-1,-3,-3,-1, 0,-1,-4,-3,-3, 4, 1,-1,-4}
+  , {  0,-3,-3,-3, 9,-3,-4,-3,-3,-1,-1,-3,-1,-2,-3,-1,-1,-2,-2,-1,-3,-3,-2,-4}
+  , { -1, 1, 0, 0,-3, 5, 2,-2, 0,-3,-2, 1, 0,-3,-1, 0,-1,-2,-1,-2, 0, 3,-1,-4}
+  , { -1, 0, 0, 2,-4, 2, 5,-2, 0,-3,-3, 1,-2,-3,-1, 0,-1,-3,-2,-2, 1, 4,-1,-4}
+  , {  0,-2, 0,-1,-3,-2,-2, 6,-2,-4,-4,-2,-3,-3,-2, 0,-2,-2,-3,-3,-1,-2,-1,-4}
+  , { -2, 0, 1,-1,-3, 0, 0,-2, 8,-3,-3,-1,-2,-1,-2,-1,-2,-2, 2,-3, 0, 0,-1,-4}
+  , { -1,-3,-3,-3,-1,-3,-3,-4,-3, 4, 2,-3, 1, 0,-3,-2,-1,-3,-1, 3,-3,-3,-1,-4}
+  , { -1,-2,-3,-4,-1,-2,-3,-4,-3, 2, 4,-2, 2, 0,-3,-2,-1,-2,-1, 1,-4,-3,-1,-4}
+  , { -1, 2, 0,-1,-3, 1, 1,-2,-1,-3,-2, 5,-1,-3,-1, 0,-1,-3,-2,-2, 0, 1,-1,-4}
+  , { -1,-1,-2,-3,-1, 0,-2,-3,-2, 1, 2,-1, 5, 0,-2,-1,-1,-1,-1, 1,-3,-1,-1,-4}
+  , { -2,-3,-3,-3,-2,-3,-3,-3,-1, 0, 0,-3, 0, 6,-4,-2,-2, 1, 3,-1,-3,-3,-1,-4}
+  , { -1,-2,-2,-1,-3,-1,-1,-2,-2,-3,-3,-1,-2,-4, 7,-1,-1,-4,-3,-2,-2,-1,-2,-4}
+  , {  1,-1, 1, 0,-1, 0, 0, 0,-1,-2,-2, 0,-1,-2,-1, 4, 1,-3,-2,-2, 0, 0, 0,-4}
+  , {  0,-1, 0,-1,-1,-1,-1,-2,-2,-1,-1,-1,-1,-2,-1, 1, 5,-2,-2, 0,-1,-1, 0,-4}
+  , { -3,-3,-4,-4,-2,-2,-3,-2,-2,-3,-2,-3,-1, 1,-4,-3,-2,11, 2,-3,-4,-3,-2,-4}
+  , { -2,-2,-2,-3,-2,-1,-2,-3, 2,-1,-1,-2,-1, 3,-3,-2,-2, 2, 7,-1,-3,-2,-1,-4}
+  , {  0,-3,-3,-3,-1,-2,-2,-3,-3, 3, 1,-2, 1,-1,-2,-2, 0,-3,-1, 4,-3,-2,-1,-4}
+  , { -2,-1, 3, 4,-3, 0, 1,-1, 0,-3,-4, 0,-3,-3,-2, 0,-1,-4,-3,-3, 4, 1,-1,-4}
+  , { -1, 0, 0, 1,-3, 3, 4,-2, 0,-3,-3, 1,-1,-3,-1, 0,-1,-3,-2,-2, 1, 4,-1,-4}
+  , {  0,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2, 0, 0,-2,-1,-1,-1,-1,-1,-4}
+  , { -4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4, 1}
+};
+
+boost::int8_t const pam250_table[24][24] = {
+//     A  R  N  D  C  Q  E  G  H  I  L  K  M  F  P  S  T  W  Y  V  B  Z  X  *
+    {  2,-2, 0, 0,-2, 0, 0, 1,-1,-1,-2,-1,-1,-3, 1, 1, 1,-6,-3, 0, 0, 0, 0,-8}
+  , { -2, 6, 0,-1,-4, 1,-1,-3, 2,-2,-3, 3, 0,-4, 0, 0,-1, 2,-4,-2,-1, 0,-1,-8}
+  , {  0, 0, 2, 2,-4, 1, 1, 0, 2,-2,-3, 1,-2,-3, 0, 1, 0,-4,-2,-2, 2, 1, 0,-8}
+  , {  0,-1, 2, 4,-5, 2, 3, 1, 1,-2,-4, 0,-3,-6,-1, 0, 0,-7,-4,-2, 3, 3,-1,-8}
+  , { -2,-4,-4,-5,12,-5,-5,-3,-3,-2,-6,-5,-5,-4,-3, 0,-2,-8, 0,-2,-4,-5,-3,-8}
+  , {  0, 1, 1, 2,-5, 4, 2,-1, 3,-2,-2, 1,-1,-5, 0,-1,-1,-5,-4,-2, 1, 3,-1,-8}
+  , {  0,-1, 1, 3,-5, 2, 4, 0, 1,-2,-3, 0,-2,-5,-1, 0, 0,-7,-4,-2, 3, 3,-1,-8}
+  , {  1,-3, 0, 1,-3,-1, 0, 5,-2,-3,-4,-2,-3,-5, 0, 1, 0,-7,-5,-1, 0, 0,-1,-8}
+  , { -1, 2, 2, 1,-3, 3, 1,-2, 6,-2,-2, 0,-2,-2, 0,-1,-1,-3, 0,-2, 1, 2,-1,-8}
+  , { -1,-2,-2,-2,-2,-2,-2,-3,-2, 5, 2,-2, 2, 1,-2,-1, 0,-5,-1, 4,-2,-2,-1,-8}
+  , { -2,-3,-3,-4,-6,-2,-3,-4,-2, 2, 6,-3, 4, 2,-3,-3,-2,-2,-1, 2,-3,-3,-1,-8}
+  , { -1, 3, 1, 0,-5, 1, 0,-2, 0,-2,-3, 5, 0,-5,-1, 0, 0,-3,-4,-2, 1, 0,-1,-8}
+  , { -1, 0,-2,-3,-5,-1,-2,-3,-2, 2, 4, 0, 6, 0,-2,-2,-1,-4,-2, 2,-2,-2,-1,-8}
+  , { -3,-4,-3,-6,-4,-5,-5,-5,-2, 1, 2,-5, 0, 9,-5,-3,-3, 0, 7,-1,-4,-5,-2,-8}
+  , {  1, 0, 0,-1,-3, 0,-1, 0, 0,-2,-3,-1,-2,-5, 6, 1, 0,-6,-5,-1,-1, 0,-1,-8}
+  , {  1, 0, 1, 0, 0,-1, 0, 1,-1,-1,-3, 0,-2,-3, 1, 2, 1,-2,-3,-1, 0, 0, 0,-8}
+  , {  1,-1, 0, 0,-2,-1, 0, 0,-1, 0,-2, 0,-1,-3, 0, 1, 3,-5,-3, 0, 0,-1, 0,-8}
+  , { -6, 2,-4,-7,-8,-5,-7,-7,-3,-5,-2,-3,-4, 0,-6,-2,-5,17, 0,-6,-5,-6,-4,-8}
+  , { -3,-4,-2,-4, 0,-4,-4,-5, 0,-1,-1,-4,-2, 7,-5,-3,-3, 0,10,-2,-3,-4,-2,-8}
+  , {  0,-2,-2,-2,-2,-2,-2,-1,-2, 4, 2,-2, 2,-1,-1,-1, 0,-6,-2, 4,-2,-2,-1,-8}
+  , {  0,-1, 2, 3,-4, 1, 3, 0, 1,-2,-3, 1,-2,-4,-1, 0, 0,-5,-3,-2, 3, 2,-1,-8}
+  , {  0, 0, 1, 3,-5, 3, 3, 0, 2,-2,-3, 0,-2,-5, 0, 0,-1,-6,-4,-2, 2, 3,-1,-8}
+  , {  0,-1, 0,-1,-3,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1, 0, 0,-4,-2,-1,-1,-1,-1,-8}
+  , { -8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8,-8, 1}
+};
+
+}
+
+/// BLOSUM62 (Henikoff and Henikoff, 1992).
+struct blosum62
+{
+    static boost::int32_t const max_score = 11;
+    static boost::int32_t const min_score = -4;
+
+    static boost::int32_t score(char a, char b)
+    {
+        return detail::blosum62_table[detail::residue_index(a)]
+                                  [detail::residue_index(b)];
+    }
+
+    static char const* alphabet() { return "ARNDCQEGHILKMFPSTWYV"; }
+    static char const* name() { return "BLOSUM62"; }
+};
+
+/// PAM250 (Dayhoff, Schwartz and Orcutt, 1978).
+struct pam250
+{
+    static boost::int32_t const max_score = 17;
+    static boost::int32_t const min_score = -8;
+
+    static boost::int32_t score(char a, char b)
+    {
+        return detail::pam250_table[detail::residue_index(a)]
+                                [detail::residue_index(b)];
+    }
+
+    static char const* alphabet() { return "ARNDCQEGHILKMFPSTWYV"; }
+    static char const* name() { return "PAM250"; }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Gap penalties.
+
+/// Linear gaps: every character of a gap costs \a Gap.
+template <
+    typename Substitution
+  , boost::int32_t Gap = 1
+>
+struct linear : Substitution
+{
+    static boost::int32_t gap_open() { return Gap; }
+    static boost::int32_t gap_extend() { return Gap; }
+};
+
+/// Affine gaps: the first character of a gap costs \a gap_open, and each
+/// further character costs \a gap_extend.
+template <
+    typename Substitution
+>
+struct affine : Substitution
+{
+    affine(boost::int32_t gap_open_, boost::int32_t gap_extend_)
+      : open(gap_open_), extend(gap_extend_)
+    {
+        // The striped kernels rely on opening a gap costing at least as much
+        // as extending one.
+        BOOST_ASSERT(0 < extend && extend <= open);
+    }
+
+    boost::int32_t gap_open() const { return open; }
+    boost::int32_t gap_extend() const { return extend; }
+
+  private:
+    boost::int32_t open;
+    boost::int32_t extend;
+};
+
+/// The scheme the other Smith-Waterman implementations hard-code.
+typedef linear<dna> linear_dna;
+
+}
+
+#endif // HPXLA_9E0C4F7A_51B2_4E86_A3D5_2C7B18F06E94
+
@@ -0,0 +1,532 @@
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPXLA_5322491C_170C_49F8_A06B_1A994D56F2FB)
+#define HPXLA_5322491C_170C_49F8_A06B_1A994D56F2FB
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+// A minimal vector of 32-bit signed integers, for the Smith-Waterman scoring
+// kernels. The widest instruction set enabled at compile time is used:
+// AVX-512 (16 lanes), AVX2 (8 lanes), SSE2 (4 lanes), or a scalar fallback
+// (1 lane). Define HPXLA_SW_NO_SIMD to force the scalar fallback. The build
+// picks the instruction set with the HPXLA_SW_SIMD CMake option (by default,
+// SSE2, which every x86-64 machine has; "native" targets the build machine,
+// and its binaries may not run anywhere else).
+
+#if !defined(HPXLA_SW_NO_SIMD)
+    #if   defined(__AVX512F__)
+        #define HPXLA_SW_AVX512
+        #include <immintrin.h>
+    #elif defined(__AVX2__)
+        #define HPXLA_SW_AVX2
+        #include <immintrin.h>
+    #elif defined(__SSE2__) || defined(_M_X64)
+        #define HPXLA_SW_SSE2
+        #include <emmintrin.h>
+    #endif
+#endif
+
+namespace simd
+{
+
+#if   defined(HPXLA_SW_AVX512)
+
+typedef __m512i int32v;
+
+std::size_t const width = 16;
+
+inline char const* name() { return "AVX-512"; }
+
+inline int32v load(boost::int32_t const* p)
+{
+    return _mm512_loadu_si512(p);
+}
+
+inline void store(boost::int32_t* p, int32v v)
+{
+    _mm512_storeu_si512(p, v);
+}
+
+inline int32v splat(boost::int32_t x)
+{
+    return _mm512_set1_epi32(x);
+}
+
+inline int32v add(int32v a, int32v b)
+{
+    return _mm512_add_epi32(a, b);
+}
+
+inline int32v max(int32v a, int32v b)
+{
+    return _mm512_max_epi32(a, b);
+}
+
+/// Returns \a if_equal in the lanes where \a a == \a b, and \a otherwise in
+/// the others.
+inline int32v select_equal(
+    int32v a
+  , int32v b
+  , int32v if_equal
+  , int32v otherwise
+    )
+{
+    return _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(a, b)
+                                 , otherwise, if_equal);
+}
+
+#elif defined(HPXLA_SW_AVX2)
+
+typedef __m256i int32v;
+
+std::size_t const width = 8;
+
+inline char const* name() { return "AVX2"; }
+
+inline int32v load(boost::int32_t const* p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+}
+
+inline void store(boost::int32_t* p, int32v v)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+inline int32v splat(boost::int32_t x)
+{
+    return _mm256_set1_epi32(x);
+}
+
+inline int32v add(int32v a, int32v b)
+{
+    return _mm256_add_epi32(a, b);
+}
+
+inline int32v max(int32v a, int32v b)
+{
+    return _mm256_max_epi32(a, b);
+}
+
+/// Returns \a if_equal in the lanes where \a a == \a b, and \a otherwise in
+/// the others.
+inline int32v select_equal(
+    int32v a
+  , int32v b
+  , int32v if_equal
+  , int32v otherwise
+    )
+{
+    return _mm256_blendv_epi8(otherwise, if_equal, _mm256_cmpeq_epi32(a, b));
+}
+
+#elif defined(HPXLA_SW_SSE2)
+
+typedef __m128i int32v;
+
+std::size_t const width = 4;
+
+inline char const* name() { return "SSE2"; }
+
+inline int32v load(boost::int32_t const* p)
+{
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+}
+
+inline void store(boost::int32_t* p, int32v v)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+inline int32v splat(boost::int32_t x)
+{
+    return _mm_set1_epi32(x);
+}
+
+inline int32v add(int32v a, int32v b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+inline int32v blend(int32v mask, int32v if_set, int32v otherwise)
+{
+    return _mm_or_si128(_mm_and_si128(mask, if_set)
+                      , _mm_andnot_si128(mask, otherwise));
+}
+
+// SSE2 has no 32-bit max (that came with SSE4.1).
+inline int32v max(int32v a, int32v b)
+{
+    return blend(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+/// Returns \a if_equal in the lanes where \a a == \a b, and \a otherwise in
+/// the others.
+inline int32v select_equal(
+    int32v a
+  , int32v b
+  , int32v if_equal
+  , int32v otherwise
+    )
+{
+    return blend(_mm_cmpeq_epi32(a, b), if_equal, otherwise);
+}
+
+#else
+
+typedef boost::int32_t int32v;
+
+std::size_t const width = 1;
+
+inline char const* name() { return "scalar"; }
+
+inline int32v load(boost::int32_t const* p)
+{
+    return *p;
+}
+
+inline void store(boost::int32_t* p, int32v v)
+{
+    *p = v;
+}
+
+inline int32v splat(boost::int32_t x)
+{
+    return x;
+}
+
+inline int32v add(int32v a, int32v b)
+{
+    return a + b;
+}
+
+inline int32v max(int32v a, int32v b)
+{
+    return (a < b) ? b : a;
+}
+
+/// Returns \a if_equal if \a a == \a b, and \a otherwise if not.
+inline int32v select_equal(
+    int32v a
+  , int32v b
+  , int32v if_equal
+  , int32v otherwise
+    )
+{
+    return (a == b) ? if_equal : otherwise;
+}
+
+#endif
+
+/// Returns the largest lane of \a v.
+inline boost::int32_t reduce_max(int32v v)
+{
+    boost::int32_t lanes[width];
+    store(lanes, v);
+
+    boost::int32_t m = lanes[0];
+
+    for (std::size_t l = 1; l < width; ++l)
+        m = (m < lanes[l]) ? lanes[l] : m;
+
+    return m;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Vectors of 8-bit unsigned, 16-bit signed and 32-bit signed lanes, for the
+// striped kernels. The 8 and 16-bit lanes saturate instead of wrapping
+// around. These use AVX2 (32 bytes) when it is available, SSE2 (16 bytes) if
+// not, and a scalar fallback (1 lane) otherwise; AVX-512 builds use AVX2, as
+// AVX-512F has no 8 or 16-bit arithmetic.
+//
+// Every lanes<T> provides:
+//
+//     type                    - The vector type.
+//     width                   - The number of lanes.
+//     limit                   - The largest value a lane can hold.
+//     load(p), store(p, v)    - Unaligned loads and stores.
+//     splat(x)                - A vector with x in every lane.
+//     adds(a, b), subs(a, b)  - Addition and subtraction (saturating for the
+//                               8 and 16-bit lanes).
+//     max(a, b)               - Lane-wise maximum.
+//     shift(v)                - Moves lane l to lane l + 1, shifting in 0.
+//     any_greater(a, b)       - True if any lane of a is greater than b.
+
+template <typename T>
+struct lanes;
+
+#if defined(HPXLA_SW_AVX512) || defined(HPXLA_SW_AVX2)
+
+inline char const* lanes_name() { return "AVX2"; }
+
+// Shifts the whole register up by N bytes; _mm256_slli_si256 only shifts
+// within each 128-bit half.
+template <int N>
+inline __m256i shift_bytes(__m256i v)
+{
+    return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08)
+                            , 16 - N);
+}
+
+template <>
+struct lanes<boost::uint8_t>
+{
+    typedef __m256i type;
+
+    static std::size_t const width = 32;
+    static boost::int32_t const limit = 255;
+
+    static type load(boost::uint8_t const* p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+    }
+
+    static void store(boost::uint8_t* p, type v)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static type splat(boost::uint8_t x) { return _mm256_set1_epi8(x); }
+
+    static type adds(type a, type b) { return _mm256_adds_epu8(a, b); }
+    static type subs(type a, type b) { return _mm256_subs_epu8(a, b); }
+    static type max(type a, type b) { return _mm256_max_epu8(a, b); }
+
+    static type shift(type v) { return shift_bytes<1>(v); }
+
+    static bool any_greater(type a, type b)
+    {
+        // a > b in some lane iff a - b doesn't saturate to 0 there.
+        type const zero = _mm256_setzero_si256();
+        return _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_subs_epu8(a, b), zero)) != -1;
+    }
+};
+
+template <>
+struct lanes<boost::int16_t>
+{
+    typedef __m256i type;
+
+    static std::size_t const width = 16;
+    static boost::int32_t const limit = 32767;
+
+    static type load(boost::int16_t const* p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+    }
+
+    static void store(boost::int16_t* p, type v)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static type splat(boost::int16_t x) { return _mm256_set1_epi16(x); }
+
+    static type adds(type a, type b) { return _mm256_adds_epi16(a, b); }
+    static type subs(type a, type b) { return _mm256_subs_epi16(a, b); }
+    static type max(type a, type b) { return _mm256_max_epi16(a, b); }
+
+    static type shift(type v) { return shift_bytes<2>(v); }
+
+    static bool any_greater(type a, type b)
+    {
+        return _mm256_movemask_epi8(_mm256_cmpgt_epi16(a, b)) != 0;
+    }
+};
+
+template <>
+struct lanes<boost::int32_t>
+{
+    typedef __m256i type;
+
+    static std::size_t const width = 8;
+    static boost::int32_t const limit = 2147483647;
+
+    static type load(boost::int32_t const* p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+    }
+
+    static void store(boost::int32_t* p, type v)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+
+    static type splat(boost::int32_t x) { return _mm256_set1_epi32(x); }
+
+    static type adds(type a, type b) { return _mm256_add_epi32(a, b); }
+    static type subs(type a, type b) { return _mm256_sub_epi32(a, b); }
+    static type max(type a, type b) { return _mm256_max_epi32(a, b); }
+
+    static type shift(type v) { return shift_bytes<4>(v); }
+
+    static bool any_greater(type a, type b)
+    {
+        return _mm256_movemask_epi8(_mm256_cmpgt_epi32(a, b)) != 0;
+    }
+};
+
+#elif defined(HPXLA_SW_SSE2)
+
+inline char const* lanes_name() { return "SSE2"; }
+
+template <>
+struct lanes<boost::uint8_t>
+{
+    typedef __m128i type;
+
+    static std::size_t const width = 16;
+    static boost::int32_t const limit = 255;
+
+    static type load(boost::uint8_t const* p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    }
+
+    static void store(boost::uint8_t* p, type v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+
+    static type splat(boost::uint8_t x) { return _mm_set1_epi8(x); }
+
+    static type adds(type a, type b) { return _mm_adds_epu8(a, b); }
+    static type subs(type a, type b) { return _mm_subs_epu8(a, b); }
+    static type max(type a, type b) { return _mm_max_epu8(a, b); }
+
+    static type shift(type v) { return _mm_slli_si128(v, 1); }
+
+    static bool any_greater(type a, type b)
+    {
+        // a > b in some lane iff a - b doesn't saturate to 0 there.
+        type const zero = _mm_setzero_si128();
+        return _mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_subs_epu8(a, b), zero)) != 0xFFFF;
+    }
+};
+
+template <>
+struct lanes<boost::int16_t>
+{
+    typedef __m128i type;
+
+    static std::size_t const width = 8;
+    static boost::int32_t const limit = 32767;
+
+    static type load(boost::int16_t const* p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    }
+
+    static void store(boost::int16_t* p, type v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+
+    static type splat(boost::int16_t x) { return _mm_set1_epi16(x); }
+
+    static type adds(type a, type b) { return _mm_adds_epi16(a, b); }
+    static type subs(type a, type b) { return _mm_subs_epi16(a, b); }
+    static type max(type a, type b) { return _mm_max_epi16(a, b); }
+
+    static type shift(type v) { return _mm_slli_si128(v, 2); }
+
+    static bool any_greater(type a, type b)
+    {
+        return _mm_movemask_epi8(_mm_cmpgt_epi16(a, b)) != 0;
+    }
+};
+
+template <>
+struct lanes<boost::int32_t>
+{
+    typedef __m128i type;
+
+    static std::size_t const width = 4;
+    static boost::int32_t const limit = 2147483647;
+
+    static type load(boost::int32_t const* p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+    }
+
+    static void store(boost::int32_t* p, type v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+
+    static type splat(boost::int32_t x) { return _mm_set1_epi32(x); }
+
+    static type adds(type a, type b) { return _mm_add_epi32(a, b); }
+    static type subs(type a, type b) { return _mm_sub_epi32(a, b); }
+    static type max(type a, type b) { return simd::max(a, b); }
+
+    static type shift(type v) { return _mm_slli_si128(v, 4); }
+
+    static bool any_greater(type a, type b)
+    {
+        return _mm_movemask_epi8(_mm_cmpgt_epi32(a, b)) != 0;
+    }
+};
+
+#else
+
+inline char const* lanes_name() { return "scalar"; }
+
+template <
+    typename T
+  , boost::int32_t Lowest
+  , boost::int32_t Limit
+>
+struct scalar_lanes
+{
+    typedef T type;
+
+    static std::size_t const width = 1;
+    static boost::int32_t const limit = Limit;
+
+    static type load(T const* p) { return *p; }
+    static void store(T* p, type v) { *p = v; }
+    static type splat(T x) { return x; }
+
+    static type clamp(boost::int64_t x)
+    {
+        return T((x < Lowest) ? Lowest : ((x > Limit) ? Limit : x));
+    }
+
+    static type adds(type a, type b) { return clamp(boost::int64_t(a) + b); }
+    static type subs(type a, type b) { return clamp(boost::int64_t(a) - b); }
+    static type max(type a, type b) { return (a < b) ? b : a; }
+
+    static type shift(type) { return T(0); }
+
+    static bool any_greater(type a, type b) { return a > b; }
+};
+
+template <>
+struct lanes<boost::uint8_t>
+  : scalar_lanes<boost::uint8_t, 0, 255>
+{};
+
+template <>
+struct lanes<boost::int16_t>
+  : scalar_lanes<boost::int16_t, -32768, 32767>
+{};
+
+template <>
+struct lanes<boost::int32_t>
+  : scalar_lanes<boost::int32_t, (-2147483647 - 1), 2147483647>
+{};
+
+#endif
+
+}
+
+#endif // HPXLA_5322491C_170C_49F8_A06B_1A994D56F2FB
+
@@ -0,0 +1,723 @@
+//  Copyright (c) 2012 Stephanie Crillo and Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include "scoring.hpp"
+#include "simd.hpp"
+#include "winner.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <boost/ref.hpp>
+#include <boost/spirit/include/qi.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// Utility stuff written by Bryce. Instructions for Stephie:
+//
+// maximum() is a function that takes three or four arguments and returns the
+// highest of the three or four arguments.
+//
+// The scoring schemes (substitution scores and gap penalties) are in
+// scoring.hpp, and are template parameters of the kernels here.
+
+// WARN: This will break for sequences with length greater than 2^32.
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C)
+{
+    return (std::max)((std::max)(A, B), C);
+}
+
+template <typename T>
+T const& maximum(T const& A, T const& B, T const& C, T const& D)
+{
+    return (std::max)((std::max)((std::max)(A, B), C), D);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// Returns the largest lane of \a v.
+template <typename T>
+inline T horizontal_max(typename simd::lanes<T>::type v)
+{
+    T lanes[simd::lanes<T>::width];
+    simd::lanes<T>::store(lanes, v);
+
+    T m = lanes[0];
+
+    for (std::size_t l = 1; l < simd::lanes<T>::width; ++l)
+        m = (std::max)(m, lanes[l]);
+
+    return m;
+}
+
+/// Returns the smallest row of the striped column \a H which holds \a value.
+template <typename T>
+inline std::size_t first_row(
+    std::vector<T> const& H
+  , T value
+  , std::size_t segments
+    )
+{
+    std::size_t const width = simd::lanes<T>::width;
+
+    // The lanes hold consecutive runs of rows, so the first lane which holds
+    // value anywhere holds the first row.
+    for (std::size_t l = 0; l < width; ++l)
+        for (std::size_t s = 0; s < segments; ++s)
+            if (H[s * width + l] == value)
+                return l * segments + s;
+
+    BOOST_ASSERT(false);
+    return 0;
+}
+
+/// Moves lane l of \a v to lane l + 1, shifting \a floor into lane 0. \a v
+/// must be no greater than the limit of T plus \a floor, so that the
+/// adjustments don't saturate.
+template <typename T>
+inline typename simd::lanes<T>::type shift_floor(
+    typename simd::lanes<T>::type v
+  , typename simd::lanes<T>::type floor
+    )
+{
+    typedef simd::lanes<T> L;
+    return L::adds(L::shift(L::subs(v, floor)), floor);
+}
+
+// Farrar's striped Smith-Waterman (Farrar, "Striped Smith-Waterman speeds
+// database searches six times over other SIMD implementations", 2007).
+//
+// a is split into simd::lanes<T>::width interleaved stripes of length
+// segments: lane l of vector s holds row i = l * segments + s. Within a
+// column, the cell above the one in vector s is in vector s - 1, in the same
+// lane, so a column is scored one vector at a time. The vertical gaps (F)
+// which cross from one stripe into the next are fixed up afterwards, by the
+// "lazy F" loop; it rarely runs for more than a few vectors.
+//
+// The scores for each character of b are precomputed in stripe order (the
+// query profile), so scoring a vector is a single load and add.
+//
+// E holds the scores of the cells that end in a horizontal gap, and F those
+// that end in a vertical gap (Gotoh's algorithm); with linear gaps, opening
+// and extending a gap cost the same.
+//
+// H, E and F are kept in T. 8-bit lanes are unsigned, so the profile is
+// biased by -Scoring::min_score to keep it positive, and the bias is
+// subtracted again with saturation (which also clamps H at 0). Returns false
+// if a score gets close enough to the limit of T that it could saturate; the
+// caller then retries with wider lanes.
+template <
+    typename T
+  , typename Scoring
+>
+bool striped_sw(
+    std::string const& a
+  , std::string const& b
+  , Scoring const& scoring
+  , winner& best
+    )
+{
+    typedef simd::lanes<T> L;
+    typedef typename L::type vector_type;
+
+    best = winner();
+
+    if (a.empty() || b.empty())
+        return true;
+
+    std::size_t const width = L::width;
+    std::size_t const segments = (a.size() + width - 1) / width;
+
+    boost::int32_t const bias
+        = std::numeric_limits<T>::is_signed ? 0 : -Scoring::min_score;
+
+    // If no score is above this, the next column can't saturate.
+    boost::int32_t const ceiling = L::limit - (Scoring::max_score + bias);
+
+    // E and F start (and bottom out) one gap opening below 0.
+    T const floor
+        = std::numeric_limits<T>::is_signed ? T(-scoring.gap_open()) : T(0);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Build the query profile for each character that appears in b. The
+    // padding at the end of the last stripe gets the lowest score.
+    std::vector<std::vector<T> > profile(256);
+
+    for (std::size_t j = 0; j < b.size(); ++j)
+    {
+        std::vector<T>& p = profile[static_cast<unsigned char>(b[j])];
+
+        if (!p.empty())
+            continue;
+
+        p.resize(segments * width);
+
+        for (std::size_t s = 0; s < segments; ++s)
+            for (std::size_t l = 0; l < width; ++l)
+            {
+                std::size_t const i = l * segments + s;
+
+                boost::int32_t const score = (i < a.size())
+                                           ? scoring.score(a[i], b[j])
+                                           : Scoring::min_score;
+
+                p[s * width + l] = T(score + bias);
+            }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Score the columns.
+    std::vector<T> H_store(segments * width, T(0));
+    std::vector<T> H_load(segments * width, T(0));
+    std::vector<T> E(segments * width, floor);
+
+    // A copy of H_store for the column in which the best score was found.
+    std::vector<T> best_column;
+
+    vector_type const zero = L::splat(T(0));
+    vector_type const v_bias = L::splat(T(bias));
+    vector_type const v_gap_open = L::splat(T(scoring.gap_open()));
+    vector_type const v_gap_extend = L::splat(T(scoring.gap_extend()));
+    vector_type const v_floor = L::splat(floor);
+
+    for (std::size_t j = 0; j < b.size(); ++j)
+    {
+        T const* P = &profile[static_cast<unsigned char>(b[j])][0];
+
+        // The diagonal of the first vector is the last vector of the previous
+        // column, shifted down a lane.
+        vector_type F = L::splat(floor);
+        vector_type H = L::shift(L::load(&H_store[(segments - 1) * width]));
+        vector_type H_max = zero;
+
+        std::swap(H_load, H_store);
+
+        for (std::size_t s = 0; s < segments; ++s)
+        {
+            vector_type const e = L::load(&E[s * width]);
+
+            H = L::subs(L::adds(H, L::load(P + s * width)), v_bias);
+            H = L::max(L::max(H, zero), L::max(e, F));
+
+            H_max = L::max(H_max, H);
+            L::store(&H_store[s * width], H);
+
+            // Open gaps for the next column (E) and the next vector (F).
+            H = L::subs(H, v_gap_open);
+            L::store(&E[s * width], L::max(L::subs(e, v_gap_extend), H));
+            F = L::max(L::subs(F, v_gap_extend), H);
+
+            H = L::load(&H_load[s * width]);
+        }
+
+        // Lazy F: carry F across the stripes until it can no longer improve
+        // any cell. The first lane has no cell above it, so it gets the floor;
+        // shifting in 0 would keep the loop going forever when a pass over
+        // the stripes lowers F by less than a gap opening.
+        F = shift_floor<T>(F, v_floor);
+
+        std::size_t s = 0;
+
+        while (L::any_greater(F
+                , L::subs(L::load(&H_store[s * width]), v_gap_open)))
+        {
+            H = L::max(L::load(&H_store[s * width]), F);
+
+            H_max = L::max(H_max, H);
+            L::store(&H_store[s * width], H);
+
+            H = L::subs(H, v_gap_open);
+            L::store(&E[s * width], L::max(L::load(&E[s * width]), H));
+
+            F = L::subs(F, v_gap_extend);
+
+            if (++s == segments)
+            {
+                s = 0;
+                F = shift_floor<T>(F, v_floor);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Update the best score. Finding the row which holds it means
+        // searching the whole column, so when the best score goes up, the
+        // column is only copied; it is searched when a later column ties
+        // with it, or at the end.
+        T const column_best = horizontal_max<T>(H_max);
+
+        if (column_best > ceiling)
+            return false;
+
+        if (column_best > best.value)
+        {
+            best = winner(column_best, 0, j + 1);
+            best_column = H_store;
+        }
+
+        else if (column_best != 0 && column_best == best.value)
+        {
+            if (best.i == 0)
+                best.i = first_row(best_column, column_best, segments) + 1;
+
+            winner const candidate(column_best
+              , first_row(H_store, column_best, segments) + 1, j + 1);
+
+            if (better(candidate, best))
+                best = candidate;
+        }
+    }
+
+    if (best.value != 0 && best.i == 0)
+        best.i = first_row(best_column, T(best.value), segments) + 1;
+
+    return true;
+}
+
+// Scores a against b with 8-bit lanes, then with 16 and 32-bit lanes if the
+// score doesn't fit. bits is set to the width of the lanes that were used.
+template <typename Scoring>
+winner smith_waterman(
+    std::string const& a
+  , std::string const& b
+  , Scoring const& scoring
+  , boost::uint32_t& bits
+    )
+{
+    winner best;
+
+    bits = 8;
+
+    if (striped_sw<boost::uint8_t>(a, b, scoring, best))
+        return best;
+
+    bits = 16;
+
+    if (striped_sw<boost::int16_t>(a, b, scoring, best))
+        return best;
+
+    bits = 32;
+
+    bool const fits = striped_sw<boost::int32_t>(a, b, scoring, best);
+    BOOST_ASSERT(fits);
+    (void) fits;
+
+    return best;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A plain, one row at a time implementation of Gotoh's algorithm to check the
+// striped one against.
+template <typename Scoring>
+winner reference_sw(
+    std::string const& a
+  , std::string const& b
+  , Scoring const& scoring
+    )
+{
+    boost::int64_t const open = scoring.gap_open();
+    boost::int64_t const extend = scoring.gap_extend();
+
+    // No alignment can score this low.
+    boost::int64_t const never
+        = -open * boost::int64_t(a.size() + b.size() + 2);
+
+    // H and F for the previous and current rows; E only depends on the cell
+    // to the left.
+    std::vector<boost::int64_t> H_up(b.size() + 1, 0), H_row(b.size() + 1, 0);
+    std::vector<boost::int64_t> F(b.size() + 1, never);
+
+    winner best;
+
+    for (boost::uint32_t i = 1; i <= a.size(); ++i)
+    {
+        boost::int64_t E = never;
+
+        for (boost::uint32_t j = 1; j <= b.size(); ++j)
+        {
+            E = (std::max)(E - extend, H_row[j-1] - open);
+            F[j] = (std::max)(F[j] - extend, H_up[j] - open);
+
+            H_row[j] = maximum(boost::int64_t(0)
+                             , H_up[j-1] + scoring.score(a[i-1], b[j-1])
+                             , E, F[j]);
+
+            if (H_row[j] > best.value)
+                best = winner(H_row[j], i, j);
+        }
+
+        std::swap(H_up, H_row);
+    }
+
+    return best;
+}
+
+template <typename Scoring>
+void align_batch(
+    std::string const& a
+  , std::string const& b
+  , Scoring const& scoring
+  , boost::uint32_t count
+    )
+{
+    boost::uint32_t bits = 0;
+
+    for (boost::uint32_t x = 0; x < count; ++x)
+        smith_waterman(a, b, scoring, bits);
+}
+
+template <typename Scoring>
+void benchmark_sw(
+    boost::random::mt19937& rng
+  , boost::uint32_t seed
+  , boost::uint32_t length
+  , boost::uint32_t grain_size
+  , Scoring const& scoring
+  , boost::uint32_t iterations = 1 << 10
+    )
+{
+    std::string const chars(Scoring::alphabet());
+
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Generate our sequences using the mt19937 random number generator.
+    std::string a, b;
+
+    for (boost::uint32_t x = 0; x < length; ++x)
+    {
+        a += chars[index_dist(rng)];
+        b += chars[index_dist(rng)];
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Each alignment is sequential, so the iterations are run in parallel,
+    // grain_size of them per task.
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::lcos::future<void> > tasks;
+
+    for (boost::uint32_t x = 0; x < iterations; x += grain_size)
+        tasks.push_back(hpx::async(&align_batch<Scoring>
+          , boost::cref(a), boost::cref(b), boost::cref(scoring)
+          , (std::min)(grain_size, iterations - x)));
+
+    for (std::size_t x = 0; x < tasks.size(); ++x)
+        tasks[x].get();
+
+    double runtime = t.elapsed();
+
+    std::cout << seed << ","
+              << hpx::get_os_thread_count() << ","
+              << length << ","
+              << grain_size << ","
+              << iterations << ","
+              << runtime << "\n";
+}
+
+// Checks that the striped kernel finds the same best score, in the same
+// cell, as reference_sw().
+template <typename Scoring>
+bool validate_sw(
+    std::string const& a
+  , std::string const& b
+  , Scoring const& scoring
+  , std::string const& description
+    )
+{
+    boost::uint32_t bits = 0;
+
+    winner const striped = smith_waterman(a, b, scoring, bits);
+    winner const reference = reference_sw(a, b, scoring);
+
+    bool const valid = striped.value == reference.value
+                    && striped.i == reference.i
+                    && striped.j == reference.j;
+
+    std::cout << "validation (" << simd::lanes_name() << ", "
+              << Scoring::name() << ", gaps " << scoring.gap_open() << "/"
+              << scoring.gap_extend() << "), " << description
+              << ", " << bits << "-bit lanes: score " << striped.value
+              << " at (" << striped.i << "," << striped.j << "), "
+              << (valid ? "passed" : "FAILED") << "\n";
+
+    return valid;
+}
+
+template <typename Scoring>
+std::string random_sequence(
+    boost::random::mt19937& rng
+  , boost::uint32_t length
+    )
+{
+    std::string const chars(Scoring::alphabet());
+
+    boost::random::uniform_int_distribution<boost::uint32_t>
+        index_dist(0, chars.size() - 1);
+
+    std::string s;
+
+    for (boost::uint32_t x = 0; x < length; ++x)
+        s += chars[index_dist(rng)];
+
+    return s;
+}
+
+template <typename Scoring>
+bool validate_sw(
+    boost::random::mt19937& rng
+  , Scoring const& scoring
+  , boost::uint32_t a_length
+  , boost::uint32_t b_length
+    )
+{
+    std::string const a = random_sequence<Scoring>(rng, a_length);
+    std::string const b = random_sequence<Scoring>(rng, b_length);
+
+    std::ostringstream description;
+    description << "lengths " << a_length << " x " << b_length;
+
+    return validate_sw(a, b, scoring, description.str());
+}
+
+// Aligns a random sequence with a copy of itself, which has a high score.
+template <typename Scoring>
+bool validate_self_sw(
+    boost::random::mt19937& rng
+  , Scoring const& scoring
+  , boost::uint32_t length
+    )
+{
+    std::string const a = random_sequence<Scoring>(rng, length);
+
+    std::ostringstream description;
+    description << "self-alignment of length " << length;
+
+    return validate_sw(a, a, scoring, description.str());
+}
+
+template <typename Scoring>
+void benchmark_all(
+    boost::program_options::variables_map& vm
+  , boost::random::mt19937& rng
+  , boost::uint32_t seed
+  , std::vector<boost::uint32_t> const& lengths
+  , std::vector<boost::uint32_t> const& grain_sizes
+  , boost::uint32_t iterations
+  , Scoring const& scoring
+    )
+{
+    // Print out header rows.
+    if (!vm.count("no-header"))
+        std::cout
+            << "HPX Striped SMP Smith-Waterman Performance ("
+            << Scoring::name() << ", gaps " << scoring.gap_open() << "/"
+            << scoring.gap_extend() << ")\n"
+            << "Seed,OS-Threads,Sequence Length,Grain Size,Iterations,"
+               "Total Walltime (s)\n";
+
+    for (boost::uint32_t x = 0; x < lengths.size(); ++x)
+        benchmark_sw(rng, seed, lengths[x], grain_sizes[x], scoring
+                   , iterations);
+}
+
+template <typename Iterator>
+bool read_list(Iterator first, Iterator last, std::vector<boost::uint32_t>& v)
+{
+    using boost::spirit::qi::uint_parser;
+    using boost::spirit::qi::phrase_parse;
+    using boost::spirit::qi::_1;
+    using boost::spirit::ascii::space;
+
+    uint_parser<boost::uint32_t> size_t_;
+
+    bool r = phrase_parse(first, last, size_t_ % ',', space, v);
+
+    if (first != last)
+        return false;
+
+    return r;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    ///////////////////////////////////////////////////////////////////////
+    // Handle commandline options.
+
+    // Initialize the PRNG seed.
+    boost::uint32_t seed = vm["seed"].as<boost::uint32_t>();
+
+    if (!seed)
+        seed = boost::uint32_t(std::time(0));
+
+    boost::uint32_t iterations = vm["iterations"].as<boost::uint32_t>();
+
+    // Parse lengths.
+    std::string raw_lengths = vm["lengths"].as<std::string>();
+
+    std::vector<boost::uint32_t> lengths;
+
+    if (!read_list(raw_lengths.begin(), raw_lengths.end(), lengths))
+        throw std::invalid_argument("--lengths argument not be parsed\n");
+
+    // Parse grain sizes.
+    std::string raw_grain_sizes = vm["grain-sizes"].as<std::string>();
+
+    std::vector<boost::uint32_t> grain_sizes;
+
+    if (!read_list(raw_grain_sizes.begin(), raw_grain_sizes.end(), grain_sizes))
+        throw std::invalid_argument("--grain-sizes could not be parsed\n");
+
+    if (grain_sizes.size() != lengths.size())
+        throw std::invalid_argument(
+            "--grain-sizes must have as many elements as --lengths\n");
+
+    if (std::count(grain_sizes.begin(), grain_sizes.end(), 0u))
+        throw std::invalid_argument("--grain-sizes must be greater than 0\n");
+
+    // Select the scoring scheme. DNA uses linear gaps unless a gap penalty is
+    // given; the amino acid tables always use affine gaps.
+    std::string const raw_scoring = vm["scoring"].as<std::string>();
+
+    if (  raw_scoring != "dna" && raw_scoring != "blosum62"
+       && raw_scoring != "pam250")
+        throw std::invalid_argument(
+            "--scoring must be dna, blosum62 or pam250\n");
+
+    boost::int32_t const gap_open = vm["gap-open"].as<boost::int32_t>();
+    boost::int32_t const gap_extend = vm["gap-extend"].as<boost::int32_t>();
+
+    if (gap_extend <= 0 || gap_open < gap_extend)
+        throw std::invalid_argument(
+            "--gap-extend must be positive, and no greater than --gap-open\n");
+
+    bool const affine_gaps = !vm["gap-open"].defaulted()
+                          || !vm["gap-extend"].defaulted();
+
+    boost::random::mt19937 rng(seed);
+
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Validate implementation.
+        if (vm.count("validate"))
+        {
+            using scoring::affine;
+            using scoring::linear_dna;
+
+            bool valid = true;
+
+            valid = validate_sw("AGCACACA", "ACACACTA", linear_dna()
+                              , "example") && valid;
+
+            valid = validate_sw(rng, linear_dna(), 1, 1) && valid;
+            valid = validate_sw(rng, linear_dna(), 7, 40) && valid;
+            valid = validate_sw(rng, linear_dna(), 64, 64) && valid;
+            valid = validate_sw(rng, linear_dna(), 255, 100) && valid;
+            valid = validate_sw(rng, linear_dna(), 600, 601) && valid;
+
+            // These overflow the 8-bit and then the 16-bit lanes.
+            valid = validate_self_sw(rng, linear_dna(), 200) && valid;
+            valid = validate_self_sw(rng, linear_dna(), 17000) && valid;
+
+            // Affine gaps, and amino acids.
+            affine<scoring::dna> const dna(3, 1);
+            affine<scoring::blosum62> const blosum62(11, 1);
+            affine<scoring::pam250> const pam250(10, 2);
+
+            valid = validate_sw(rng, dna, 300, 200) && valid;
+            valid = validate_self_sw(rng, dna, 150) && valid;
+            valid = validate_sw(rng, blosum62, 90, 40) && valid;
+            valid = validate_sw(rng, blosum62, 400, 300) && valid;
+            valid = validate_self_sw(rng, blosum62, 100) && valid;
+            valid = validate_sw(rng, pam250, 257, 129) && valid;
+            valid = validate_self_sw(rng, pam250, 60) && valid;
+
+            if (!valid)
+                throw std::runtime_error("striped kernel validation failed\n");
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Benchmark implementation.
+        using scoring::affine;
+
+        if (raw_scoring == "dna" && !affine_gaps)
+            benchmark_all(vm, rng, seed, lengths, grain_sizes, iterations
+                        , scoring::linear_dna());
+        else if (raw_scoring == "dna")
+            benchmark_all(vm, rng, seed, lengths, grain_sizes, iterations
+                        , affine<scoring::dna>(gap_open, gap_extend));
+        else if (raw_scoring == "blosum62")
+            benchmark_all(vm, rng, seed, lengths, grain_sizes, iterations
+                        , affine<scoring::blosum62>(gap_open, gap_extend));
+        else
+            benchmark_all(vm, rng, seed, lengths, grain_sizes, iterations
+                        , affine<scoring::pam250>(gap_open, gap_extend));
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char** argv)
+{
+    using namespace boost::program_options;
+
+    variables_map vm;
+
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "lengths"
+        , value<std::string>()->default_value("32,64,128,256")
+        , "sequence lengths to use (comma seperated list, maximum length "
+          " currently allowed is 2^32)")
+
+        ( "grain-sizes"
+        , value<std::string>()->default_value("4,4,4,4")
+        , "number of alignments per task (comma seperated list, must have "
+          "the same number of elements as --lengths)")
+
+        ( "scoring"
+        , value<std::string>()->default_value("dna")
+        , "scoring scheme to use (dna: +2 for a match, -1 for a mismatch, "
+          "blosum62 or pam250)")
+
+        ( "gap-open"
+        , value<boost::int32_t>()->default_value(11)
+        , "penalty for the first character of a gap (for dna, gaps cost 1 "
+          "per character unless this or --gap-extend is given)")
+
+        ( "gap-extend"
+        , value<boost::int32_t>()->default_value(1)
+        , "penalty for each further character of a gap")
+
+        ( "validate"
+        , "check the striped kernel against a plain implementation, with "
+          "each scoring scheme, before performing benchmarks")
+
+        ( "no-header"
+        , "do not print out the CSV header for the benchmark data")
+
+        ( "iterations"
+        , value<boost::uint32_t>()->default_value(1024)
+        , "number of tests to perform for each sequence length")
+
+        ( "seed"
+        , value<boost::uint32_t>()->default_value(0)
+        , "seed for the pseudo random number generator (if 0, a seed is "
+          "choosen based on the current system time)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
+
@@ -0,0 +1,57 @@
+//  Copyright (c) 2012 Stephanie Crillo and Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPXLA_1B7D3E52_9A64_4C0F_8E21_D56F0A3C97B8)
+#define HPXLA_1B7D3E52_9A64_4C0F_8E21_D56F0A3C97B8
+
+#include <boost/cstdint.hpp>
+
+/// The best score of an alignment, and the cell of H that holds it (H has an
+/// extra row and column of zeros in front, so the first characters of the
+/// sequences are in row and column 1).
+struct winner
+{
+    winner() : value(0), i(0), j(0) {}
+
+    winner(boost::int64_t value_, boost::uint64_t i_, boost::uint64_t j_)
+      : value(value_), i(i_), j(j_)
+    {}
+
+    boost::int64_t value;
+    boost::uint64_t i;
+    boost::uint64_t j;
+
+    template <
+        typename Archive
+    >
+    void serialize(
+        Archive& ar
+      , unsigned int
+        )
+    {
+        ar & value & i & j;
+    }
+};
+
+/// Returns true if \a x beats \a y. Ties go to the smallest (i, j), so every
+/// implementation finds the same cell, however it splits up the matrix and
+/// in whatever order its pieces finish. \a Winner is winner, or a type
+/// derived from it.
+template <
+    typename Winner
+>
+inline bool better(
+    Winner const& x
+  , Winner const& y
+    )
+{
+    if (x.value != y.value)
+        return x.value > y.value;
+    if (x.i != y.i)
+        return x.i < y.i;
+    return x.j < y.j;
+}
+
+#endif // HPXLA_1B7D3E52_9A64_4C0F_8E21_D56F0A3C97B8
@@ -14,5 +14,24 @@
     #define HPXLA_BACKEND_ATLAS
 #endif
 
+/// Maximum number of rows and columns of each tile of C that the local GEMM
+/// hands to a separate HPX task.
+#if !defined(HPXLA_GEMM_TILE_SIZE)
+    #define HPXLA_GEMM_TILE_SIZE 256
+#endif
+
+/// Maximum width of the panels of A and B that distributed_gemm sends in one
+/// step. Narrower panels let more communication overlap with computation.
+#if !defined(HPXLA_SUMMA_PANEL_WIDTH)
+    #define HPXLA_SUMMA_PANEL_WIDTH 256
+#endif
+
+/// Distance in bytes at which addresses map to the same sets of the L1 data
+/// cache (its size divided by its associativity). The padded indexing
+/// policies keep their leading dimensions off of multiples of it.
+#if !defined(HPXLA_CRITICAL_STRIDE)
+    #define HPXLA_CRITICAL_STRIDE 4096
+#endif
+
 #endif // HPX_AAA62AA2_6ECE_414A_B0F4_8C9E0A610B30
 
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_3AF8A38B_3735_4D1B_8773_63A092D973D1)
+#define HPXLA_3AF8A38B_3735_4D1B_8773_63A092D973D1
+
+#include <hpxla/config.hpp>
+#include <hpxla/distributed_matrix.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/move/move.hpp>
+
+namespace hpxla
+{
+
+namespace detail
+{
+
+/// Returns the boundaries of the panels along the inner dimension of A * B:
+/// every block boundary of the columns of A and of the rows of B, with
+/// panels no wider than HPXLA_SUMMA_PANEL_WIDTH.
+template <
+    typename T
+  , typename Policy
+>
+inline std::vector<boost::uint64_t> summa_boundaries(
+    distributed_matrix<T, Policy> const& A
+  , distributed_matrix<T, Policy> const& B
+    )
+{
+    std::vector<boost::uint64_t> cuts;
+
+    for (boost::uint64_t j = 0; j < A.grid().cols; ++j)
+        cuts.push_back(A.block_offsets(0, j).cols);
+
+    for (boost::uint64_t i = 0; i < B.grid().rows; ++i)
+        cuts.push_back(B.block_offsets(i, 0).rows);
+
+    cuts.push_back(A.columns());
+
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+    std::vector<boost::uint64_t> boundaries(1, 0);
+
+    for (std::size_t c = 1; c < cuts.size(); ++c)
+    {
+        for ( boost::uint64_t k = cuts[c - 1] + HPXLA_SUMMA_PANEL_WIDTH
+            ; k < cuts[c]
+            ; k += HPXLA_SUMMA_PANEL_WIDTH)
+            boundaries.push_back(k);
+
+        boundaries.push_back(cuts[c]);
+    }
+
+    return boundaries;
+}
+
+inline void summa_wait(
+    std::vector<hpx::lcos::future<void> > blocks
+    )
+{
+    // Propagate any exceptions.
+    for (std::size_t b = 0; b < blocks.size(); ++b)
+        blocks[b].get();
+}
+
+}
+
+/// Computes C = alpha * A * B + beta * C with SUMMA. The rows of C must be
+/// split into blocks in the same way as the rows of A, and its columns in the
+/// same way as the columns of B; this holds, for instance, when all three
+/// matrices use a block_cyclic_distribution with the same block size.
+///
+/// Each block of C is computed by the locality which owns it. For each
+/// panel, it pulls the matching piece of the panel of A from its process row
+/// and of the panel of B from its process column, fetching the next panel
+/// while it multiplies the current one. The blocks of C on one locality which
+/// need the same piece at the same time share a single fetch of it. No
+/// matrix is ever gathered to a single locality.
+template <
+    typename T
+  , typename Policy
+>
+inline hpx::lcos::future<void> distributed_gemm_async(
+    distributed_matrix<T, Policy> const& A
+  , distributed_matrix<T, Policy> const& B
+  , distributed_matrix<T, Policy> const& C
+  , T alpha = T(1)
+  , T beta = T(0)
+    )
+{
+    BOOST_ASSERT(A.columns() == B.rows());
+    BOOST_ASSERT(A.rows() == C.rows());
+    BOOST_ASSERT(B.columns() == C.columns());
+
+    BOOST_ASSERT(A.grid().rows == C.grid().rows);
+    BOOST_ASSERT(B.grid().cols == C.grid().cols);
+
+    std::vector<boost::uint64_t> const k = detail::summa_boundaries(A, B);
+
+    std::vector<hpx::lcos::future<void> > blocks;
+    blocks.reserve(C.grid().rows * C.grid().cols);
+
+    for (boost::uint64_t j = 0; j < C.grid().cols; ++j)
+        for (boost::uint64_t i = 0; i < C.grid().rows; ++i)
+        {
+            matrix_bounds const c_offsets = C.block_offsets(i, j);
+            matrix_bounds const c_extents = C.block_extents(i, j);
+
+            BOOST_ASSERT(A.block_offsets(i, 0).rows == c_offsets.rows);
+            BOOST_ASSERT(A.block_extents(i, 0).rows == c_extents.rows);
+            BOOST_ASSERT(B.block_offsets(0, j).cols == c_offsets.cols);
+            BOOST_ASSERT(B.block_extents(0, j).cols == c_extents.cols);
+
+            std::vector<server::summa_panel> panels;
+            panels.reserve(k.size() - 1);
+
+            for (std::size_t p = 0; p + 1 < k.size(); ++p)
+            {
+                server::summa_panel panel;
+
+                // The piece of the panel of A in block row i.
+                matrix_bounds const a = A.owner(c_offsets.rows, k[p]);
+                boost::uint64_t const a_col
+                    = A.block_offsets(a.rows, a.cols).cols;
+
+                panel.a = A.gids()(a.rows, a.cols);
+                panel.a_lower = matrix_bounds(0, k[p] - a_col);
+                panel.a_upper = matrix_bounds(c_extents.rows, k[p + 1] - a_col);
+
+                // The piece of the panel of B in block column j.
+                matrix_bounds const b = B.owner(k[p], c_offsets.cols);
+                boost::uint64_t const b_row
+                    = B.block_offsets(b.rows, b.cols).rows;
+
+                panel.b = B.gids()(b.rows, b.cols);
+                panel.b_lower = matrix_bounds(k[p] - b_row, 0);
+                panel.b_upper = matrix_bounds(k[p + 1] - b_row, c_extents.cols);
+
+                panels.push_back(panel);
+            }
+
+            blocks.push_back(C.block(i, j).summa_async(panels, alpha, beta));
+        }
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::summa_wait, boost::move(blocks));
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline void distributed_gemm(
+    distributed_matrix<T, Policy> const& A
+  , distributed_matrix<T, Policy> const& B
+  , distributed_matrix<T, Policy> const& C
+  , T alpha = T(1)
+  , T beta = T(0)
+    )
+{
+    distributed_gemm_async(A, B, C, alpha, beta).get();
+}
+
+}
+
+#endif // HPXLA_3AF8A38B_3735_4D1B_8773_63A092D973D1
+
@@ -0,0 +1,438 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_78B33269_3D3C_4230_8C02_9092737241D0)
+#define HPXLA_78B33269_3D3C_4230_8C02_9092737241D0
+
+#include <hpxla/distributed_submatrix.hpp>
+#include <hpxla/policies.hpp>
+
+#include <hpx/exception.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/components.hpp>
+
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace hpxla
+{
+
+/// A matrix which is split into a grid of distributed_submatrix components.
+/// If the policy has a distribution policy (e.g. block_cyclic_distribution),
+/// it chooses the grid and the locality of each block. Otherwise, the grid is
+/// chosen by the partitioning policy (prime_factor_partitioning if none is
+/// given), and the blocks are placed round-robin. The client keeps the GIDs of
+/// all of the blocks, so element accesses are sent straight to the block that
+/// owns them.
+template <
+    typename T
+  , typename Policy = distributed_matrix_policy<>
+>
+struct distributed_matrix
+{
+    typedef Policy policy_type;
+    typedef typename Policy::local_policy_type local_policy_type;
+    typedef typename Policy::indexing_policy_type indexing_policy_type;
+    typedef typename Policy::distribution_policy_type distribution_policy_type;
+    typedef typename Policy::allocation_policy_type allocation_policy_type;
+    typedef typename Policy::copy_policy_type copy_policy_type;
+
+    typedef typename boost::mpl::if_<
+        boost::is_same<
+            typename Policy::partitioning_policy_type
+          , hpx::util::unused_type
+        >
+      , policy::prime_factor_partitioning<local_policy_type>
+      , typename Policy::partitioning_policy_type
+    >::type partitioning_policy_type;
+
+    // The blocks only need the indexing, allocation and copy policies, and
+    // the components are registered without the others.
+    typedef distributed_submatrix<
+        T
+      , distributed_matrix_policy<
+            indexing_policy_type
+          , hpx::util::unused_type
+          , hpx::util::unused_type
+          , allocation_policy_type
+          , copy_policy_type
+        >
+    > submatrix_type;
+
+    typedef typename submatrix_type::server_type submatrix_server_type;
+
+    typedef typename submatrix_type::value_type value_type;
+    typedef typename submatrix_type::const_reference const_reference;
+    typedef typename submatrix_type::size_type size_type;
+
+    typedef typename submatrix_type::evaluate_function_type
+        evaluate_function_type;
+    typedef typename submatrix_type::combine_function_type
+        combine_function_type;
+
+    typedef typename partitioning_policy_type::offset_matrix offset_matrix;
+    typedef typename partitioning_policy_type::gid_matrix gid_matrix;
+
+  private:
+    matrix_bounds bounds_;
+    matrix_bounds grid_;
+    offset_matrix offsets_;
+    gid_matrix gids_;
+    distribution_policy_type distribution_;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Layout without a distribution policy: the grid comes from the
+    // partitioning policy, and the blocks are dealt out to the localities
+    // round-robin.
+    void create_layout(
+        boost::uint64_t partitions
+      , hpx::util::unused_type
+        )
+    {
+        grid_ = partitioning_policy_type::grid_dimensions(partitions, bounds_);
+        offsets_ = partitioning_policy_type::create_offsets
+            (partitions, bounds_);
+    }
+
+    boost::uint64_t locality_index(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , std::size_t localities
+      , hpx::util::unused_type
+        ) const
+    {
+        return (j * grid_.rows + i) % localities;
+    }
+
+    // Any number of localities will do.
+    void check_localities(
+        std::size_t
+      , hpx::util::unused_type
+        ) const
+    {}
+
+    matrix_bounds block_offsets(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , hpx::util::unused_type
+        ) const
+    {
+        boost::uint64_t const p = j * grid_.rows + i;
+        return matrix_bounds(offsets_(p, 0), offsets_(p, 1));
+    }
+
+    matrix_bounds block_extents(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , hpx::util::unused_type
+        ) const
+    {
+        return partitioning_policy_type::submatrix_extents
+            (i, j, grid_, bounds_);
+    }
+
+    matrix_bounds owner(
+        size_type row
+      , size_type col
+      , hpx::util::unused_type
+        ) const
+    {
+        return partitioning_policy_type::submatrix_index
+            (row, col, grid_, bounds_);
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Block-cyclic layout.
+    void create_layout(
+        boost::uint64_t
+      , policy::block_cyclic_distribution const& d
+        )
+    {
+        grid_ = d.grid_dimensions(bounds_);
+    }
+
+    // Each process of the process grid needs a locality of its own.
+    void check_localities(
+        std::size_t localities
+      , policy::block_cyclic_distribution const& d
+        ) const
+    {
+        if (localities < d.processes())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter
+              , "distributed_matrix::create"
+              , "the process grid of the block_cyclic_distribution has more "
+                "processes than there are localities");
+        }
+    }
+
+    boost::uint64_t locality_index(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , std::size_t localities
+      , policy::block_cyclic_distribution const& d
+        ) const
+    {
+        BOOST_ASSERT(d.processes() <= localities);
+        return d.process_of(i, j);
+    }
+
+    matrix_bounds block_offsets(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , policy::block_cyclic_distribution const& d
+        ) const
+    {
+        return d.block_offsets(i, j);
+    }
+
+    matrix_bounds block_extents(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , policy::block_cyclic_distribution const& d
+        ) const
+    {
+        return d.block_extents(i, j, bounds_);
+    }
+
+    matrix_bounds owner(
+        size_type row
+      , size_type col
+      , policy::block_cyclic_distribution const& d
+        ) const
+    {
+        return d.block_index(row, col);
+    }
+    // }}}
+
+    void create(
+        const_reference init
+      , boost::uint64_t partitions
+      , std::vector<hpx::naming::id_type> localities
+        )
+    {
+        if (localities.empty())
+            localities = hpx::find_all_localities();
+
+        if (0 == partitions)
+            partitions = localities.size();
+
+        create_layout(partitions, distribution_);
+        check_localities(localities.size(), distribution_);
+
+        // Every block must hold at least one element.
+        BOOST_ASSERT(grid_.rows <= bounds_.rows);
+        BOOST_ASSERT(grid_.cols <= bounds_.cols);
+
+        gids_ = gid_matrix(grid_.rows, grid_.cols);
+
+        // Create all of the blocks at once ...
+        std::vector<hpx::lcos::future<hpx::naming::id_type> > created;
+        created.reserve(grid_.rows * grid_.cols);
+
+        for (boost::uint64_t j = 0; j < grid_.cols; ++j)
+            for (boost::uint64_t i = 0; i < grid_.rows; ++i)
+                created.push_back(hpx::components::new_<submatrix_server_type>(
+                    localities[locality_index(i, j, localities.size()
+                                            , distribution_)]));
+
+        // ... and initialize each one as soon as it exists.
+        std::vector<hpx::lcos::future<void> > initialized;
+        initialized.reserve(created.size());
+
+        for (boost::uint64_t j = 0; j < grid_.cols; ++j)
+            for (boost::uint64_t i = 0; i < grid_.rows; ++i)
+            {
+                gids_(i, j) = created[j * grid_.rows + i].get();
+
+                matrix_bounds const extents = block_extents(i, j);
+
+                initialized.push_back(submatrix_type(gids_(i, j))
+                    .initialize_async(extents.rows, extents.cols, init));
+            }
+
+        for (std::size_t p = 0; p < initialized.size(); ++p)
+            initialized[p].get();
+    }
+
+  public:
+    distributed_matrix()
+      : bounds_(0, 0)
+      , grid_(0, 0)
+    {}
+
+    /// Creates a \a rows x \a cols matrix, split into \a partitions blocks (by
+    /// default, one per locality) which are placed on \a localities (by
+    /// default, all localities). Each element is initialized to \a init.
+    ///
+    /// With a distribution policy, the blocks are chosen and placed by the
+    /// default-constructed policy instead, and \a partitions is ignored; see
+    /// the other constructor for the error it reports.
+    distributed_matrix(
+        size_type rows
+      , size_type cols
+      , const_reference init = value_type()
+      , boost::uint64_t partitions = 0
+      , std::vector<hpx::naming::id_type> const& localities
+            = std::vector<hpx::naming::id_type>()
+        )
+      : bounds_(rows, cols)
+      , grid_(0, 0)
+    {
+        create(init, partitions, localities);
+    }
+
+    /// Creates a \a rows x \a cols matrix whose blocks are chosen and placed
+    /// on \a localities (by default, all localities) by \a distribution. Each
+    /// element is initialized to \a init.
+    ///
+    /// Throws bad_parameter if the process grid of \a distribution has more
+    /// processes than there are localities.
+    distributed_matrix(
+        size_type rows
+      , size_type cols
+      , distribution_policy_type const& distribution
+      , const_reference init = value_type()
+      , std::vector<hpx::naming::id_type> const& localities
+            = std::vector<hpx::naming::id_type>()
+        )
+      : bounds_(rows, cols)
+      , grid_(0, 0)
+      , distribution_(distribution)
+    {
+        create(init, 0, localities);
+    }
+
+    size_type rows() const
+    {
+        return bounds_.rows;
+    }
+
+    size_type columns() const
+    {
+        return bounds_.cols;
+    }
+
+    /// Returns the number of blocks in each row and column of the grid.
+    matrix_bounds grid() const
+    {
+        return grid_;
+    }
+
+    /// Returns the GIDs of the blocks, laid out as the grid.
+    gid_matrix const& gids() const
+    {
+        return gids_;
+    }
+
+    submatrix_type block(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        return submatrix_type(gids_(i, j));
+    }
+
+    distribution_policy_type const& distribution() const
+    {
+        return distribution_;
+    }
+
+    /// Returns the position of the first element of the block at (\a i, \a j).
+    matrix_bounds block_offsets(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        return block_offsets(i, j, distribution_);
+    }
+
+    matrix_bounds block_extents(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        return block_extents(i, j, distribution_);
+    }
+
+    /// Returns the position in the grid of the block containing element
+    /// (\a row, \a col).
+    matrix_bounds owner(
+        size_type row
+      , size_type col
+        ) const
+    {
+        BOOST_ASSERT(row < bounds_.rows);
+        BOOST_ASSERT(col < bounds_.cols);
+
+        return owner(row, col, distribution_);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // lookup
+
+    hpx::lcos::future<value_type> lookup_async(
+        size_type row
+      , size_type col
+        ) const
+    {
+        matrix_bounds const b = owner(row, col);
+        matrix_bounds const o = block_offsets(b.rows, b.cols);
+
+        return block(b.rows, b.cols).lookup_async(row - o.rows, col - o.cols);
+    }
+
+    value_type lookup_sync(
+        size_type row
+      , size_type col
+        ) const
+    {
+        return lookup_async(row, col).get();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // reduce
+
+    /// Applies \a map to every block where it lives, and folds the results
+    /// together with \a combine, which must be associative. The partial
+    /// results are combined in a tree across the blocks, so only the final
+    /// value is sent back to the caller.
+    hpx::lcos::future<value_type> reduce_async(
+        evaluate_function_type const& map
+      , combine_function_type const& combine
+        ) const
+    {
+        BOOST_ASSERT(grid_.rows && grid_.cols);
+
+        std::vector<hpx::naming::id_type> children;
+        children.reserve(grid_.rows * grid_.cols - 1);
+
+        for (boost::uint64_t j = 0; j < grid_.cols; ++j)
+            for (boost::uint64_t i = 0; i < grid_.rows; ++i)
+                if (i || j)
+                    children.push_back(gids_(i, j));
+
+        return block(0, 0).reduce_async(map, combine, children);
+    }
+
+    value_type reduce_sync(
+        evaluate_function_type const& map
+      , combine_function_type const& combine
+        ) const
+    {
+        return reduce_async(map, combine).get();
+    }
+};
+
+}
+
+#endif // HPXLA_78B33269_3D3C_4230_8C02_9092737241D0
+
@@ -31,6 +31,12 @@ struct distributed_submatrix
     typedef server::distributed_submatrix<T, Policy> server_type;
 
     typedef typename server_type::local_matrix_type local_matrix_type;
+    typedef storage_buffer<local_matrix_type> storage_buffer_type;
+
+    typedef typename server_type::apply_function_type apply_function_type;
+    typedef typename server_type::evaluate_function_type
+        evaluate_function_type;
+    typedef typename server_type::combine_function_type combine_function_type;
 
     typedef typename server_type::value_type value_type;
     typedef typename server_type::reference reference;
@@ -46,6 +52,15 @@ struct distributed_submatrix
     typedef typename server_type::distribution_policy_type
         distribution_policy_type;
     typedef typename server_type::allocation_policy_type allocation_policy_type;
+
+    distributed_submatrix() {}
+
+    distributed_submatrix(
+        hpx::naming::id_type const& gid
+        )
+      : base_type(gid)
+    {}
+
     distributed_submatrix(
         hpx::future<hpx::naming::id_type> && gid
         )
@@ -96,15 +111,29 @@ struct distributed_submatrix
 
     ///////////////////////////////////////////////////////////////////////////
     // initialize_from_matrix
+    //
+    // Whole matrices (see local_matrix::whole()) are sent as a storage_buffer,
+    // which the component adopts as its storage. The storage is only copied
+    // on this end if m could be written to while the action is in flight.
 
     void initialize_non_blocking(
         local_matrix_type const& m
       , matrix_offsets offsets = matrix_offsets(0, 0) 
         )
     {
+        BOOST_ASSERT(this->get_id());
+
+        if (m.whole())
+        {
+            typedef typename server_type::initialize_from_storage_action
+                action_type;
+            hpx::apply<action_type>(this->get_id()
+              , storage_buffer_type(m, storage_buffer_type::copy), offsets);
+            return;
+        }
+
         typedef typename server_type::initialize_from_matrix_action
             action_type;
-        BOOST_ASSERT(this->get_id());
         hpx::apply<action_type>(this->get_id(), m, offsets);
     }
 
@@ -113,10 +142,19 @@ struct distributed_submatrix
       , matrix_offsets offsets = matrix_offsets(0, 0) 
         )
     {
+        BOOST_ASSERT(this->get_id());
+
+        if (m.whole())
+        {
+            typedef typename server_type::initialize_from_storage_action
+                action_type;
+            hpx::apply<action_type>(this->get_id()
+              , storage_buffer_type(boost::move(m)), offsets);
+            return;
+        }
+
         typedef typename server_type::initialize_from_matrix_action
             action_type;
-        BOOST_ASSERT(this->get_id());
-        // Note, boost::move needed here or no?
         hpx::apply<action_type>(this->get_id(), boost::move(m), offsets);
     }
 
@@ -125,10 +163,22 @@ struct distributed_submatrix
       , matrix_offsets offsets = matrix_offsets(0, 0) 
         )
     {
+        BOOST_ASSERT(this->get_id());
+
+        // m can't change until the action returns, so it isn't copied.
+        if (m.whole())
+        {
+            typedef typename server_type::initialize_from_storage_action
+                action_type;
+            hpx::async<action_type>(this->get_id()
+              , storage_buffer_type(m, storage_buffer_type::reference)
+              , offsets).get();
+            return;
+        }
+
         typedef typename server_type::initialize_from_matrix_action
             action_type;
-        BOOST_ASSERT(this->get_id());
-        hpx::async<action_type>(this->get_id(), boost::move(m), offsets).get();
+        hpx::async<action_type>(this->get_id(), m, offsets).get();
     }
 
     void initialize_sync(
@@ -136,11 +186,7 @@ struct distributed_submatrix
       , matrix_offsets offsets = matrix_offsets(0, 0) 
         )
     {
-        typedef typename server_type::initialize_from_matrix_action
-            action_type;
-        BOOST_ASSERT(this->get_id());
-        // Note, boost::move needed here or no?
-        hpx::async<action_type>(this->get_id(), boost::move(m), offsets).get();
+        initialize_async(boost::move(m), offsets).get();
     }
 
     hpx::lcos::future<void> initialize_async(
@@ -148,9 +194,18 @@ struct distributed_submatrix
       , matrix_offsets offsets = matrix_offsets(0, 0) 
         )
     {
+        BOOST_ASSERT(this->get_id());
+
+        if (m.whole())
+        {
+            typedef typename server_type::initialize_from_storage_action
+                action_type;
+            return hpx::async<action_type>(this->get_id()
+              , storage_buffer_type(m, storage_buffer_type::copy), offsets);
+        }
+
         typedef typename server_type::initialize_from_matrix_action
             action_type;
-        BOOST_ASSERT(this->get_id());
         return hpx::async<action_type>(this->get_id(), m, offsets);
     }
 
@@ -159,11 +214,20 @@ struct distributed_submatrix
       , matrix_offsets offsets = matrix_offsets(0, 0) 
         )
     {
+        BOOST_ASSERT(this->get_id());
+
+        if (m.whole())
+        {
+            typedef typename server_type::initialize_from_storage_action
+                action_type;
+            return hpx::async<action_type>(this->get_id()
+              , storage_buffer_type(boost::move(m)), offsets);
+        }
+
         typedef typename server_type::initialize_from_matrix_action
             action_type;
-        BOOST_ASSERT(this->get_id());
-        // REVIEW: Do I need to use boost::move here?
-        return hpx::async<action_type>(this->get_id(), boost::move(m), offsets);
+        return hpx::async<action_type>(this->get_id(), boost::move(m)
+                                     , offsets);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -176,7 +240,7 @@ struct distributed_submatrix
     {
         typedef typename server_type::lookup_action action_type;
         BOOST_ASSERT(this->get_id());
-        hpx::async<action_type>(this->get_id(), rows, cols).get();
+        return hpx::async<action_type>(this->get_id(), rows, cols).get();
     }
 
     hpx::lcos::future<value_type> lookup_async(
@@ -188,6 +252,194 @@ struct distributed_submatrix
         BOOST_ASSERT(this->get_id());
         return hpx::async<action_type>(this->get_id(), rows, cols);
     }
+
+    std::vector<value_type> lookup_sync(
+        std::vector<matrix_bounds> const& coords
+        )
+    {
+        typedef typename server_type::lookup_batch_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), coords).get();
+    }
+
+    /// Fetches the elements at each of \a coords with a single action.
+    hpx::lcos::future<std::vector<value_type> > lookup_async(
+        std::vector<matrix_bounds> const& coords
+        )
+    {
+        typedef typename server_type::lookup_batch_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), coords);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // get_region
+
+    local_matrix_type get_region_sync(
+        matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename server_type::get_region_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), lower, upper).get();
+    }
+
+    /// Fetches a copy of the elements in [\a lower, \a upper) with a single
+    /// action.
+    hpx::lcos::future<local_matrix_type> get_region_async(
+        matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename server_type::get_region_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), lower, upper);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // put_region
+
+    void put_region_non_blocking(
+        matrix_bounds lower
+      , local_matrix_type const& m
+        )
+    {
+        typedef typename server_type::put_region_action action_type;
+        BOOST_ASSERT(this->get_id());
+        hpx::apply<action_type>(this->get_id(), lower, m);
+    }
+
+    void put_region_sync(
+        matrix_bounds lower
+      , local_matrix_type const& m
+        )
+    {
+        typedef typename server_type::put_region_action action_type;
+        BOOST_ASSERT(this->get_id());
+        hpx::async<action_type>(this->get_id(), lower, m).get();
+    }
+
+    /// Writes \a m into the block, starting at \a lower, with a single
+    /// action.
+    hpx::lcos::future<void> put_region_async(
+        matrix_bounds lower
+      , local_matrix_type const& m
+        )
+    {
+        typedef typename server_type::put_region_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), lower, m);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // apply
+
+    void apply_non_blocking(
+        apply_function_type const& f
+      , matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename server_type::apply_action action_type;
+        BOOST_ASSERT(this->get_id());
+        hpx::apply<action_type>(this->get_id(), f, lower, upper);
+    }
+
+    void apply_sync(
+        apply_function_type const& f
+      , matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename server_type::apply_action action_type;
+        BOOST_ASSERT(this->get_id());
+        hpx::async<action_type>(this->get_id(), f, lower, upper).get();
+    }
+
+    hpx::lcos::future<void> apply_async(
+        apply_function_type const& f
+      , matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename server_type::apply_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), f, lower, upper);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // evaluate
+
+    value_type evaluate_sync(
+        evaluate_function_type const& f
+      , matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename server_type::evaluate_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), f, lower, upper).get();
+    }
+
+    /// Runs \a f on the elements in [\a lower, \a upper) where the block
+    /// lives, and returns its result.
+    hpx::lcos::future<value_type> evaluate_async(
+        evaluate_function_type const& f
+      , matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename server_type::evaluate_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), f, lower, upper);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // reduce
+
+    value_type reduce_sync(
+        evaluate_function_type const& map
+      , combine_function_type const& combine
+      , std::vector<hpx::naming::id_type> const& children
+            = std::vector<hpx::naming::id_type>()
+        )
+    {
+        typedef typename server_type::reduce_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>
+            (this->get_id(), map, combine, children).get();
+    }
+
+    /// Reduces this block and the blocks in \a children with a tree rooted
+    /// at this block. See server::distributed_submatrix::reduce.
+    hpx::lcos::future<value_type> reduce_async(
+        evaluate_function_type const& map
+      , combine_function_type const& combine
+      , std::vector<hpx::naming::id_type> const& children
+            = std::vector<hpx::naming::id_type>()
+        )
+    {
+        typedef typename server_type::reduce_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), map, combine, children);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // summa
+
+    /// Computes one block of C for distributed_gemm. See
+    /// server::distributed_submatrix::summa.
+    hpx::lcos::future<void> summa_async(
+        std::vector<server::summa_panel> const& panels
+      , value_type alpha
+      , value_type beta
+        )
+    {
+        typedef typename server_type::summa_action action_type;
+        BOOST_ASSERT(this->get_id());
+        return hpx::async<action_type>(this->get_id(), panels, alpha, beta);
+    }
 };
 
 }
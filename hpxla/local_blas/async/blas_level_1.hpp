@@ -0,0 +1,614 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_66C9863F_0EC1_4CE6_A1E9_E164762B9898)
+#define HPXLA_66C9863F_0EC1_4CE6_A1E9_E164762B9898
+
+#include <hpxla/local_blas/blas_level_1.hpp>
+#include <hpxla/local_blas/async/operands.hpp>
+
+// ROTG and ROTMG have no asynchronous variants; they only operate on scalar
+// references.
+
+namespace hpxla { namespace blas { namespace async
+{
+
+namespace detail
+{
+
+template <
+    typename T
+  , typename Policy
+>
+inline typename real_type<T>::type asum(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+    )
+{
+    return ::hpxla::blas::asum(X.get());
+}
+
+template <
+    typename S
+  , typename T
+  , typename Policy
+>
+inline local_matrix_view<T, Policy> axpy(
+    S const& a
+  , hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+    )
+{
+    local_matrix_view<T, Policy> y = Y.get();
+    ::hpxla::blas::axpy(value(a), X.get(), y);
+    return y;
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline local_matrix_view<T, Policy> copy(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+    )
+{
+    local_matrix_view<T, Policy> y = Y.get();
+    ::hpxla::blas::copy(X.get(), y);
+    return y;
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline T dot(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+    )
+{
+    return ::hpxla::blas::dot(X.get(), Y.get());
+}
+
+template <
+    typename S
+  , typename Policy
+>
+inline float sdsdot(
+    hpx::shared_future<local_matrix_view<float, Policy> > X
+  , hpx::shared_future<local_matrix_view<float, Policy> > Y
+  , S const& sb
+    )
+{
+    return ::hpxla::blas::sdsdot(X.get(), Y.get(), value(sb));
+}
+
+template <
+    typename Policy
+>
+inline double dsdot(
+    hpx::shared_future<local_matrix_view<float, Policy> > X
+  , hpx::shared_future<local_matrix_view<float, Policy> > Y
+    )
+{
+    return ::hpxla::blas::dsdot(X.get(), Y.get());
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline T dotc(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+    )
+{
+    return ::hpxla::blas::dotc(X.get(), Y.get());
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline T dotu(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+    )
+{
+    return ::hpxla::blas::dotu(X.get(), Y.get());
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline typename real_type<T>::type nrm2(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+    )
+{
+    return ::hpxla::blas::nrm2(X.get());
+}
+
+template <
+    typename S0
+  , typename S1
+  , typename T
+  , typename Policy
+>
+inline void rot(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+  , S0 const& c
+  , S1 const& s
+    )
+{
+    local_matrix_view<T, Policy> x = X.get();
+    local_matrix_view<T, Policy> y = Y.get();
+    ::hpxla::blas::rot(x, y, value(c), value(s));
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline void rotm(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+  , hpx::shared_future<local_matrix_view<T, Policy> > param
+    )
+{
+    local_matrix_view<T, Policy> x = X.get();
+    local_matrix_view<T, Policy> y = Y.get();
+    ::hpxla::blas::rotm(x, y, param.get());
+}
+
+template <
+    typename S
+  , typename T
+  , typename Policy
+>
+inline local_matrix_view<T, Policy> scal(
+    S const& a
+  , hpx::shared_future<local_matrix_view<T, Policy> > X
+    )
+{
+    local_matrix_view<T, Policy> x = X.get();
+    ::hpxla::blas::scal(value(a), x);
+    return x;
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline void swap(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+    )
+{
+    local_matrix_view<T, Policy> x = X.get();
+    local_matrix_view<T, Policy> y = Y.get();
+    ::hpxla::blas::swap(x, y);
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline std::size_t iamax(
+    hpx::shared_future<local_matrix_view<T, Policy> > X
+    )
+{
+    return ::hpxla::blas::iamax(X.get());
+}
+
+}
+
+// Each routine below schedules the corresponding synchronous routine once all
+// of its operands are ready, and returns a future to its result. Matrix
+// operands may be local_matrix_view<>s, local_matrix<>s or futures of
+// local_matrix_view<>s; scalar operands may be values or futures. Routines
+// which modify a vector return a future to the modified vector, so that calls
+// can be chained. Operands must stay alive until the returned future is ready.
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ ASUM
+
+/// BLAS1: Computes the sum of magnitudes of the vector elements.
+template <
+    typename X
+>
+inline hpx::future<
+    typename detail::real_type<
+        typename detail::operand_view<X>::type::value_type
+    >::type
+>
+asum(
+    BOOST_FWD_REF(X) x
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::asum<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ AXPY
+
+/// BLAS1: Computes a vector-scalar product and adds the result to a vector.
+template <
+    typename S
+  , typename X
+  , typename Y
+>
+inline hpx::future<typename detail::operand_view<Y>::type> axpy(
+    BOOST_FWD_REF(S) a
+  , BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<Y>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::axpy<
+            typename detail::operand_scalar<S>::type
+          , typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_scalar(boost::forward<S>(a))
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ COPY 
+
+/// BLAS1: Copies vector to another vector. 
+template <
+    typename X
+  , typename Y
+>
+inline hpx::future<typename detail::operand_view<Y>::type> copy(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<Y>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::copy<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ DOT
+
+/// BLAS1: Computes a vector-vector dot product.
+template <
+    typename X
+  , typename Y
+>
+inline hpx::future<typename detail::operand_view<X>::type::value_type> dot(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::dot<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ SDSDOT
+
+/// BLAS1: Computes a vector-vector dot product with extended precision.
+template <
+    typename X
+  , typename Y
+  , typename S
+>
+inline hpx::future<float> sdsdot(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+  , BOOST_FWD_REF(S) sb
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::sdsdot<
+            typename detail::operand_scalar<S>::type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y))
+      , detail::make_scalar(boost::forward<S>(sb)));
+}
+
+/// BLAS1: Computes a vector-vector dot product with extended precision.
+template <
+    typename X
+  , typename Y
+>
+inline hpx::future<float> sdsdot(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    return sdsdot(boost::forward<X>(x), boost::forward<Y>(y), 0.0f);
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ DSDOT
+
+/// BLAS1: Computes a vector-vector dot product with extended precision.
+template <
+    typename X
+  , typename Y
+>
+inline hpx::future<double> dsdot(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::dsdot<typename view_type::policy_type>
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ DOTC
+
+/// BLAS1: Computes a dot product of a conjugated vector with another vector.
+template <
+    typename X
+  , typename Y
+>
+inline hpx::future<typename detail::operand_view<X>::type::value_type> dotc(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::dotc<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ DOTU
+
+/// BLAS1: Computes a vector-vector dot product.
+template <
+    typename X
+  , typename Y
+>
+inline hpx::future<typename detail::operand_view<X>::type::value_type> dotu(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::dotu<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ NRM2
+
+/// BLAS1: Computes the Euclidean norm of a vector.
+template <
+    typename X
+>
+inline hpx::future<
+    typename detail::real_type<
+        typename detail::operand_view<X>::type::value_type
+    >::type
+>
+nrm2(
+    BOOST_FWD_REF(X) x
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::nrm2<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ ROT 
+
+/// BLAS1: Performs rotation of points in the plane.
+template <
+    typename X
+  , typename Y
+  , typename S0
+  , typename S1
+>
+inline hpx::future<void> rot(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+  , BOOST_FWD_REF(S0) c
+  , BOOST_FWD_REF(S1) s
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::rot<
+            typename detail::operand_scalar<S0>::type
+          , typename detail::operand_scalar<S1>::type
+          , typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y))
+      , detail::make_scalar(boost::forward<S0>(c))
+      , detail::make_scalar(boost::forward<S1>(s)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ ROTM 
+
+/// BLAS1: Performs modified Givens rotation of points in the plane.
+template <
+    typename X
+  , typename Y
+  , typename P
+>
+inline hpx::future<void> rotm(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+  , BOOST_FWD_REF(P) param
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::rotm<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y))
+      , detail::make_operand(boost::forward<P>(param)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ SCAL 
+
+/// BLAS1: Computes the product of a vector by a scalar. 
+template <
+    typename S
+  , typename X
+>
+inline hpx::future<typename detail::operand_view<X>::type> scal(
+    BOOST_FWD_REF(S) a
+  , BOOST_FWD_REF(X) x
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::scal<
+            typename detail::operand_scalar<S>::type
+          , typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_scalar(boost::forward<S>(a))
+      , detail::make_operand(boost::forward<X>(x)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ SWAP 
+
+/// BLAS1: Swaps a vector with another vector. 
+template <
+    typename X
+  , typename Y
+>
+inline hpx::future<void> swap(
+    BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::swap<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y)));
+}
+
+// }}}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ IAMAX
+
+/// BLAS1: Finds the index of the element with maximum absolute value. 
+template <
+    typename X
+>
+inline hpx::future<std::size_t> iamax(
+    BOOST_FWD_REF(X) x
+    )
+{
+    typedef typename detail::operand_view<X>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::iamax<
+            typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<X>(x)));
+}
+
+// }}}
+
+}}}
+
+#endif // HPXLA_66C9863F_0EC1_4CE6_A1E9_E164762B9898
+
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_D48AD8DA_3213_46EF_A84A_B72EBDB56B47)
+#define HPXLA_D48AD8DA_3213_46EF_A84A_B72EBDB56B47
+
+#include <hpxla/local_blas/blas_level_2.hpp>
+#include <hpxla/local_blas/async/operands.hpp>
+
+namespace hpxla { namespace blas { namespace async
+{
+
+namespace detail
+{
+
+template <
+    typename S0
+  , typename S1
+  , typename T
+  , typename Policy
+>
+inline local_matrix_view<T, Policy> gemv(
+    hpx::shared_future<local_matrix_view<T, Policy> > A
+  , hpx::shared_future<local_matrix_view<T, Policy> > X
+  , hpx::shared_future<local_matrix_view<T, Policy> > Y
+  , S0 const& alpha
+  , S1 const& beta
+  , transpose_operation trans
+    )
+{
+    local_matrix_view<T, Policy> y = Y.get();
+    ::hpxla::blas::gemv(A.get(), X.get(), y, value(alpha), value(beta), trans);
+    return y;
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ GEMV
+
+/// BLAS2: Computes a matrix-vector product using a general matrix.
+///
+/// If \a beta is 0, \a Y is resized by giving it new storage; the returned
+/// future refers to that storage.
+template <
+    typename A
+  , typename X
+  , typename Y
+  , typename S0
+  , typename S1
+>
+inline hpx::future<typename detail::operand_view<Y>::type> gemv(
+    BOOST_FWD_REF(A) a
+  , BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+  , BOOST_FWD_REF(S0) alpha
+  , BOOST_FWD_REF(S1) beta
+  , transpose_operation trans = no_transpose
+    )
+{
+    typedef typename detail::operand_view<Y>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::gemv<
+            typename detail::operand_scalar<S0>::type
+          , typename detail::operand_scalar<S1>::type
+          , typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<A>(a))
+      , detail::make_operand(boost::forward<X>(x))
+      , detail::make_operand(boost::forward<Y>(y))
+      , detail::make_scalar(boost::forward<S0>(alpha))
+      , detail::make_scalar(boost::forward<S1>(beta))
+      , trans);
+}
+
+/// BLAS2: Computes a matrix-vector product using a general matrix.
+template <
+    typename A
+  , typename X
+  , typename Y
+>
+inline hpx::future<typename detail::operand_view<Y>::type> gemv(
+    BOOST_FWD_REF(A) a
+  , BOOST_FWD_REF(X) x
+  , BOOST_FWD_REF(Y) y
+    )
+{
+    typedef typename detail::operand_view<Y>::type::value_type value_type;
+
+    return gemv(boost::forward<A>(a), boost::forward<X>(x)
+              , boost::forward<Y>(y), value_type(1), value_type(0));
+}
+
+// }}}
+
+}}}
+
+#endif // HPXLA_D48AD8DA_3213_46EF_A84A_B72EBDB56B47
+
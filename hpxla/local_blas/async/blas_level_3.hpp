@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_EBAF387C_D6D3_4E26_874C_14E1AD7D13F2)
+#define HPXLA_EBAF387C_D6D3_4E26_874C_14E1AD7D13F2
+
+#include <hpxla/local_blas/blas_level_3.hpp>
+#include <hpxla/local_blas/async/operands.hpp>
+
+namespace hpxla { namespace blas { namespace async
+{
+
+namespace detail
+{
+
+template <
+    typename S0
+  , typename S1
+  , typename T
+  , typename Policy
+>
+inline local_matrix_view<T, Policy> gemm(
+    hpx::shared_future<local_matrix_view<T, Policy> > A
+  , hpx::shared_future<local_matrix_view<T, Policy> > B
+  , hpx::shared_future<local_matrix_view<T, Policy> > C
+  , S0 const& alpha
+  , S1 const& beta
+  , transpose_operation transa
+  , transpose_operation transb
+    )
+{
+    local_matrix_view<T, Policy> c = C.get();
+    ::hpxla::blas::gemm(A.get(), B.get(), c, value(alpha), value(beta)
+                      , transa, transb);
+    return c;
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ GEMM
+
+/// BLAS3: Computes a matrix-matrix product with general matrices.
+///
+/// If \a beta is 0, \a C is resized by giving it new storage; the returned
+/// future refers to that storage.
+template <
+    typename A
+  , typename B
+  , typename C
+  , typename S0
+  , typename S1
+>
+inline hpx::future<typename detail::operand_view<C>::type> gemm(
+    BOOST_FWD_REF(A) a
+  , BOOST_FWD_REF(B) b
+  , BOOST_FWD_REF(C) c
+  , BOOST_FWD_REF(S0) alpha
+  , BOOST_FWD_REF(S1) beta
+  , transpose_operation transa = no_transpose
+  , transpose_operation transb = no_transpose
+    )
+{
+    typedef typename detail::operand_view<C>::type view_type;
+
+    return hpx::lcos::local::dataflow(hpx::launch::async
+      , &detail::gemm<
+            typename detail::operand_scalar<S0>::type
+          , typename detail::operand_scalar<S1>::type
+          , typename view_type::value_type
+          , typename view_type::policy_type
+        >
+      , detail::make_operand(boost::forward<A>(a))
+      , detail::make_operand(boost::forward<B>(b))
+      , detail::make_operand(boost::forward<C>(c))
+      , detail::make_scalar(boost::forward<S0>(alpha))
+      , detail::make_scalar(boost::forward<S1>(beta))
+      , transa
+      , transb);
+}
+
+/// BLAS3: Computes a matrix-matrix product with general matrices.
+template <
+    typename A
+  , typename B
+  , typename C
+>
+inline hpx::future<typename detail::operand_view<C>::type> gemm(
+    BOOST_FWD_REF(A) a
+  , BOOST_FWD_REF(B) b
+  , BOOST_FWD_REF(C) c
+    )
+{
+    typedef typename detail::operand_view<C>::type::value_type value_type;
+
+    return gemm(boost::forward<A>(a), boost::forward<B>(b)
+              , boost::forward<C>(c), value_type(1), value_type(0));
+}
+
+// }}}
+
+}}}
+
+#endif // HPXLA_EBAF387C_D6D3_4E26_874C_14E1AD7D13F2
+
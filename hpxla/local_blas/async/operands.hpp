@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_091ED11F_1D40_405F_9A4A_A3C65C0FFE8E)
+#define HPXLA_091ED11F_1D40_405F_9A4A_A3C65C0FFE8E
+
+#include <hpxla/local_matrix.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/dataflow.hpp>
+
+#include <complex>
+
+#include <boost/move/move.hpp>
+
+// The asynchronous BLAS routines accept each matrix operand as either a
+// local_matrix_view<>, a local_matrix<> (whose view is used), or a future of a
+// local_matrix_view<>. Scalar operands may be plain values or futures. The
+// helpers below normalize all of these into shared futures, which can be
+// handed to dataflow.
+
+namespace hpxla { namespace blas { namespace async { namespace detail
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Matrix operands.
+
+template <
+    typename X
+>
+struct operand_view;
+
+template <
+    typename X
+>
+struct operand_view<X&> : operand_view<X> {};
+
+template <
+    typename X
+>
+struct operand_view<X const> : operand_view<X> {};
+
+template <
+    typename T
+  , typename Policy
+>
+struct operand_view<local_matrix_view<T, Policy> >
+{
+    typedef local_matrix_view<T, Policy> type;
+};
+
+template <
+    typename T
+  , typename Policy
+>
+struct operand_view<local_matrix<T, Policy> >
+{
+    typedef local_matrix_view<T, Policy> type;
+};
+
+template <
+    typename T
+  , typename Policy
+>
+struct operand_view<hpx::future<local_matrix_view<T, Policy> > >
+{
+    typedef local_matrix_view<T, Policy> type;
+};
+
+template <
+    typename T
+  , typename Policy
+>
+struct operand_view<hpx::shared_future<local_matrix_view<T, Policy> > >
+{
+    typedef local_matrix_view<T, Policy> type;
+};
+
+template <
+    typename T
+  , typename Policy
+>
+inline hpx::shared_future<local_matrix_view<T, Policy> > make_operand(
+    local_matrix_view<T, Policy> const& v
+    )
+{
+    return hpx::make_ready_future(v);
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline hpx::shared_future<local_matrix_view<T, Policy> > make_operand(
+    local_matrix<T, Policy> const& m
+    )
+{
+    // Views share the storage of the matrix, so results written through the
+    // view are visible in the matrix.
+    return hpx::make_ready_future(m.view());
+}
+
+// Results may be written through the view, so a copy-on-write matrix has to
+// stop sharing its storage with its copies first.
+template <
+    typename T
+  , typename Policy
+>
+inline hpx::shared_future<local_matrix_view<T, Policy> > make_operand(
+    local_matrix<T, Policy>& m
+    )
+{
+    return hpx::make_ready_future(m.view());
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline hpx::shared_future<local_matrix_view<T, Policy> > make_operand(
+    hpx::shared_future<local_matrix_view<T, Policy> > const& f
+    )
+{
+    return f;
+}
+
+template <
+    typename T
+  , typename Policy
+>
+inline hpx::shared_future<local_matrix_view<T, Policy> > make_operand(
+    BOOST_RV_REF_BEG hpx::future<local_matrix_view<T, Policy> > BOOST_RV_REF_END f
+    )
+{
+    return hpx::shared_future<local_matrix_view<T, Policy> >(boost::move(f));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Scalar operands.
+
+template <
+    typename S
+>
+struct operand_scalar
+{
+    typedef S type;
+};
+
+template <
+    typename S
+>
+struct operand_scalar<S&> : operand_scalar<S> {};
+
+template <
+    typename S
+>
+struct operand_scalar<S const> : operand_scalar<S> {};
+
+template <
+    typename S
+>
+struct operand_scalar<hpx::future<S> >
+{
+    typedef hpx::shared_future<S> type;
+};
+
+template <
+    typename S
+>
+inline S const& make_scalar(
+    S const& s
+    )
+{
+    return s;
+}
+
+template <
+    typename S
+>
+inline hpx::shared_future<S> make_scalar(
+    BOOST_RV_REF(hpx::future<S>) f
+    )
+{
+    return hpx::shared_future<S>(boost::move(f));
+}
+
+template <
+    typename S
+>
+inline S const& value(
+    S const& s
+    )
+{
+    return s;
+}
+
+template <
+    typename S
+>
+inline S value(
+    hpx::shared_future<S> const& f
+    )
+{
+    return f.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Result types.
+
+template <
+    typename T
+>
+struct real_type
+{
+    typedef T type;
+};
+
+template <
+    typename T
+>
+struct real_type<std::complex<T> >
+{
+    typedef T type;
+};
+
+}}}}
+
+#endif // HPXLA_091ED11F_1D40_405F_9A4A_A3C65C0FFE8E
+
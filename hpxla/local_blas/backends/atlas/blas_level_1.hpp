@@ -35,6 +35,7 @@ inline float asum(
     local_matrix_view<float, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_sasum(X.rows(), X.data(), X.vector_stride()); 
 }
 
@@ -46,6 +47,7 @@ inline float asum(
     local_matrix_view<std::complex<float>, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_scasum(X.rows(), (void const*) X.data(), X.vector_stride()); 
 }
 
@@ -57,6 +59,7 @@ inline double asum(
     local_matrix_view<double, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_dasum(X.rows(), X.data(), X.vector_stride()); 
 }
 
@@ -68,6 +71,7 @@ inline double asum(
     local_matrix_view<std::complex<double>, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_dzasum(X.rows(), (void const*) X.data(), X.vector_stride()); 
 }
 
@@ -86,6 +90,8 @@ inline void axpy(
   , local_matrix_view<float, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_saxpy(X.rows(), a, X.data(), X.vector_stride()
                              , Y.data(), Y.vector_stride());
@@ -101,6 +107,8 @@ inline void axpy(
   , local_matrix_view<std::complex<float>, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_caxpy(X.rows(), (void const*) &a
                           , (void const*) X.data(), X.vector_stride()
@@ -117,6 +125,8 @@ inline void axpy(
   , local_matrix_view<double, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_daxpy(X.rows(), a, X.data(), X.vector_stride()
                              , Y.data(), Y.vector_stride());
@@ -132,6 +142,8 @@ inline void axpy(
   , local_matrix_view<std::complex<double>, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_zaxpy(X.rows(), (void const*) &a
                           , (void const*) X.data(), X.vector_stride()
@@ -152,6 +164,8 @@ inline void copy(
   , local_matrix_view<float, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_scopy(X.rows(), X.data(), X.vector_stride()
                           , Y.data(), Y.vector_stride());
@@ -166,6 +180,8 @@ inline void copy(
   , local_matrix_view<std::complex<float>, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_ccopy(X.rows(), (void const*) X.data(), X.vector_stride()
                           , (void*)       Y.data(), Y.vector_stride());
@@ -180,6 +196,8 @@ inline void copy(
   , local_matrix_view<double, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_dcopy(X.rows(), X.data(), X.vector_stride()
                           , Y.data(), Y.vector_stride());
@@ -194,6 +212,8 @@ inline void copy(
   , local_matrix_view<std::complex<double>, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_zcopy(X.rows(), (void const*) X.data(), X.vector_stride()
                           , (void*)       Y.data(), Y.vector_stride());
@@ -213,6 +233,8 @@ inline float dot(
   , local_matrix_view<float, Policy> const& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     return ::cblas_sdot(X.rows(), X.data(), X.vector_stride()
                                 , Y.data(), Y.vector_stride()); 
@@ -227,6 +249,8 @@ inline double dot(
   , local_matrix_view<double, Policy> const& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     return ::cblas_ddot(X.rows(), X.data(), X.vector_stride()
                                 , Y.data(), Y.vector_stride()); 
@@ -247,6 +271,8 @@ inline float sdsdot(
   , float sb = 0.0
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     return ::cblas_sdsdot(X.rows(), sb, X.data(), X.vector_stride()
                                       , Y.data(), Y.vector_stride()); 
@@ -266,6 +292,8 @@ inline double dsdot(
   , local_matrix_view<float, Policy> const& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     return ::cblas_dsdot(X.rows(), X.data(), X.vector_stride()
                                  , Y.data(), Y.vector_stride()); 
@@ -285,6 +313,8 @@ inline std::complex<float> dotc(
   , local_matrix_view<std::complex<float>, Policy> const& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     std::complex<float> r(0.0, 0.0);
     ::cblas_cdotc_sub(X.rows(), (void const*) X.data(), X.vector_stride()
@@ -302,6 +332,8 @@ inline std::complex<double> dotc(
   , local_matrix_view<std::complex<double>, Policy> const& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     std::complex<double> r(0.0, 0.0);
     ::cblas_zdotc_sub(X.rows(), (void const*) X.data(), X.vector_stride()
@@ -324,6 +356,8 @@ inline std::complex<float> dotu(
   , local_matrix_view<std::complex<float>, Policy> const& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     std::complex<float> r(0.0, 0.0);
     ::cblas_cdotu_sub(X.rows(), (void const*) X.data(), X.vector_stride()
@@ -341,6 +375,8 @@ inline std::complex<double> dotu(
   , local_matrix_view<std::complex<double>, Policy> const& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     std::complex<double> r(0.0, 0.0);
     ::cblas_zdotu_sub(X.rows(), (void const*) X.data(), X.vector_stride()
@@ -362,6 +398,7 @@ inline float nrm2(
     local_matrix_view<float, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_snrm2(X.rows(), X.data(), X.vector_stride()); 
 }
 
@@ -373,6 +410,7 @@ inline float nrm2(
     local_matrix_view<std::complex<float>, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_scnrm2(X.rows(), (void const*) X.data(), X.vector_stride()); 
 }
 
@@ -384,6 +422,7 @@ inline double nrm2(
     local_matrix_view<double, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_dnrm2(X.rows(), X.data(), X.vector_stride()); 
 }
 
@@ -395,6 +434,7 @@ inline double nrm2(
     local_matrix_view<std::complex<double>, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_dznrm2(X.rows(), (void const*) X.data(), X.vector_stride()); 
 }
 
@@ -414,6 +454,8 @@ inline void rot(
   , float s
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_srot(X.rows(), X.data(), X.vector_stride()
                          , Y.data(), Y.vector_stride(), c, s); 
@@ -430,6 +472,8 @@ inline void rot(
   , double s
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_drot(X.rows(), X.data(), X.vector_stride()
                          , Y.data(), Y.vector_stride(), c, s); 
@@ -477,6 +521,9 @@ inline void rotm(
   , local_matrix_view<float, Policy> const& param
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
+    BOOST_ASSERT(param.in_single_tile());
     BOOST_ASSERT(5 == param.rows()); 
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_srotm(X.rows(), X.data(), X.vector_stride()
@@ -493,6 +540,8 @@ inline void rotm(
   , boost::array<float, 5> const& param
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_srotm(X.rows(), X.data(), X.vector_stride()
                           , Y.data(), Y.vector_stride(), param.data()); 
@@ -508,6 +557,9 @@ inline void rotm(
   , local_matrix_view<double, Policy> const& param
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
+    BOOST_ASSERT(param.in_single_tile());
     BOOST_ASSERT(5 == param.rows()); 
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_drotm(X.rows(), X.data(), X.vector_stride()
@@ -524,6 +576,8 @@ inline void rotm(
   , boost::array<double, 5> const& param
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_drotm(X.rows(), X.data(), X.vector_stride()
                           , Y.data(), Y.vector_stride(), param.data()); 
@@ -546,6 +600,7 @@ inline void rotmg(
   , local_matrix_view<float, Policy>& param
     )
 {
+    BOOST_ASSERT(param.in_single_tile());
     BOOST_ASSERT(5 == param.rows()); 
     ::cblas_srotmg(&d1, &d2, &x1, y1, param.data());
 }
@@ -577,6 +632,7 @@ inline void rotmg(
   , local_matrix_view<double, Policy>& param
     )
 {
+    BOOST_ASSERT(param.in_single_tile());
     BOOST_ASSERT(5 == param.rows()); 
     ::cblas_drotmg(&d1, &d2, &x1, y1, param.data());
 }
@@ -610,6 +666,7 @@ inline void scal(
   , local_matrix_view<float, Policy>& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     ::cblas_sscal(X.rows(), a, X.data(), X.vector_stride()); 
 }
 
@@ -622,6 +679,7 @@ inline void scal(
   , local_matrix_view<std::complex<float>, Policy>& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     ::cblas_cscal(X.rows(), (void const*) &a
                           , (void*)       X.data(), X.vector_stride()); 
 }
@@ -635,6 +693,7 @@ inline void scal(
   , local_matrix_view<std::complex<float>, Policy>& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     ::cblas_csscal(X.rows(), a, (void*) X.data(), X.vector_stride()); 
 }
 
@@ -647,6 +706,7 @@ inline void scal(
   , local_matrix_view<double, Policy>& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     ::cblas_dscal(X.rows(), a, X.data(), X.vector_stride()); 
 }
 
@@ -659,6 +719,7 @@ inline void scal(
   , local_matrix_view<std::complex<double>, Policy>& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     ::cblas_zscal(X.rows(), (void const*) &a
                           , (void*)       X.data(), X.vector_stride()); 
 }
@@ -672,6 +733,7 @@ inline void scal(
   , local_matrix_view<std::complex<double>, Policy>& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     ::cblas_zdscal(X.rows(), a, (void*) X.data(), X.vector_stride()); 
 }
 
@@ -689,6 +751,8 @@ inline void swap(
   , local_matrix_view<float, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_sswap(X.rows(), X.data(), X.vector_stride()
                           , Y.data(), Y.vector_stride());
@@ -703,6 +767,8 @@ inline void swap(
   , local_matrix_view<std::complex<float>, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_cswap(X.rows(), (void*) X.data(), X.vector_stride()
                           , (void*) Y.data(), Y.vector_stride());
@@ -717,6 +783,8 @@ inline void swap(
   , local_matrix_view<double, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_dswap(X.rows(), X.data(), X.vector_stride()
                           , Y.data(), Y.vector_stride());
@@ -731,6 +799,8 @@ inline void swap(
   , local_matrix_view<std::complex<double>, Policy>& Y
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
+    BOOST_ASSERT(Y.in_single_tile());
     BOOST_ASSERT(X.rows() == Y.rows());
     ::cblas_zswap(X.rows(), (void*) X.data(), X.vector_stride()
                           , (void*) Y.data(), Y.vector_stride());
@@ -749,6 +819,7 @@ inline std::size_t iamax(
     local_matrix_view<float, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_isamax(X.rows(), X.data(), X.vector_stride()); 
 }
 
@@ -760,6 +831,7 @@ inline std::size_t iamax(
     local_matrix_view<std::complex<float>, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_icamax(X.rows(), (void const*) X.data(), X.vector_stride()); 
 }
 
@@ -771,6 +843,7 @@ inline std::size_t iamax(
     local_matrix_view<double, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_idamax(X.rows(), X.data(), X.vector_stride()); 
 }
 
@@ -782,6 +855,7 @@ inline std::size_t iamax(
     local_matrix_view<std::complex<double>, Policy> const& X
     )
 {
+    BOOST_ASSERT(X.in_single_tile());
     return ::cblas_izamax(X.rows(), (void const*) X.data(), X.vector_stride()); 
 }
 
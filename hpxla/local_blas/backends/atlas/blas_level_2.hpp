@@ -49,6 +49,7 @@ inline void gemv(
     ///////////////////////////////////////////////////////////////////////////
     // Check A.
     BOOST_ASSERT(!A.empty());
+    BOOST_ASSERT(A.in_single_tile());
 
     ///////////////////////////////////////////////////////////////////////////
     // Check Y.
@@ -67,16 +68,21 @@ inline void gemv(
         if (no_transpose == trans)
         {
             if (m != Y.rows())
-                Y = boost::move(matrix_type(m));
+                Y = boost::move(matrix_type(m, 1, uninitialized
+                                          , matrix_offsets(0, 0)
+                                          , Y.get_allocator()));
         }
 
         else if (n != Y.rows())
-            Y = boost::move(matrix_type(n));
+            Y = boost::move(matrix_type(n, 1, uninitialized
+                                      , matrix_offsets(0, 0)
+                                      , Y.get_allocator()));
     }
    
     ///////////////////////////////////////////////////////////////////////////
     // Check X. 
     BOOST_ASSERT(!X.empty());
+    BOOST_ASSERT(X.in_single_tile());
 
     if (no_transpose == trans)
         BOOST_ASSERT(n == X.rows());
@@ -84,6 +90,8 @@ inline void gemv(
         BOOST_ASSERT(m == X.rows());
 
     ///////////////////////////////////////////////////////////////////////////
+    BOOST_ASSERT(Y.in_single_tile());
+
     ::cblas_sgemv(CBLAS_ORDER(A.index_order()), CBLAS_TRANSPOSE(trans), m, n
                 , alpha
                 , A.data(), A.leading_dimension()
@@ -113,6 +121,7 @@ inline void gemv(
     ///////////////////////////////////////////////////////////////////////////
     // Check A.
     BOOST_ASSERT(!A.empty());
+    BOOST_ASSERT(A.in_single_tile());
 
     ///////////////////////////////////////////////////////////////////////////
     // Check Y. 
@@ -132,16 +141,21 @@ inline void gemv(
         if (no_transpose == trans)
         {
             if (m != Y.rows())
-                Y = boost::move(matrix_type(m)); 
+                Y = boost::move(matrix_type(m, 1, uninitialized
+                                          , matrix_offsets(0, 0)
+                                          , Y.get_allocator()));
         }
 
         else if (n != Y.rows())
-            Y = boost::move(matrix_type(n)); 
+            Y = boost::move(matrix_type(n, 1, uninitialized
+                                      , matrix_offsets(0, 0)
+                                      , Y.get_allocator()));
     }
    
     ///////////////////////////////////////////////////////////////////////////
     // Check X. 
     BOOST_ASSERT(!X.empty());
+    BOOST_ASSERT(X.in_single_tile());
 
     if (no_transpose == trans)
         BOOST_ASSERT(n == X.rows());
@@ -149,6 +163,8 @@ inline void gemv(
         BOOST_ASSERT(m == X.rows());
 
     ///////////////////////////////////////////////////////////////////////////
+    BOOST_ASSERT(Y.in_single_tile());
+
     ::cblas_cgemv(CBLAS_ORDER(A.index_order()), CBLAS_TRANSPOSE(trans), m, n
                 , (void const*) &alpha
                 , (void const*) A.data(), A.leading_dimension()
@@ -178,6 +194,7 @@ inline void gemv(
     ///////////////////////////////////////////////////////////////////////////
     // Check A.
     BOOST_ASSERT(!A.empty());
+    BOOST_ASSERT(A.in_single_tile());
 
     ///////////////////////////////////////////////////////////////////////////
     // Check Y. 
@@ -196,16 +213,21 @@ inline void gemv(
         if (no_transpose == trans)
         {
             if (m != Y.rows())
-                Y = boost::move(matrix_type(m)); 
+                Y = boost::move(matrix_type(m, 1, uninitialized
+                                          , matrix_offsets(0, 0)
+                                          , Y.get_allocator()));
         }
 
         else if (n != Y.rows())
-            Y = boost::move(matrix_type(n)); 
+            Y = boost::move(matrix_type(n, 1, uninitialized
+                                      , matrix_offsets(0, 0)
+                                      , Y.get_allocator()));
     }
    
     ///////////////////////////////////////////////////////////////////////////
     // Check X. 
     BOOST_ASSERT(!X.empty());
+    BOOST_ASSERT(X.in_single_tile());
 
     if (no_transpose == trans)
         BOOST_ASSERT(n == X.rows());
@@ -213,6 +235,8 @@ inline void gemv(
         BOOST_ASSERT(m == X.rows());
 
     ///////////////////////////////////////////////////////////////////////////
+    BOOST_ASSERT(Y.in_single_tile());
+
     ::cblas_dgemv(CBLAS_ORDER(A.index_order()), CBLAS_TRANSPOSE(trans), m, n
                 , alpha
                 , A.data(), A.leading_dimension()
@@ -242,6 +266,7 @@ inline void gemv(
     ///////////////////////////////////////////////////////////////////////////
     // Check A.
     BOOST_ASSERT(!A.empty());
+    BOOST_ASSERT(A.in_single_tile());
 
     ///////////////////////////////////////////////////////////////////////////
     // Check Y. 
@@ -261,16 +286,21 @@ inline void gemv(
         if (no_transpose == trans)
         {
             if (m != Y.rows())
-                Y = boost::move(matrix_type(m)); 
+                Y = boost::move(matrix_type(m, 1, uninitialized
+                                          , matrix_offsets(0, 0)
+                                          , Y.get_allocator()));
         }
 
         else if (n != Y.rows())
-            Y = boost::move(matrix_type(n)); 
+            Y = boost::move(matrix_type(n, 1, uninitialized
+                                      , matrix_offsets(0, 0)
+                                      , Y.get_allocator()));
     }
    
     ///////////////////////////////////////////////////////////////////////////
     // Check X. 
     BOOST_ASSERT(!X.empty());
+    BOOST_ASSERT(X.in_single_tile());
 
     if (no_transpose == trans)
         BOOST_ASSERT(n == X.rows());
@@ -278,6 +308,8 @@ inline void gemv(
         BOOST_ASSERT(m == X.rows());
 
     ///////////////////////////////////////////////////////////////////////////
+    BOOST_ASSERT(Y.in_single_tile());
+
     ::cblas_zgemv(CBLAS_ORDER(A.index_order()), CBLAS_TRANSPOSE(trans), m, n
                 , (void const*) &alpha
                 , (void const*) A.data(), A.leading_dimension()
@@ -8,7 +8,11 @@
 #if !defined(HPXLA_61587589_A4B5_4969_834E_A23D25367C72)
 #define HPXLA_61587589_A4B5_4969_834E_A23D25367C72
 
+#include <hpxla/config.hpp>
 #include <hpxla/local_matrix_view.hpp>
+#include <hpxla/local_blas/blas_enums.hpp>
+#include <hpxla/compare_real.hpp>
+#include <hpxla/tiling.hpp>
 
 #include <complex>
 
@@ -17,14 +21,444 @@ extern "C"
     #include <cblas.h>
 }
 
+// NOTE: ATM, only GEMM is implemented.
+
 namespace hpxla { namespace blas
 {
 
-// IMPLEMENT 
+namespace detail
+{
+
+inline void gemm_kernel(
+    index_order order
+  , transpose_operation transa
+  , transpose_operation transb
+  , std::size_t m
+  , std::size_t n
+  , std::size_t k
+  , float alpha
+  , float const* A
+  , std::size_t lda
+  , float const* B
+  , std::size_t ldb
+  , float beta
+  , float* C
+  , std::size_t ldc
+    )
+{
+    ::cblas_sgemm(CBLAS_ORDER(order)
+                , CBLAS_TRANSPOSE(transa), CBLAS_TRANSPOSE(transb), m, n, k
+                , alpha
+                , A, lda
+                , B, ldb
+                , beta
+                , C, ldc);
+}
+
+inline void gemm_kernel(
+    index_order order
+  , transpose_operation transa
+  , transpose_operation transb
+  , std::size_t m
+  , std::size_t n
+  , std::size_t k
+  , std::complex<float> alpha
+  , std::complex<float> const* A
+  , std::size_t lda
+  , std::complex<float> const* B
+  , std::size_t ldb
+  , std::complex<float> beta
+  , std::complex<float>* C
+  , std::size_t ldc
+    )
+{
+    ::cblas_cgemm(CBLAS_ORDER(order)
+                , CBLAS_TRANSPOSE(transa), CBLAS_TRANSPOSE(transb), m, n, k
+                , (void const*) &alpha
+                , (void const*) A, lda
+                , (void const*) B, ldb
+                , (void const*) &beta
+                , (void*)       C, ldc);
+}
+
+inline void gemm_kernel(
+    index_order order
+  , transpose_operation transa
+  , transpose_operation transb
+  , std::size_t m
+  , std::size_t n
+  , std::size_t k
+  , double alpha
+  , double const* A
+  , std::size_t lda
+  , double const* B
+  , std::size_t ldb
+  , double beta
+  , double* C
+  , std::size_t ldc
+    )
+{
+    ::cblas_dgemm(CBLAS_ORDER(order)
+                , CBLAS_TRANSPOSE(transa), CBLAS_TRANSPOSE(transb), m, n, k
+                , alpha
+                , A, lda
+                , B, ldb
+                , beta
+                , C, ldc);
+}
+
+inline void gemm_kernel(
+    index_order order
+  , transpose_operation transa
+  , transpose_operation transb
+  , std::size_t m
+  , std::size_t n
+  , std::size_t k
+  , std::complex<double> alpha
+  , std::complex<double> const* A
+  , std::size_t lda
+  , std::complex<double> const* B
+  , std::size_t ldb
+  , std::complex<double> beta
+  , std::complex<double>* C
+  , std::size_t ldc
+    )
+{
+    ::cblas_zgemm(CBLAS_ORDER(order)
+                , CBLAS_TRANSPOSE(transa), CBLAS_TRANSPOSE(transb), m, n, k
+                , (void const*) &alpha
+                , (void const*) A, lda
+                , (void const*) B, ldb
+                , (void const*) &beta
+                , (void*)       C, ldc);
+}
+
+/// Computes one tile of C = alpha * op(A) * op(B) + beta * C.
+template <
+    typename T
+  , typename Policy
+>
+struct gemm_tile
+{
+    typedef local_matrix_view<T, Policy> matrix_type;
+
+    gemm_tile(
+        matrix_type const& A
+      , matrix_type const& B
+      , matrix_type const& C
+      , T alpha
+      , T beta
+      , transpose_operation transa
+      , transpose_operation transb
+      , std::size_t k
+        )
+      : A_(A)
+      , B_(B)
+      , C_(C)
+      , alpha_(alpha)
+      , beta_(beta)
+      , transa_(transa)
+      , transb_(transb)
+      , k_(k)
+    {}
+
+    void operator()(
+        matrix_bounds start
+      , matrix_bounds extents
+        )
+    {
+        block(start.rows, start.cols, 0, extents.rows, extents.cols, k_, beta_);
+    }
+
+  private:
+    /// Computes the m x n block of C at (i, j), accumulating the products of
+    /// columns [l, l + k) of op(A) and rows [l, l + k) of op(B). The block is
+    /// split until the parts of A, B and C that it touches are each stored
+    /// contiguously; with column-major or row-major indexing, no splitting is
+    /// necessary.
+    void block(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , boost::uint64_t l
+      , boost::uint64_t m
+      , boost::uint64_t n
+      , boost::uint64_t k
+      , T beta
+        )
+    {
+        matrix_bounds const c = C_.tile_extents(i, j);
+        matrix_bounds const a = (no_transpose == transa_)
+                              ? A_.tile_extents(i, l)
+                              : transposed(A_.tile_extents(l, i));
+        matrix_bounds const b = (no_transpose == transb_)
+                              ? B_.tile_extents(l, j)
+                              : transposed(B_.tile_extents(j, l));
+
+        boost::uint64_t const m0 = (std::min)(m, (std::min)(c.rows, a.rows));
+        boost::uint64_t const n0 = (std::min)(n, (std::min)(c.cols, b.cols));
+        boost::uint64_t const k0 = (std::min)(k, (std::min)(a.cols, b.rows));
+
+        if (m0 < m)
+        {
+            block(i, j, l, m0, n, k, beta);
+            block(i + m0, j, l, m - m0, n, k, beta);
+        }
+
+        else if (n0 < n)
+        {
+            block(i, j, l, m, n0, k, beta);
+            block(i, j + n0, l, m, n - n0, k, beta);
+        }
+
+        else if (k0 < k)
+        {
+            // The remaining products are added to the first partial result.
+            block(i, j, l, m, n, k0, beta);
+            block(i, j, l + k0, m, n, k - k0, T(1));
+        }
+
+        else
+        {
+            T const* pa = (no_transpose == transa_) ? &A_(i, l) : &A_(l, i);
+            T const* pb = (no_transpose == transb_) ? &B_(l, j) : &B_(j, l);
+
+            gemm_kernel(C_.index_order(), transa_, transb_
+                      , m, n, k
+                      , alpha_
+                      , pa, A_.leading_dimension()
+                      , pb, B_.leading_dimension()
+                      , beta
+                      , &C_(i, j), C_.leading_dimension());
+        }
+    }
+
+    static matrix_bounds transposed(
+        matrix_bounds b
+        )
+    {
+        return matrix_bounds(b.cols, b.rows);
+    }
+
+    matrix_type A_;
+    matrix_type B_;
+    matrix_type C_;
+    T alpha_;
+    T beta_;
+    transpose_operation transa_;
+    transpose_operation transb_;
+    std::size_t k_;
+};
+
+/// Checks A and B and computes C = alpha * op(A) * op(B) + beta * C tile by
+/// tile. C must already have the correct dimensions.
+template <
+    typename T
+  , typename Policy
+>
+inline void tiled_gemm(
+    local_matrix_view<T, Policy> const& A
+  , local_matrix_view<T, Policy> const& B
+  , local_matrix_view<T, Policy>& C
+  , T alpha
+  , T beta
+  , transpose_operation transa
+  , transpose_operation transb
+    )
+{
+    std::size_t const k = (no_transpose == transa) ? A.columns() : A.rows();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Check A.
+    BOOST_ASSERT(!A.empty());
+
+    if (no_transpose == transa)
+        BOOST_ASSERT(C.rows() == A.rows());
+    else
+        BOOST_ASSERT(C.rows() == A.columns());
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Check B.
+    BOOST_ASSERT(!B.empty());
+
+    if (no_transpose == transb)
+    {
+        BOOST_ASSERT(k == B.rows());
+        BOOST_ASSERT(C.columns() == B.columns());
+    }
+
+    else
+    {
+        BOOST_ASSERT(k == B.columns());
+        BOOST_ASSERT(C.columns() == B.rows());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // If C is stored in tiles smaller than HPXLA_GEMM_TILE_SIZE, each task
+    // computes a whole number of them.
+    for_each_tile(matrix_bounds(C.rows(), C.columns())
+                , task_tile(C.tile_bounds())
+                , gemm_tile<T, Policy>(A, B, C, alpha, beta, transa, transb, k));
+}
+
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 // {{{ GEMM
 
+/// BLAS3: Computes a matrix-matrix product with general matrices. C is split
+/// into tiles, and each tile is computed by a separate HPX task.
+template <
+    typename Policy
+>
+inline void gemm(
+    local_matrix_view<float, Policy> const& A
+  , local_matrix_view<float, Policy> const& B
+  , local_matrix_view<float, Policy>& C
+  , float alpha = 1.0
+  , float beta = 0.0
+  , transpose_operation transa = no_transpose
+  , transpose_operation transb = no_transpose
+    )
+{
+    typedef local_matrix_view<float, Policy> matrix_type;
+
+    std::size_t const m = (no_transpose == transa) ? A.rows() : A.columns();
+    std::size_t const n = (no_transpose == transb) ? B.columns() : B.rows();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Check C.
+    if (!compare_real(0.0f, beta))
+    {
+        BOOST_ASSERT(!C.empty());
+        BOOST_ASSERT(m == C.rows());
+        BOOST_ASSERT(n == C.columns());
+    }
+
+    else if (m != C.rows() || n != C.columns())
+        C = boost::move(matrix_type(m, n, uninitialized
+                                  , matrix_offsets(0, 0)
+                                  , C.get_allocator()));
+
+    ///////////////////////////////////////////////////////////////////////////
+    detail::tiled_gemm(A, B, C, alpha, beta, transa, transb);
+}
+
+/// BLAS3: Computes a matrix-matrix product with general matrices. C is split
+/// into tiles, and each tile is computed by a separate HPX task.
+template <
+    typename Policy
+>
+inline void gemm(
+    local_matrix_view<std::complex<float>, Policy> const& A
+  , local_matrix_view<std::complex<float>, Policy> const& B
+  , local_matrix_view<std::complex<float>, Policy>& C
+  , std::complex<float> alpha = 1.0
+  , std::complex<float> beta = 0.0
+  , transpose_operation transa = no_transpose
+  , transpose_operation transb = no_transpose
+    )
+{
+    typedef local_matrix_view<std::complex<float>, Policy> matrix_type;
+
+    std::size_t const m = (no_transpose == transa) ? A.rows() : A.columns();
+    std::size_t const n = (no_transpose == transb) ? B.columns() : B.rows();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Check C.
+    if (!(  compare_real(0.0f, beta.real())
+         && compare_real(0.0f, beta.imag())))
+    {
+        BOOST_ASSERT(!C.empty());
+        BOOST_ASSERT(m == C.rows());
+        BOOST_ASSERT(n == C.columns());
+    }
+
+    else if (m != C.rows() || n != C.columns())
+        C = boost::move(matrix_type(m, n, uninitialized
+                                  , matrix_offsets(0, 0)
+                                  , C.get_allocator()));
+
+    ///////////////////////////////////////////////////////////////////////////
+    detail::tiled_gemm(A, B, C, alpha, beta, transa, transb);
+}
+
+/// BLAS3: Computes a matrix-matrix product with general matrices. C is split
+/// into tiles, and each tile is computed by a separate HPX task.
+template <
+    typename Policy
+>
+inline void gemm(
+    local_matrix_view<double, Policy> const& A
+  , local_matrix_view<double, Policy> const& B
+  , local_matrix_view<double, Policy>& C
+  , double alpha = 1.0
+  , double beta = 0.0
+  , transpose_operation transa = no_transpose
+  , transpose_operation transb = no_transpose
+    )
+{
+    typedef local_matrix_view<double, Policy> matrix_type;
+
+    std::size_t const m = (no_transpose == transa) ? A.rows() : A.columns();
+    std::size_t const n = (no_transpose == transb) ? B.columns() : B.rows();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Check C.
+    if (!compare_real(0.0, beta))
+    {
+        BOOST_ASSERT(!C.empty());
+        BOOST_ASSERT(m == C.rows());
+        BOOST_ASSERT(n == C.columns());
+    }
+
+    else if (m != C.rows() || n != C.columns())
+        C = boost::move(matrix_type(m, n, uninitialized
+                                  , matrix_offsets(0, 0)
+                                  , C.get_allocator()));
+
+    ///////////////////////////////////////////////////////////////////////////
+    detail::tiled_gemm(A, B, C, alpha, beta, transa, transb);
+}
+
+/// BLAS3: Computes a matrix-matrix product with general matrices. C is split
+/// into tiles, and each tile is computed by a separate HPX task.
+template <
+    typename Policy
+>
+inline void gemm(
+    local_matrix_view<std::complex<double>, Policy> const& A
+  , local_matrix_view<std::complex<double>, Policy> const& B
+  , local_matrix_view<std::complex<double>, Policy>& C
+  , std::complex<double> alpha = 1.0
+  , std::complex<double> beta = 0.0
+  , transpose_operation transa = no_transpose
+  , transpose_operation transb = no_transpose
+    )
+{
+    typedef local_matrix_view<std::complex<double>, Policy> matrix_type;
+
+    std::size_t const m = (no_transpose == transa) ? A.rows() : A.columns();
+    std::size_t const n = (no_transpose == transb) ? B.columns() : B.rows();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Check C.
+    if (!(  compare_real(0.0, beta.real())
+         && compare_real(0.0, beta.imag())))
+    {
+        BOOST_ASSERT(!C.empty());
+        BOOST_ASSERT(m == C.rows());
+        BOOST_ASSERT(n == C.columns());
+    }
+
+    else if (m != C.rows() || n != C.columns())
+        C = boost::move(matrix_type(m, n, uninitialized
+                                  , matrix_offsets(0, 0)
+                                  , C.get_allocator()));
+
+    ///////////////////////////////////////////////////////////////////////////
+    detail::tiled_gemm(A, B, C, alpha, beta, transa, transb);
+}
+
 // }}}
 
 ///////////////////////////////////////////////////////////////////////////////
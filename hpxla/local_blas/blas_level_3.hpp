@@ -21,7 +21,30 @@
 namespace hpxla { namespace blas
 {
 
-// IMPLEMENT: local_matrix forwarders.
+// Forwarding functions for local_matrix<>.
+
+///////////////////////////////////////////////////////////////////////////////
+// {{{ GEMM
+
+/// BLAS3: Computes a matrix-matrix product with general matrices.
+template <
+    typename T
+  , typename Policy
+>
+inline void gemm(
+    local_matrix<T, Policy> const& A
+  , local_matrix<T, Policy> const& B
+  , local_matrix<T, Policy>& C
+  , typename local_matrix<T, Policy>::value_type alpha = 1.0
+  , typename local_matrix<T, Policy>::value_type beta = 0.0
+  , transpose_operation transa = no_transpose
+  , transpose_operation transb = no_transpose
+    )
+{
+    gemm(A.view(), B.view(), C.view(), alpha, beta, transa, transb);
+}
+
+// }}}
 
 }}
 
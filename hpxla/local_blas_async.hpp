@@ -0,0 +1,16 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_15F16DB5_D02E_4547_96FC_E5C067F83A9A)
+#define HPXLA_15F16DB5_D02E_4547_96FC_E5C067F83A9A
+
+#include <hpxla/local_blas/async/blas_level_1.hpp>
+#include <hpxla/local_blas/async/blas_level_2.hpp>
+#include <hpxla/local_blas/async/blas_level_3.hpp>
+
+#endif // HPXLA_15F16DB5_D02E_4547_96FC_E5C067F83A9A
+
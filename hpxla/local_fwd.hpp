@@ -13,6 +13,19 @@
 namespace hpxla
 {
 
+/// Selects the constructors of local_matrix and local_matrix_view which
+/// initialize the elements in parallel, with the tiles that the tiled kernels
+/// use.
+struct first_touch_t {};
+
+first_touch_t const first_touch = first_touch_t();
+
+/// Selects the constructors of local_matrix and local_matrix_view which don't
+/// initialize the elements, for matrices which are about to be overwritten.
+struct uninitialized_t {};
+
+uninitialized_t const uninitialized = uninitialized_t();
+
 template <
     typename T
   , typename Policy = local_matrix_policy<> 
@@ -25,6 +38,11 @@ template <
 >
 struct local_matrix;
 
+template <
+    typename Matrix
+>
+struct storage_buffer;
+
 }
 
 #endif // HPXLA_F1C9159C_DE88_4AAB_A4F2_5F186B3C6B84
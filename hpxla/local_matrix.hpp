@@ -32,16 +32,34 @@ struct local_matrix
     typedef typename view_type::policy_type policy_type;
     typedef typename view_type::indexing_policy_type indexing_policy_type;
     typedef typename view_type::allocation_policy_type allocation_policy_type;
+    typedef typename policy_type::copy_policy_type copy_policy_type;
 
     typedef typename view_type::allocator_type allocator_type;
+    typedef typename view_type::storage_type storage_type;
 
   private:
     BOOST_COPYABLE_AND_MOVABLE(local_matrix);
 
-    view_type view_;
+    // Mutable so that view() const can give the matrix storage of its own
+    // before handing out the view (see unshare()).
+    mutable view_type view_;
+
+    // Shared by the matrices which share view_.storage_ through deferred
+    // copies (see policy::copy_on_write). Created by the first such copy.
+    mutable boost::shared_ptr<void> owners_;
 
     friend class boost::serialization::access;
 
+    template <
+        typename Matrix
+    >
+    friend struct storage_buffer;
+
+    boost::shared_ptr<storage_type> const& shared_storage() const
+    {
+        return view_.storage_;
+    }
+
     template <
         typename Archive
     >
@@ -51,6 +69,90 @@ struct local_matrix
         ) 
     {
         ar & view_; 
+
+        // A loaded matrix has storage of its own.
+        if (Archive::is_loading::value)
+            owners_.reset();
+    }
+
+    boost::shared_ptr<void> acquire_owners() const
+    {
+        boost::shared_ptr<void> owners = boost::atomic_load(&owners_);
+
+        if (!owners)
+        {
+            boost::shared_ptr<void> const fresh = boost::make_shared<char>();
+
+            // If another thread got there first, owners is set to its token.
+            if (boost::atomic_compare_exchange(&owners_, &owners, fresh))
+                owners = fresh;
+        }
+
+        return owners;
+    }
+
+    /// Gives this matrix the storage of \a other; with copy_on_write, the
+    /// storage is shared instead of copied, if no views of \a other exist.
+    void copy_storage(
+        local_matrix const& other
+        )
+    {
+        boost::shared_ptr<storage_type> storage;
+        boost::shared_ptr<void> owners;
+
+        if (  other.view_.bounds_.rows
+           && other.view_.bounds_.cols
+           && other.view_.storage_)
+        {
+            if (copy_policy_type::lazy)
+            {
+                // The storage has to be referenced before the owners are, or
+                // a concurrent copy of other could hide a view of it.
+                storage = other.view_.storage_;
+                owners = other.acquire_owners();
+
+                // Each owner holds one reference to the storage; any others
+                // are held by views.
+                if (storage.use_count() == owners.use_count())
+                    copy_policy_type::deferred(storage_bytes(*storage));
+
+                else
+                {
+                    storage.reset();
+                    owners.reset();
+                }
+            }
+
+            if (!storage)
+                storage = view_.create_storage(*other.view_.storage_);
+        }
+
+        view_.storage_ = storage;
+        owners_ = owners;
+    }
+
+    /// Duplicates the storage if it is shared with other matrices. Called by
+    /// each of the non-const member functions which give access to the
+    /// elements, and by view() const, as a copy of the view it returns could
+    /// be used to write to them. A matrix which doesn't share its storage is
+    /// left untouched, so that threads can read it through view() const at
+    /// the same time.
+    void unshare() const
+    {
+        if (copy_policy_type::lazy && owners_ && 1 < owners_.use_count())
+        {
+            view_.storage_ = view_.create_storage(*view_.storage_);
+            copy_policy_type::materialized(storage_bytes(*view_.storage_));
+
+            owners_.reset();
+        }
+    }
+
+    static boost::uint64_t storage_bytes(
+        storage_type const& storage
+        )
+    {
+        return sizeof(value_type) * storage.size();
     }
 
   public:
@@ -88,6 +190,27 @@ struct local_matrix
       : view_(rows, cols, init, offsets, alloc) 
     {} 
 
+    local_matrix(
+        size_type rows
+      , size_type cols
+      , const_reference init
+      , first_touch_t
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+      , allocator_type const& alloc = allocator_type()
+        )
+      : view_(rows, cols, init, first_touch, offsets, alloc)
+    {}
+
+    local_matrix(
+        size_type rows
+      , size_type cols
+      , uninitialized_t
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+      , allocator_type const& alloc = allocator_type()
+        )
+      : view_(rows, cols, uninitialized, offsets, alloc)
+    {}
+
     local_matrix(
         local_matrix const& other
         )
@@ -97,12 +220,7 @@ struct local_matrix
         view_.offsets_ = other.view_.offsets_;
         view_.alloc_ = other.view_.alloc_;
 
-        if (  other.view_.bounds_.rows
-           && other.view_.bounds_.cols
-           && other.view_.storage_)
-        {
-            view_.storage_ = view_.create_storage(*other.view_.storage_);
-        }
+        copy_storage(other);
     }
 
     local_matrix(
@@ -116,12 +234,7 @@ struct local_matrix
         view_.offsets_ = offsets; 
         view_.alloc_ = other.view_.alloc_;
 
-        if (  other.view_.bounds_.rows
-           && other.view_.bounds_.cols
-           && other.view_.storage_)
-        {
-            view_.storage_ = view_.create_storage(*other.view_.storage_);
-        }
+        copy_storage(other);
     }
 
     local_matrix(
@@ -134,20 +247,41 @@ struct local_matrix
         view_.offsets_ = offsets; 
         view_.alloc_ = other.view_.alloc_;
 
-        if (  other.view_.bounds_.rows
-           && other.view_.bounds_.cols
-           && other.view_.storage_)
-        {
-            view_.storage_ = view_.create_storage(*other.view_.storage_);
-        }
+        copy_storage(other);
     }
 
+    local_matrix(
+        BOOST_RV_REF(storage_type) storage
+      , size_type rows
+      , size_type cols = 1
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+      , allocator_type const& alloc = allocator_type()
+        )
+      : view_(boost::move(storage), rows, cols, offsets, alloc) 
+    {} 
+
     // REVIEW: Is this correctly implemented?
     local_matrix(
         BOOST_RV_REF(local_matrix) other
         )
       : view_(boost::move(other.view_)) 
-    {}
+      , owners_(other.owners_)
+    {
+        other.owners_.reset();
+    }
+
+    /// Takes ownership of the storage of \a other, and gives the new matrix
+    /// the offsets \a offsets.
+    local_matrix(
+        BOOST_RV_REF(local_matrix) other
+      , matrix_offsets offsets
+        )
+      : view_(boost::move(other.view_)) 
+      , owners_(other.owners_)
+    {
+        other.owners_.reset();
+        view_.offsets_ = offsets;
+    }
 
     local_matrix& operator=(
         BOOST_COPY_ASSIGN_REF(local_matrix) other
@@ -158,15 +292,7 @@ struct local_matrix
         view_.offsets_ = other.view_.offsets_;
         view_.alloc_ = other.view_.alloc_;
 
-        if (  other.view_.bounds_.rows
-           && other.view_.bounds_.cols
-           && other.view_.storage_)
-        {
-            view_.storage_ = view_.create_storage(*other.view_.storage_);
-        }
-
-        else
-            view_.storage_.reset();
+        copy_storage(other);
 
         return *this;
     }
@@ -177,6 +303,8 @@ struct local_matrix
         )
     {
         view_ = boost::move(other.view_);
+        owners_ = other.owners_;
+        other.owners_.reset();
 
         return *this;
     }
@@ -186,6 +314,8 @@ struct local_matrix
       , size_type col
         )
     {
+        unshare();
+
         return view_(row, col);
     }
 
@@ -193,6 +323,8 @@ struct local_matrix
         size_type row
         )
     {
+        unshare();
+
         return view_(row);
     }
 
@@ -231,8 +363,25 @@ struct local_matrix
         return view_.empty();
     }
 
+    allocator_type get_allocator() const
+    {
+        return view_.get_allocator();
+    }
+
+    /// Returns true if this matrix views all of its storage, in which case
+    /// the storage can be sent as it is (see storage_buffer).
+    bool whole() const
+    {
+        return view_.extents_.rows == view_.bounds_.rows
+            && view_.extents_.cols == view_.bounds_.cols
+            && 0 == view_.offsets_.rows
+            && 0 == view_.offsets_.cols;
+    }
+
     pointer data()
     {
+        unshare();
+
         return view_.data();
     }
 
@@ -251,6 +400,19 @@ struct local_matrix
         return view_.leading_dimension();
     }
 
+    matrix_bounds tile_extents(
+        size_type row
+      , size_type col
+        ) const
+    {
+        return view_.tile_extents(row, col);
+    }
+
+    matrix_bounds tile_bounds() const
+    {
+        return view_.tile_bounds();
+    }
+
     blas::index_order index_order() const
     {
         return view_.index_order(); 
@@ -258,11 +420,15 @@ struct local_matrix
 
     view_type& view()
     {
+        unshare();
+
         return view_; 
     }
 
     view_type const& view() const
     {
+        unshare();
+
         return view_;
     }
 };
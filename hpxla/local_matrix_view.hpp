@@ -11,8 +11,10 @@
 #include <hpxla/local_fwd.hpp>
 #include <hpxla/matrix_dimensions.hpp>
 #include <hpxla/local_blas/blas_enums.hpp>
+#include <hpxla/tiling.hpp>
 
 #include <vector>
+#include <algorithm>
 #include <initializer_list>
 
 #include <boost/assert.hpp>
@@ -20,11 +22,61 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/serialization/serialization.hpp>
+#include <boost/serialization/array.hpp>
 #include <boost/serialization/split_member.hpp>
 
 namespace hpxla
 {
 
+namespace detail
+{
+
+/// Sets each element of a tile of a matrix to the same value, in the order in
+/// which the elements are stored.
+template <
+    typename View
+>
+struct fill_tile
+{
+    typedef void result_type;
+
+    fill_tile(
+        View const& v
+      , typename View::const_reference init
+        )
+      : v_(v)
+      , init_(init)
+    {}
+
+    void operator()(
+        matrix_bounds start
+      , matrix_bounds extents
+        )
+    {
+        typedef typename View::size_type size_type;
+
+        if (blas::column_major == v_.index_order())
+        {
+            for (size_type j = 0; j < extents.cols; ++j)
+                for (size_type i = 0; i < extents.rows; ++i)
+                    v_(start.rows + i, start.cols + j) = init_;
+        }
+
+        else
+        {
+            for (size_type i = 0; i < extents.rows; ++i)
+                for (size_type j = 0; j < extents.cols; ++j)
+                    v_(start.rows + i, start.cols + j) = init_;
+        }
+    }
+
+  private:
+    View v_;
+    typename View::value_type init_;
+};
+
+}
+
 // TODO: Container compatible.
 template <
     typename T
@@ -46,20 +98,19 @@ struct local_matrix_view
     typedef boost::uint64_t size_type;
 
     typedef Policy policy_type;
-    typedef typename Policy::indexing_policy_type indexing_policy_type;
+    typedef typename policy::bind_indexing<
+        typename Policy::indexing_policy_type, value_type
+    >::type indexing_policy_type;
     typedef typename Policy::allocation_policy_type allocation_policy_type;
 
     typedef typename allocation_policy_type::template rebind<value_type>::other
         allocator_type;
 
+    typedef std::vector<value_type, allocator_type> storage_type;
+
   private:
     BOOST_COPYABLE_AND_MOVABLE(local_matrix_view);
 
-    typedef std::vector<
-        value_type
-      , typename allocation_policy_type::template rebind<value_type>::other
-    > storage_type;
-
     boost::shared_ptr<storage_type> storage_; 
 
     matrix_bounds bounds_;   // Actual dimensions of the subject matrix.
@@ -68,20 +119,35 @@ struct local_matrix_view
 
     allocator_type alloc_;
 
+    // The storage, and the shared_ptr's control block, both come from alloc_.
     boost::shared_ptr<storage_type> create_storage(
         size_type size
       , const_reference init = value_type()
         )
     {
         // REVIEW: Use boost::move here?
-        return boost::allocate_shared<storage_type>(alloc_, size, init);
+        return boost::allocate_shared<storage_type>(alloc_, size, init, alloc_);
+    }
+
+    // Constructs the elements the way that alloc_ constructs them without a
+    // value, which leaves them uninitialized with a default_init_allocator.
+    boost::shared_ptr<storage_type> create_default_storage(
+        size_type size
+        )
+    {
+#if defined(BOOST_NO_CXX11_ALLOCATOR)
+        return create_storage(size);
+#else
+        return boost::allocate_shared<storage_type>(alloc_, size, alloc_);
+#endif
     }
 
     boost::shared_ptr<storage_type> create_storage(
         storage_type const& s
         )
     {
-        return boost::allocate_shared<storage_type>(alloc_, s);
+        return boost::allocate_shared<storage_type>(alloc_
+          , s.begin(), s.end(), alloc_);
     }
 
     boost::shared_ptr<storage_type> create_storage(
@@ -96,6 +162,61 @@ struct local_matrix_view
 
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 
+    /// Serializes the elements of \a v, one contiguous block of storage at a
+    /// time. The elements are visited in index_order(), and the archive holds
+    /// them densely packed, so the result does not depend on the bounds,
+    /// offsets or tiling of the view. Each block is copied into (or out of)
+    /// the archive's buffer; storage_buffer sends the storage of a whole
+    /// matrix in one piece instead.
+    template <
+        typename Archive
+      , typename View
+    >
+    static void serialize_elements(
+        Archive& ar
+      , View& v
+        )
+    {
+        if (0 == v.size())
+            return;
+
+        bool const column_major = blas::column_major == v.index_order();
+
+        matrix_bounds t = v.tile_extents(0, 0);
+
+        // If the view is a single dense block (for example, a whole column-
+        // or row-major matrix), write it in one go.
+        if (  t.rows == v.rows()
+           && t.cols == v.columns()
+           && v.leading_dimension() == (column_major ? v.rows() : v.columns()))
+        {
+            ar & boost::serialization::make_array(&v(0, 0), v.size());
+            return;
+        }
+
+        // Otherwise, write one block for each contiguous part of a column (or
+        // row, for row-major matrices).
+        if (column_major)
+        {
+            for (size_type j = 0; j < v.columns(); ++j)
+                for (size_type i = 0; i < v.rows(); i += t.rows)
+                {
+                    t = v.tile_extents(i, j);
+                    ar & boost::serialization::make_array(&v(i, j), t.rows);
+                }
+        }
+
+        else
+        {
+            for (size_type i = 0; i < v.rows(); ++i)
+                for (size_type j = 0; j < v.columns(); j += t.cols)
+                {
+                    t = v.tile_extents(i, j);
+                    ar & boost::serialization::make_array(&v(i, j), t.cols);
+                }
+        }
+    }
+
     template <
         typename Archive
     >
@@ -106,11 +227,7 @@ struct local_matrix_view
     {
         ar & extents_;
 
-        // REVIEW: Will the serialized data be smaller if we serialize this as
-        // a contigous block of memory (e.g. array?).
-        for (size_type i = 0; i < rows(); ++i)
-            for (size_type j = 0; j < columns(); ++j)
-                ar & (*this)(i, j); 
+        serialize_elements(ar, *this);
     }
 
     template <
@@ -126,11 +243,12 @@ struct local_matrix_view
         bounds_ = extents_;
         offsets_.rows = offsets_.cols = 0;
 
-        storage_ = create_storage(bounds_.rows * bounds_.cols);
+        // Every element is read from the archive, so there's no need to
+        // initialize them first.
+        storage_ = create_default_storage(
+            indexing_policy_type::storage_size(bounds_));
 
-        for (size_type i = 0; i < rows(); ++i)
-            for (size_type j = 0; j < columns(); ++j)
-                ar & (*this)(i, j); 
+        serialize_elements(ar, *this);
     }
 
   public:
@@ -161,7 +279,8 @@ struct local_matrix_view
             bounds_.rows = extents_.rows = m.size();
             bounds_.cols = extents_.cols = (*m.begin()).size();
 
-            storage_ = create_storage(bounds_.rows * bounds_.cols);
+            storage_ = create_storage(
+                indexing_policy_type::storage_size(bounds_));
 
             typedef typename std::initializer_list<
                 std::vector<value_type>
@@ -197,7 +316,8 @@ struct local_matrix_view
             bounds_.rows = extents_.rows = v.size();
             bounds_.cols = extents_.cols = 1;
 
-            storage_ = create_storage(bounds_.rows);
+            storage_ = create_storage(
+                indexing_policy_type::storage_size(bounds_));
 
             typedef typename std::initializer_list<
                 value_type
@@ -228,9 +348,85 @@ struct local_matrix_view
       , alloc_(alloc)
     {
         if (rows && cols)
-            storage_ = create_storage(rows * cols, init);
+            storage_ = create_storage(
+                indexing_policy_type::storage_size(bounds_), init);
     } 
 
+    /// Construct a new matrix with dimensions \a rows x \a cols. Each element
+    /// of the matrix is initialized to \a init by HPX tasks, one task_tile()
+    /// at a time, like the tiled kernels process the matrix. If the
+    /// allocation policy leaves the storage uninitialized (see
+    /// policy::default_init_allocator), each page is first touched, and so
+    /// placed on the NUMA node of, one of the threads that later work on it.
+    local_matrix_view(
+        size_type rows
+      , size_type cols
+      , const_reference init
+      , first_touch_t
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+      , allocator_type const& alloc = allocator_type()
+        )
+      : bounds_(rows, cols)
+      , extents_(rows, cols)
+      , offsets_(0, 0)
+      , alloc_(alloc)
+    {
+        if (rows && cols)
+        {
+            storage_ = create_default_storage(
+                indexing_policy_type::storage_size(bounds_));
+
+            for_each_tile(bounds_, task_tile(tile_bounds())
+              , detail::fill_tile<local_matrix_view>(*this, init));
+        }
+
+        offsets_ = offsets;
+    }
+
+    /// Construct a new matrix with dimensions \a rows x \a cols, for callers
+    /// which write every element before reading it. If the allocation policy
+    /// default-initializes (see policy::default_init_allocator), the elements
+    /// of a trivial \a T are left uninitialized, which saves a pass over the
+    /// storage; otherwise they are value-initialized.
+    local_matrix_view(
+        size_type rows
+      , size_type cols
+      , uninitialized_t
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+      , allocator_type const& alloc = allocator_type()
+        )
+      : bounds_(rows, cols)
+      , extents_(rows, cols)
+      , offsets_(offsets)
+      , alloc_(alloc)
+    {
+        if (rows && cols)
+            storage_ = create_default_storage(
+                indexing_policy_type::storage_size(bounds_));
+    }
+
+    /// Construct a new matrix with dimensions \a rows x \a cols which takes
+    /// ownership of \a storage without copying or reallocating it. The
+    /// elements in \a storage must be laid out as the indexing policy expects.
+    local_matrix_view(
+        BOOST_RV_REF(storage_type) storage
+      , size_type rows
+      , size_type cols = 1
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+      , allocator_type const& alloc = allocator_type()
+        )
+      : bounds_(rows, cols)
+      , extents_(rows, cols)
+      , offsets_(offsets)
+      , alloc_(alloc)
+    {
+        BOOST_ASSERT(storage.size()
+                  == indexing_policy_type::storage_size(bounds_));
+
+        if (rows && cols)
+            storage_ = create_storage(boost::move(storage));
+    }
+
     /// Construct a new view of the matrix pointed to by \a other.
     local_matrix_view(
         local_matrix_view const& other
@@ -377,6 +573,11 @@ struct local_matrix_view
         return !storage_;
     }
 
+    allocator_type get_allocator() const
+    {
+        return alloc_;
+    }
+
     pointer data()
     {
         return indexing_policy_type::compute_pointer
@@ -399,6 +600,45 @@ struct local_matrix_view
         return indexing_policy_type::leading_dimension(bounds_);
     }
 
+    /// Returns the dimensions of the largest block of this view which starts
+    /// at (\a row, \a col) and is stored contiguously, with a leading
+    /// dimension of leading_dimension(). The block starts at 
+    /// &(*this)(row, col).
+    matrix_bounds tile_extents(
+        size_type row
+      , size_type col
+        ) const
+    {
+        BOOST_ASSERT(row < extents_.rows);
+        BOOST_ASSERT(col < extents_.cols);
+
+        matrix_bounds const t = indexing_policy_type::tile_extents
+            (row, col, bounds_, offsets_);
+
+        return matrix_bounds((std::min)(t.rows, extents_.rows - row)
+                           , (std::min)(t.cols, extents_.cols - col));
+    }
+
+    /// Returns true if this view lies within a single tile of storage, so that
+    /// data() and leading_dimension() describe all of it. Views of matrices
+    /// which aren't tiled always do.
+    bool in_single_tile() const
+    {
+        if (empty())
+            return true;
+
+        matrix_bounds const t = tile_extents(0, 0);
+
+        return t.rows == extents_.rows && t.cols == extents_.cols;
+    }
+
+    /// Returns the dimensions of the tiles that the subject matrix is stored
+    /// in.
+    matrix_bounds tile_bounds() const
+    {
+        return indexing_policy_type::tile_bounds(bounds_);
+    }
+
     blas::index_order index_order() const
     {
         return indexing_policy_type::order();
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_8E2B47D1_90C3_4F6A_B5E8_61D0A4C7F392)
+#define HPXLA_8E2B47D1_90C3_4F6A_B5E8_61D0A4C7F392
+
+#include <hpxla/local_matrix.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#if defined(__linux__)
+    #include <unistd.h>
+    #include <sys/syscall.h>
+#endif
+
+namespace hpxla
+{
+
+/// Where the pages of a range of memory are.
+struct page_placement
+{
+    page_placement()
+      : unplaced(0)
+      , unknown(0)
+    {}
+
+    /// The number of pages on each NUMA node.
+    std::vector<boost::uint64_t> nodes;
+
+    /// The number of pages which haven't been touched yet, and so aren't on
+    /// any node.
+    boost::uint64_t unplaced;
+
+    /// The number of pages whose placement couldn't be queried (on systems
+    /// other than Linux, this is all of them).
+    boost::uint64_t unknown;
+
+    boost::uint64_t pages() const
+    {
+        boost::uint64_t n = unplaced + unknown;
+
+        for (std::size_t k = 0; k < nodes.size(); ++k)
+            n += nodes[k];
+
+        return n;
+    }
+};
+
+/// Returns the NUMA nodes of the pages which hold the \a bytes bytes at \a p.
+/// The query does not touch the pages, so it doesn't change their placement.
+inline page_placement get_page_placement(
+    void const* p
+  , std::size_t bytes
+    )
+{
+    page_placement placement;
+
+    if (0 == bytes)
+        return placement;
+
+#if defined(__linux__) && defined(SYS_move_pages)
+    std::size_t const page_size = ::sysconf(_SC_PAGESIZE);
+#else
+    std::size_t const page_size = 4096;
+#endif
+
+    std::size_t const first = reinterpret_cast<std::size_t>(p) / page_size;
+    std::size_t const last
+        = (reinterpret_cast<std::size_t>(p) + bytes - 1) / page_size;
+
+    std::size_t const count = last - first + 1;
+
+#if defined(__linux__) && defined(SYS_move_pages)
+    // move_pages() with no target nodes only reports where each page is.
+    // Pages are queried in batches, to bound the size of the buffers.
+    std::size_t const batch = 4096;
+
+    std::vector<void*> pages;
+    std::vector<int> status;
+
+    for (std::size_t k = 0; k < count; k += batch)
+    {
+        std::size_t const n = (std::min)(batch, count - k);
+
+        pages.resize(n);
+        status.assign(n, 0);
+
+        for (std::size_t i = 0; i < n; ++i)
+            pages[i] = reinterpret_cast<void*>((first + k + i) * page_size);
+
+        if (0 != ::syscall(SYS_move_pages, 0, n, &pages[0], 0, &status[0], 0))
+        {
+            placement.unknown += n;
+            continue;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (0 <= status[i])
+            {
+                if (placement.nodes.size() <= std::size_t(status[i]))
+                    placement.nodes.resize(status[i] + 1, 0);
+
+                ++placement.nodes[status[i]];
+            }
+
+            // -ENOENT: the page isn't mapped to memory yet.
+            else if (-2 == status[i])
+                ++placement.unplaced;
+
+            else
+                ++placement.unknown;
+        }
+    }
+#else
+    placement.unknown = count;
+#endif
+
+    return placement;
+}
+
+/// Returns the NUMA nodes of the pages of the storage of \a m, which must be
+/// a whole matrix (e.g. not a view with offsets).
+template <
+    typename T
+  , typename Policy
+>
+inline page_placement get_page_placement(
+    local_matrix<T, Policy> const& m
+    )
+{
+    typedef typename local_matrix<T, Policy>::indexing_policy_type
+        indexing_policy_type;
+
+    if (m.empty())
+        return page_placement();
+
+    return get_page_placement(m.data(), sizeof(T)
+      * indexing_policy_type::storage_size(matrix_bounds(m.rows()
+                                                       , m.columns())));
+}
+
+}
+
+#endif // HPXLA_8E2B47D1_90C3_4F6A_B5E8_61D0A4C7F392
+
@@ -12,6 +12,9 @@
 
 #include <hpxla/policies/indexing_policies.hpp>
 #include <hpxla/policies/partitioning_policies.hpp>
+#include <hpxla/policies/distribution_policies.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+#include <hpxla/policies/copy_policies.hpp>
 
 #endif // HPXLA_E6746F85_9146_453B_93D0_705AEAF1F9AF
 
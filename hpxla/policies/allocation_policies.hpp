@@ -0,0 +1,866 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_3F0D6A2E_57C1_4B8E_9E36_1D4C8B0A92F7)
+#define HPXLA_3F0D6A2E_57C1_4B8E_9E36_1D4C8B0A92F7
+
+#include <hpxla/policies_fwd.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/atomic.hpp>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+namespace hpxla { namespace policy
+{
+
+/// A snapshot of the counters of an allocator. A hit is an allocation that
+/// was served without going to the global heap; a miss is one that wasn't.
+struct allocation_statistics
+{
+    allocation_statistics()
+      : hits(0)
+      , misses(0)
+      , releases(0)
+      , overflows(0)
+    {}
+
+    boost::uint64_t hits;
+    boost::uint64_t misses;
+
+    /// Deallocations that were kept for reuse.
+    boost::uint64_t releases;
+
+    /// Deallocations that were returned to the global heap.
+    boost::uint64_t overflows;
+
+    double hit_rate() const
+    {
+        if (0 == hits + misses)
+            return 0.0;
+
+        return double(hits) / double(hits + misses);
+    }
+};
+
+namespace detail
+{
+
+struct allocation_counters
+{
+    allocation_counters()
+      : hits(0)
+      , misses(0)
+      , releases(0)
+      , overflows(0)
+    {}
+
+    allocation_statistics load() const
+    {
+        allocation_statistics s;
+        s.hits = hits.load(boost::memory_order_relaxed);
+        s.misses = misses.load(boost::memory_order_relaxed);
+        s.releases = releases.load(boost::memory_order_relaxed);
+        s.overflows = overflows.load(boost::memory_order_relaxed);
+        return s;
+    }
+
+    void reset()
+    {
+        hits.store(0, boost::memory_order_relaxed);
+        misses.store(0, boost::memory_order_relaxed);
+        releases.store(0, boost::memory_order_relaxed);
+        overflows.store(0, boost::memory_order_relaxed);
+    }
+
+    static void increment(boost::atomic<boost::uint64_t>& counter)
+    {
+        counter.fetch_add(1, boost::memory_order_relaxed);
+    }
+
+    boost::atomic<boost::uint64_t> hits;
+    boost::atomic<boost::uint64_t> misses;
+    boost::atomic<boost::uint64_t> releases;
+    boost::atomic<boost::uint64_t> overflows;
+};
+
+/// The free blocks of one OS-thread. Blocks are sorted into size classes of
+/// 2^(min_shift + k) bytes; each class caches at most cache_bytes worth of
+/// blocks (but at least one block), and blocks larger than the largest class
+/// always come from the global heap.
+///
+/// A block may be freed by a different OS-thread than the one which allocated
+/// it (e.g. when an HPX thread migrates); it then goes to the free list of
+/// the thread that frees it.
+struct memory_pool : boost::noncopyable
+{
+    enum
+    {
+        min_shift = 4,  // 16 bytes.
+        max_shift = 24, // 16 MiB.
+        classes = max_shift - min_shift + 1,
+        cache_bytes = 4 * 1024 * 1024
+    };
+
+    memory_pool()
+    {
+        for (std::size_t k = 0; k < classes; ++k)
+        {
+            heads[k] = 0;
+            counts[k] = 0;
+        }
+    }
+
+    ~memory_pool()
+    {
+        for (std::size_t k = 0; k < classes; ++k)
+        {
+            while (heads[k])
+            {
+                free_block* next = heads[k]->next;
+                ::operator delete(heads[k]);
+                heads[k] = next;
+            }
+        }
+    }
+
+    /// Returns the pool of the calling OS-thread.
+    static memory_pool& local()
+    {
+        static boost::thread_specific_ptr<memory_pool> pools;
+
+        memory_pool* p = pools.get();
+
+        if (!p)
+        {
+            p = new memory_pool;
+            pools.reset(p);
+        }
+
+        return *p;
+    }
+
+    static allocation_counters& counters()
+    {
+        static allocation_counters c;
+        return c;
+    }
+
+    void* allocate(
+        std::size_t bytes
+        )
+    {
+        std::size_t const k = size_class(bytes);
+
+        if (k < classes && heads[k])
+        {
+            free_block* b = heads[k];
+            heads[k] = b->next;
+            --counts[k];
+
+            allocation_counters::increment(counters().hits);
+            return b;
+        }
+
+        allocation_counters::increment(counters().misses);
+        return ::operator new(k < classes ? block_size(k) : bytes);
+    }
+
+    void deallocate(
+        void* p
+      , std::size_t bytes
+        )
+    {
+        std::size_t const k = size_class(bytes);
+
+        if (k < classes && counts[k] < limit(k))
+        {
+            free_block* b = static_cast<free_block*>(p);
+            b->next = heads[k];
+            heads[k] = b;
+            ++counts[k];
+
+            allocation_counters::increment(counters().releases);
+            return;
+        }
+
+        allocation_counters::increment(counters().overflows);
+        ::operator delete(p);
+    }
+
+  private:
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    // Returns classes for blocks which are too large to pool.
+    static std::size_t size_class(
+        std::size_t bytes
+        )
+    {
+        std::size_t k = 0;
+
+        while (k < classes && block_size(k) < bytes)
+            ++k;
+
+        return k;
+    }
+
+    static std::size_t block_size(
+        std::size_t k
+        )
+    {
+        return std::size_t(1) << (min_shift + k);
+    }
+
+    static std::size_t limit(
+        std::size_t k
+        )
+    {
+        std::size_t const n = cache_bytes / block_size(k);
+        return n ? n : 1;
+    }
+
+    free_block* heads[classes];
+    std::size_t counts[classes];
+};
+
+}
+
+/// An allocator which keeps freed blocks in thread-local free lists, sorted
+/// into power-of-two size classes, and reuses them for later allocations of
+/// the same class. Short-lived temporaries of the same size (e.g. the output
+/// of repeated gemv calls, or per-task tiles) then stop hitting the global
+/// heap. All pool_allocators share the pools, so any two compare equal.
+template <
+    typename T
+>
+struct pool_allocator
+{
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <
+        typename U
+    >
+    struct rebind
+    {
+        typedef pool_allocator<U> other;
+    };
+
+    pool_allocator() {}
+
+    template <
+        typename U
+    >
+    pool_allocator(
+        pool_allocator<U> const&
+        )
+    {}
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(
+        size_type n
+      , void const* = 0
+        )
+    {
+        if (n > max_size())
+            throw std::bad_alloc();
+
+        return static_cast<pointer>(
+            detail::memory_pool::local().allocate(n * sizeof(T)));
+    }
+
+    void deallocate(
+        pointer p
+      , size_type n
+        )
+    {
+        detail::memory_pool::local().deallocate(p, n * sizeof(T));
+    }
+
+    size_type max_size() const
+    {
+        return size_type(-1) / sizeof(T);
+    }
+
+#if defined(BOOST_NO_CXX11_ALLOCATOR)
+    void construct(
+        pointer p
+      , const_reference x
+        )
+    {
+        ::new (static_cast<void*>(p)) T(x);
+    }
+
+    void destroy(
+        pointer p
+        )
+    {
+        p->~T();
+    }
+#endif
+
+    /// Returns the counters of all pool_allocators since the last call to
+    /// reset_statistics().
+    static allocation_statistics statistics()
+    {
+        return detail::memory_pool::counters().load();
+    }
+
+    static void reset_statistics()
+    {
+        detail::memory_pool::counters().reset();
+    }
+};
+
+template <
+    typename T
+  , typename U
+>
+inline bool operator==(
+    pool_allocator<T> const&
+  , pool_allocator<U> const&
+    )
+{
+    return true;
+}
+
+template <
+    typename T
+  , typename U
+>
+inline bool operator!=(
+    pool_allocator<T> const&
+  , pool_allocator<U> const&
+    )
+{
+    return false;
+}
+
+/// A region of memory which is handed out by bumping a pointer, and freed all
+/// at once when the arena is destroyed. Deallocating the memory at the top of
+/// the arena gives it back, so temporaries which are created and destroyed in
+/// LIFO order reuse the same memory. An arena must outlive everything
+/// allocated from it, and must not be used by more than one thread at a time.
+struct arena : boost::noncopyable
+{
+    /// Allocations are rounded up to, and aligned to, multiples of this.
+    enum { granularity = 16 };
+
+    /// Constructs an arena which gets memory from the global heap in chunks of
+    /// at least \a chunk_size bytes.
+    explicit arena(
+        std::size_t chunk_size = 1024 * 1024
+        )
+      : chunk_size_(chunk_size)
+      , first_(0)
+      , last_(0)
+    {}
+
+    ~arena()
+    {
+        release();
+    }
+
+    /// Returns \a bytes bytes aligned to \a alignment, which must be a power
+    /// of two.
+    void* allocate(
+        std::size_t bytes
+      , std::size_t alignment = granularity
+        )
+    {
+        BOOST_ASSERT(0 == (alignment & (alignment - 1)));
+
+        alignment = (std::max)(alignment, std::size_t(granularity));
+        bytes = round_up(bytes, granularity);
+
+        char* p = 0;
+
+        // The padding is checked against what is left of the chunk before it
+        // is added; with a large alignment, it can run past the end.
+        if (first_)
+        {
+            std::size_t const pad = padding(first_, alignment);
+            std::size_t const left = last_ - first_;
+
+            if (pad <= left && bytes <= left - pad)
+                p = first_ + pad;
+        }
+
+        if (!p)
+        {
+            // The rest of the current chunk is abandoned.
+            std::size_t const size
+                = (std::max)(chunk_size_, bytes + alignment);
+
+            first_ = static_cast<char*>(::operator new(size));
+            last_ = first_ + size;
+            chunks_.push_back(first_);
+
+            p = round_up(first_, alignment);
+
+            detail::allocation_counters::increment(counters_.misses);
+        }
+
+        else
+            detail::allocation_counters::increment(counters_.hits);
+
+        first_ = p + bytes;
+
+        return p;
+    }
+
+    void deallocate(
+        void* p
+      , std::size_t bytes
+        )
+    {
+        char* const q = static_cast<char*>(p);
+
+        if (q && q + round_up(bytes, granularity) == first_)
+        {
+            first_ = q;
+
+            detail::allocation_counters::increment(counters_.releases);
+        }
+
+        else
+            detail::allocation_counters::increment(counters_.overflows);
+    }
+
+    /// Frees all of the memory of the arena.
+    void release()
+    {
+        for (std::size_t i = 0; i < chunks_.size(); ++i)
+            ::operator delete(chunks_[i]);
+
+        chunks_.clear();
+        first_ = last_ = 0;
+    }
+
+    /// Returns the counters of this arena. Allocations which fit in the
+    /// current chunk are hits, and those which need a new chunk are misses.
+    /// Deallocations which give their memory back are releases, and the rest
+    /// are overflows.
+    allocation_statistics statistics() const
+    {
+        return counters_.load();
+    }
+
+    /// Returns the number of chunks that the arena has allocated.
+    std::size_t chunks() const
+    {
+        return chunks_.size();
+    }
+
+  private:
+    static std::size_t round_up(
+        std::size_t x
+      , std::size_t alignment
+        )
+    {
+        return (x + alignment - 1) & ~(alignment - 1);
+    }
+
+    /// Returns the number of bytes from \a p to the next multiple of
+    /// \a alignment.
+    static std::size_t padding(
+        char* p
+      , std::size_t alignment
+        )
+    {
+        std::size_t const x = reinterpret_cast<std::size_t>(p);
+        return round_up(x, alignment) - x;
+    }
+
+    static char* round_up(
+        char* p
+      , std::size_t alignment
+        )
+    {
+        return p + padding(p, alignment);
+    }
+
+    std::size_t const chunk_size_;
+
+    std::vector<char*> chunks_;
+
+    char* first_; // First free byte of the current chunk.
+    char* last_;  // End of the current chunk.
+
+    detail::allocation_counters counters_;
+};
+
+/// An allocator which gets its memory from an arena. A default constructed
+/// arena_allocator has no arena, and uses the global heap. Two
+/// arena_allocators compare equal if they use the same arena.
+template <
+    typename T
+>
+struct arena_allocator
+{
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <
+        typename U
+    >
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    arena_allocator() : arena_(0) {}
+
+    explicit arena_allocator(
+        policy::arena& a
+        )
+      : arena_(&a)
+    {}
+
+    template <
+        typename U
+    >
+    arena_allocator(
+        arena_allocator<U> const& other
+        )
+      : arena_(other.get_arena())
+    {}
+
+    policy::arena* get_arena() const
+    {
+        return arena_;
+    }
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(
+        size_type n
+      , void const* = 0
+        )
+    {
+        if (n > max_size())
+            throw std::bad_alloc();
+
+        if (!arena_)
+            return static_cast<pointer>(::operator new(n * sizeof(T)));
+
+        return static_cast<pointer>(
+            arena_->allocate(n * sizeof(T), boost::alignment_of<T>::value));
+    }
+
+    void deallocate(
+        pointer p
+      , size_type n
+        )
+    {
+        if (!arena_)
+            ::operator delete(p);
+        else
+            arena_->deallocate(p, n * sizeof(T));
+    }
+
+    size_type max_size() const
+    {
+        return size_type(-1) / sizeof(T);
+    }
+
+#if defined(BOOST_NO_CXX11_ALLOCATOR)
+    void construct(
+        pointer p
+      , const_reference x
+        )
+    {
+        ::new (static_cast<void*>(p)) T(x);
+    }
+
+    void destroy(
+        pointer p
+        )
+    {
+        p->~T();
+    }
+#endif
+
+  private:
+    policy::arena* arena_;
+};
+
+template <
+    typename T
+  , typename U
+>
+inline bool operator==(
+    arena_allocator<T> const& x
+  , arena_allocator<U> const& y
+    )
+{
+    return x.get_arena() == y.get_arena();
+}
+
+template <
+    typename T
+  , typename U
+>
+inline bool operator!=(
+    arena_allocator<T> const& x
+  , arena_allocator<U> const& y
+    )
+{
+    return x.get_arena() != y.get_arena();
+}
+
+/// An allocator whose blocks start on a multiple of \a Alignment bytes, which
+/// must be a power of two. Use an alignment of 64 to start SIMD loads and
+/// BLAS columns on cache lines (together with padded_column_major_indexing),
+/// or 2 MiB to let large matrices be backed by transparent huge pages; on
+/// Linux, blocks of at least that size are advised to be.
+template <
+    typename T
+  , std::size_t Alignment
+>
+struct aligned_allocator
+{
+    BOOST_STATIC_ASSERT(0 == (Alignment & (Alignment - 1)));
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T const* const_pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <
+        typename U
+    >
+    struct rebind
+    {
+        typedef aligned_allocator<U, Alignment> other;
+    };
+
+    aligned_allocator() {}
+
+    template <
+        typename U
+    >
+    aligned_allocator(
+        aligned_allocator<U, Alignment> const&
+        )
+    {}
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    /// The block is carved out of a larger one from the global heap, and the
+    /// address of that is kept just before the block.
+    pointer allocate(
+        size_type n
+      , void const* = 0
+        )
+    {
+        if (n > max_size())
+            throw std::bad_alloc();
+
+        std::size_t const bytes = n * sizeof(T);
+
+        char* const base = static_cast<char*>(
+            ::operator new(bytes + alignment() + sizeof(void*)));
+
+        std::size_t const x
+            = reinterpret_cast<std::size_t>(base + sizeof(void*));
+
+        char* const p = base + sizeof(void*)
+                      + ((alignment() - (x & (alignment() - 1)))
+                         & (alignment() - 1));
+
+        reinterpret_cast<void**>(p)[-1] = base;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        std::size_t const huge_page = 2 * 1024 * 1024;
+
+        if (Alignment >= huge_page && bytes >= huge_page)
+            ::madvise(p, bytes & ~(huge_page - 1), MADV_HUGEPAGE);
+#endif
+
+        return reinterpret_cast<pointer>(p);
+    }
+
+    void deallocate(
+        pointer p
+      , size_type
+        )
+    {
+        if (p)
+            ::operator delete(reinterpret_cast<void**>(p)[-1]);
+    }
+
+    size_type max_size() const
+    {
+        return (size_type(-1) - alignment() - sizeof(void*)) / sizeof(T);
+    }
+
+#if defined(BOOST_NO_CXX11_ALLOCATOR)
+    void construct(
+        pointer p
+      , const_reference x
+        )
+    {
+        ::new (static_cast<void*>(p)) T(x);
+    }
+
+    void destroy(
+        pointer p
+        )
+    {
+        p->~T();
+    }
+#endif
+
+  private:
+    // The block must also be aligned for T, and leave room for the address
+    // of the larger block.
+    static std::size_t alignment()
+    {
+        std::size_t const a = (std::max)(Alignment
+          , std::size_t(boost::alignment_of<T>::value));
+        return (std::max)(a, std::size_t(boost::alignment_of<void*>::value));
+    }
+};
+
+template <
+    typename T
+  , typename U
+  , std::size_t Alignment
+>
+inline bool operator==(
+    aligned_allocator<T, Alignment> const&
+  , aligned_allocator<U, Alignment> const&
+    )
+{
+    return true;
+}
+
+template <
+    typename T
+  , typename U
+  , std::size_t Alignment
+>
+inline bool operator!=(
+    aligned_allocator<T, Alignment> const&
+  , aligned_allocator<U, Alignment> const&
+    )
+{
+    return false;
+}
+
+/// An adaptor for \a Allocator which default-initializes the elements that a
+/// container value-initializes. For types like float and double, a
+/// std::vector with n elements then leaves them uninitialized, instead of
+/// writing zeros to all of them, so the pages of the storage are first
+/// touched by whoever writes the elements (see hpxla::first_touch). Without
+/// C++11 allocator support, containers construct elements by copying, so
+/// this behaves like \a Allocator.
+template <
+    typename Allocator
+>
+struct default_init_allocator
+  : Allocator::template rebind<typename Allocator::value_type>::other
+{
+    typedef typename Allocator::template rebind<
+        typename Allocator::value_type
+    >::other base_type;
+
+    template <
+        typename U
+    >
+    struct rebind
+    {
+        typedef default_init_allocator<
+            typename Allocator::template rebind<U>::other
+        > other;
+    };
+
+    default_init_allocator() {}
+
+    default_init_allocator(
+        base_type const& a
+        )
+      : base_type(a)
+    {}
+
+    template <
+        typename Allocator0
+    >
+    default_init_allocator(
+        default_init_allocator<Allocator0> const& other
+        )
+      : base_type(other)
+    {}
+
+#if    !defined(BOOST_NO_CXX11_ALLOCATOR) \
+    && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) \
+    && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template <
+        typename U
+    >
+    void construct(
+        U* p
+        )
+    {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <
+        typename U
+      , typename... Args
+    >
+    void construct(
+        U* p
+      , Args&&... args
+        )
+    {
+        std::allocator_traits<base_type>::construct(
+            static_cast<base_type&>(*this), p, std::forward<Args>(args)...);
+    }
+#endif
+};
+
+}}
+
+#endif // HPXLA_3F0D6A2E_57C1_4B8E_9E36_1D4C8B0A92F7
+
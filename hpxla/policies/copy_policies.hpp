@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_5C2E9A71_0D4B_4F38_A6E1_B7F3928D40C6)
+#define HPXLA_5C2E9A71_0D4B_4F38_A6E1_B7F3928D40C6
+
+#include <hpxla/policies_fwd.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+namespace hpxla { namespace policy
+{
+
+/// A snapshot of the counters of copy_on_write. A deferred copy is a copy of
+/// a local_matrix which shares the storage of the original; it materializes
+/// when either of them is written to while they still share it.
+struct copy_statistics
+{
+    copy_statistics()
+      : deferred(0)
+      , materialized(0)
+      , deferred_bytes(0)
+      , materialized_bytes(0)
+    {}
+
+    boost::uint64_t deferred;
+    boost::uint64_t materialized;
+
+    boost::uint64_t deferred_bytes;
+    boost::uint64_t materialized_bytes;
+
+    /// The number of bytes which deferred copies have not (yet) allocated.
+    boost::uint64_t saved_bytes() const
+    {
+        return deferred_bytes - materialized_bytes;
+    }
+};
+
+/// Copies of a local_matrix duplicate its storage immediately.
+struct deep_copy
+{
+    enum { lazy = false };
+
+    static void deferred(
+        boost::uint64_t
+        )
+    {}
+
+    static void materialized(
+        boost::uint64_t
+        )
+    {}
+};
+
+/// Copies of a local_matrix share its storage until the copy or the original
+/// is accessed through a non-const member function (e.g. operator(), data()
+/// or view()), or its view is taken through view() const, whose copies could
+/// be written to; the storage is duplicated then, if it is still shared. This
+/// makes copies which are only read, such as matrices which are stored in
+/// containers or passed by value, as cheap as copying a shared_ptr.
+///
+/// A matrix is copied eagerly while views of it exist, as they may be used to
+/// write to it. References and pointers to the elements of a matrix (and the
+/// reference returned by view()) must not be used to write to it after it has
+/// been copied.
+struct copy_on_write
+{
+    enum { lazy = true };
+
+    static copy_statistics statistics()
+    {
+        copy_statistics s;
+        s.deferred = counters().deferred.load(boost::memory_order_relaxed);
+        s.materialized
+            = counters().materialized.load(boost::memory_order_relaxed);
+        s.deferred_bytes
+            = counters().deferred_bytes.load(boost::memory_order_relaxed);
+        s.materialized_bytes
+            = counters().materialized_bytes.load(boost::memory_order_relaxed);
+        return s;
+    }
+
+    static void reset_statistics()
+    {
+        counters().deferred.store(0, boost::memory_order_relaxed);
+        counters().materialized.store(0, boost::memory_order_relaxed);
+        counters().deferred_bytes.store(0, boost::memory_order_relaxed);
+        counters().materialized_bytes.store(0, boost::memory_order_relaxed);
+    }
+
+    static void deferred(
+        boost::uint64_t bytes
+        )
+    {
+        counters().deferred.fetch_add(1, boost::memory_order_relaxed);
+        counters().deferred_bytes.fetch_add(bytes
+                                          , boost::memory_order_relaxed);
+    }
+
+    static void materialized(
+        boost::uint64_t bytes
+        )
+    {
+        counters().materialized.fetch_add(1, boost::memory_order_relaxed);
+        counters().materialized_bytes.fetch_add(bytes
+                                              , boost::memory_order_relaxed);
+    }
+
+  private:
+    struct copy_counters
+    {
+        copy_counters()
+          : deferred(0)
+          , materialized(0)
+          , deferred_bytes(0)
+          , materialized_bytes(0)
+        {}
+
+        boost::atomic<boost::uint64_t> deferred;
+        boost::atomic<boost::uint64_t> materialized;
+        boost::atomic<boost::uint64_t> deferred_bytes;
+        boost::atomic<boost::uint64_t> materialized_bytes;
+    };
+
+    static copy_counters& counters()
+    {
+        static copy_counters c;
+        return c;
+    }
+};
+
+}}
+
+#endif // HPXLA_5C2E9A71_0D4B_4F38_A6E1_B7F3928D40C6
+
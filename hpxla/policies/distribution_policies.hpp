@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_906DB7F6_939E_4DC1_9103_E44463846CE0)
+#define HPXLA_906DB7F6_939E_4DC1_9103_E44463846CE0
+
+#include <hpxla/matrix_dimensions.hpp>
+
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+namespace hpxla { namespace policy
+{
+
+/// ScaLAPACK-style 2D block-cyclic distribution. The matrix is cut into
+/// blocks of block_size() elements (the blocks in the last row and column of
+/// the grid may be smaller), and the blocks are dealt out cyclically over a
+/// process_grid() of localities: block (i, j) lives on process
+/// (i % process_grid().rows, j % process_grid().cols). Processes are numbered
+/// in row-major order.
+///
+/// Each locality owns blocks from every part of the matrix, so the work stays
+/// balanced when an algorithm only touches a shrinking trailing submatrix.
+struct block_cyclic_distribution
+{
+  private:
+    matrix_bounds process_grid_;
+    matrix_bounds block_size_;
+
+  public:
+    block_cyclic_distribution(
+        matrix_bounds process_grid = matrix_bounds(1, 1)
+      , matrix_bounds block_size = matrix_bounds(64, 64)
+        )
+      : process_grid_(process_grid)
+      , block_size_(block_size)
+    {
+        BOOST_ASSERT(process_grid_.rows && process_grid_.cols);
+        BOOST_ASSERT(block_size_.rows && block_size_.cols);
+    }
+
+    matrix_bounds process_grid() const
+    {
+        return process_grid_;
+    }
+
+    matrix_bounds block_size() const
+    {
+        return block_size_;
+    }
+
+    /// Returns the number of processes in the process grid.
+    boost::uint64_t processes() const
+    {
+        return process_grid_.rows * process_grid_.cols;
+    }
+
+    /// Returns the number of blocks in each row and column of the grid of
+    /// blocks of a matrix with dimensions \a bounds.
+    matrix_bounds grid_dimensions(
+        matrix_bounds bounds
+        ) const
+    {
+        return matrix_bounds((bounds.rows + block_size_.rows - 1)
+                                / block_size_.rows
+                           , (bounds.cols + block_size_.cols - 1)
+                                / block_size_.cols);
+    }
+
+    /// Returns the process which owns block (\a i, \a j).
+    boost::uint64_t process_of(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        return (i % process_grid_.rows) * process_grid_.cols
+             + (j % process_grid_.cols);
+    }
+
+    /// Returns the position in the grid of blocks of the block containing
+    /// element (\a row, \a col).
+    matrix_bounds block_index(
+        boost::uint64_t row
+      , boost::uint64_t col
+        ) const
+    {
+        return matrix_bounds(row / block_size_.rows, col / block_size_.cols);
+    }
+
+    /// Returns the position of the first element of block (\a i, \a j).
+    matrix_bounds block_offsets(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        return matrix_bounds(i * block_size_.rows, j * block_size_.cols);
+    }
+
+    /// Returns the dimensions of block (\a i, \a j) of a matrix with
+    /// dimensions \a bounds.
+    matrix_bounds block_extents(
+        boost::uint64_t i
+      , boost::uint64_t j
+      , matrix_bounds bounds
+        ) const
+    {
+        matrix_bounds const o = block_offsets(i, j);
+
+        BOOST_ASSERT(o.rows < bounds.rows);
+        BOOST_ASSERT(o.cols < bounds.cols);
+
+        return matrix_bounds(
+            (std::min)(block_size_.rows, bounds.rows - o.rows)
+          , (std::min)(block_size_.cols, bounds.cols - o.cols));
+    }
+};
+
+}}
+
+#endif // HPXLA_906DB7F6_939E_4DC1_9103_E44463846CE0
+
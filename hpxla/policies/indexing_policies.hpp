@@ -8,10 +8,15 @@
 #if !defined(HPXLA_951BCE80_0D7A_4AE5_85AB_2064E2E25DC3)
 #define HPXLA_951BCE80_0D7A_4AE5_85AB_2064E2E25DC3
 
+#include <hpxla/config.hpp>
+#include <hpxla/policies_fwd.hpp>
 #include <hpxla/local_blas/blas_enums.hpp>
 #include <hpxla/matrix_dimensions.hpp>
 
+#include <algorithm>
+
 #include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
 
 // TODO: Make sure negative offsets aren't larger than input indices.
 
@@ -52,6 +57,37 @@ struct column_major_indexing
         return blas::column_major;
     }
 
+    /// Returns the number of elements needed to store a matrix with
+    /// dimensions \a bounds.
+    static boost::uint64_t storage_size(
+        matrix_bounds bounds
+        )
+    {
+        return bounds.rows * bounds.cols;
+    }
+
+    /// Returns the dimensions of the storage tiles. The whole matrix is stored
+    /// as a single tile.
+    static matrix_bounds tile_bounds(
+        matrix_bounds bounds
+        )
+    {
+        return bounds;
+    }
+
+    /// Returns the dimensions of the part of the storage tile containing
+    /// (\a row, \a col) that starts at (\a row, \a col).
+    static matrix_bounds tile_extents(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        )
+    {
+        return matrix_bounds(bounds.rows - (row + offsets.rows)
+                           , bounds.cols - (col + offsets.cols));
+    }
+
     template <
         typename T
     >
@@ -99,6 +135,247 @@ struct row_major_indexing
         return blas::row_major;
     }
 
+    /// Returns the number of elements needed to store a matrix with
+    /// dimensions \a bounds.
+    static boost::uint64_t storage_size(
+        matrix_bounds bounds
+        )
+    {
+        return bounds.rows * bounds.cols;
+    }
+
+    /// Returns the dimensions of the storage tiles. The whole matrix is stored
+    /// as a single tile.
+    static matrix_bounds tile_bounds(
+        matrix_bounds bounds
+        )
+    {
+        return bounds;
+    }
+
+    /// Returns the dimensions of the part of the storage tile containing
+    /// (\a row, \a col) that starts at (\a row, \a col).
+    static matrix_bounds tile_extents(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        )
+    {
+        return matrix_bounds(bounds.rows - (row + offsets.rows)
+                           , bounds.cols - (col + offsets.cols));
+    }
+
+    template <
+        typename T
+    >
+    static T* compute_pointer(
+        T* base
+      , matrix_bounds bounds
+      , matrix_offsets offsets
+        )
+    { 
+        return base + index(0, 0, bounds, offsets);
+    }
+};
+
+namespace detail
+{
+
+/// Returns the smallest multiple of \a Multiple which is at least \a n,
+/// skipping those whose length in bytes, for elements of \a ElementSize
+/// bytes, is a multiple of HPXLA_CRITICAL_STRIDE. With those leading
+/// dimensions, consecutive columns (or rows) map to the same cache sets, and
+/// evict each other. If \a Multiple elements are themselves such a multiple,
+/// no padding can help.
+template <
+    boost::uint64_t Multiple
+  , std::size_t ElementSize
+>
+inline boost::uint64_t padded_dimension(
+    boost::uint64_t n
+    )
+{
+    BOOST_STATIC_ASSERT(0 < Multiple);
+    BOOST_STATIC_ASSERT(0 < ElementSize);
+
+    boost::uint64_t const stride = HPXLA_CRITICAL_STRIDE;
+
+    boost::uint64_t ld = ((n + Multiple - 1) / Multiple) * Multiple;
+
+    if ((Multiple * ElementSize) % stride == 0)
+        return ld;
+
+    while (ld != 0 && (ld * ElementSize) % stride == 0)
+        ld += Multiple;
+
+    return ld;
+}
+
+}
+
+/// Column-major indexing with a leading dimension of at least the number of
+/// rows, rounded up to a multiple of \a Multiple elements (and away from
+/// multiples of the critical stride, for elements of \a ElementSize bytes;
+/// local_matrix sets it to the size of its elements, see bind_indexing).
+/// When the storage is aligned to Multiple elements, e.g. with an
+/// aligned_allocator, every column starts on that alignment.
+template <
+    boost::uint64_t Multiple
+  , std::size_t ElementSize
+>
+struct padded_column_major_indexing
+{
+    static boost::uint64_t index(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        ) 
+    {
+        BOOST_ASSERT(row < bounds.rows);
+        BOOST_ASSERT(col < bounds.cols);
+
+        return (col + offsets.cols) * leading_dimension(bounds)
+             + (row + offsets.rows);
+    }
+
+    static boost::uint64_t leading_dimension(
+        matrix_bounds bounds
+        )
+    {
+        return detail::padded_dimension<Multiple, ElementSize>(bounds.rows);
+    }
+
+    static boost::uint64_t vector_stride(
+        matrix_bounds bounds
+        )
+    {
+        return 1;
+    }
+
+    static blas::index_order order()
+    {
+        return blas::column_major;
+    }
+
+    /// Returns the number of elements needed to store a matrix with
+    /// dimensions \a bounds, including the padding of each column.
+    static boost::uint64_t storage_size(
+        matrix_bounds bounds
+        )
+    {
+        return leading_dimension(bounds) * bounds.cols;
+    }
+
+    /// Returns the dimensions of the storage tiles. The whole matrix is stored
+    /// as a single tile.
+    static matrix_bounds tile_bounds(
+        matrix_bounds bounds
+        )
+    {
+        return bounds;
+    }
+
+    /// Returns the dimensions of the part of the storage tile containing
+    /// (\a row, \a col) that starts at (\a row, \a col).
+    static matrix_bounds tile_extents(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        )
+    {
+        return matrix_bounds(bounds.rows - (row + offsets.rows)
+                           , bounds.cols - (col + offsets.cols));
+    }
+
+    template <
+        typename T
+    >
+    static T* compute_pointer(
+        T* base
+      , matrix_bounds bounds
+      , matrix_offsets offsets
+        )
+    { 
+        return base + index(0, 0, bounds, offsets);
+    }
+};
+
+/// Row-major indexing with a leading dimension of at least the number of
+/// columns, rounded up to a multiple of \a Multiple elements (and away from
+/// multiples of the critical stride, as for padded_column_major_indexing).
+template <
+    boost::uint64_t Multiple
+  , std::size_t ElementSize
+>
+struct padded_row_major_indexing
+{
+    static boost::uint64_t index(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        )
+    {
+        BOOST_ASSERT(row < bounds.rows);
+        BOOST_ASSERT(col < bounds.cols);
+
+        return (row + offsets.rows) * leading_dimension(bounds)
+             + (col + offsets.cols);
+    }
+
+    static boost::uint64_t leading_dimension(
+        matrix_bounds bounds
+        )
+    {
+        return detail::padded_dimension<Multiple, ElementSize>(bounds.cols);
+    }
+
+    static boost::uint64_t vector_stride(
+        matrix_bounds bounds
+        )
+    {
+        return leading_dimension(bounds);
+    }
+
+    static blas::index_order order()
+    {
+        return blas::row_major;
+    }
+
+    /// Returns the number of elements needed to store a matrix with
+    /// dimensions \a bounds, including the padding of each row.
+    static boost::uint64_t storage_size(
+        matrix_bounds bounds
+        )
+    {
+        return bounds.rows * leading_dimension(bounds);
+    }
+
+    /// Returns the dimensions of the storage tiles. The whole matrix is stored
+    /// as a single tile.
+    static matrix_bounds tile_bounds(
+        matrix_bounds bounds
+        )
+    {
+        return bounds;
+    }
+
+    /// Returns the dimensions of the part of the storage tile containing
+    /// (\a row, \a col) that starts at (\a row, \a col).
+    static matrix_bounds tile_extents(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        )
+    {
+        return matrix_bounds(bounds.rows - (row + offsets.rows)
+                           , bounds.cols - (col + offsets.cols));
+    }
+
     template <
         typename T
     >
@@ -112,6 +389,126 @@ struct row_major_indexing
     }
 };
 
+/// Stores the matrix as a grid of fixed-size TileRows x TileCols tiles. Each
+/// tile is stored contiguously in column-major order with a leading dimension
+/// of TileRows, and the tiles are stored in column-major order. Tiles along the
+/// bottom and right edges of the matrix are padded to the full tile size.
+///
+/// data() and leading_dimension() describe the tile containing the first
+/// element of a view; tile_extents() gives the part of that tile which belongs
+/// to the view. The level 1 and 2 BLAS routines work on data() directly, so
+/// they require their operands to lie within a single tile, and assert that
+/// they do (see local_matrix_view::in_single_tile()).
+template <
+    boost::uint64_t TileRows
+  , boost::uint64_t TileCols
+>
+struct tiled_indexing
+{
+    BOOST_STATIC_ASSERT(0 < TileRows && 0 < TileCols);
+
+    static boost::uint64_t index(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        ) 
+    {
+        BOOST_ASSERT(row < bounds.rows);
+        BOOST_ASSERT(col < bounds.cols);
+
+        boost::uint64_t const r = row + offsets.rows;
+        boost::uint64_t const c = col + offsets.cols;
+
+        boost::uint64_t const tile
+            = (c / TileCols) * tile_grid_rows(bounds) + (r / TileRows);
+
+        return tile * TileRows * TileCols
+             + (c % TileCols) * TileRows + (r % TileRows);
+    }
+
+    static boost::uint64_t leading_dimension(
+        matrix_bounds bounds
+        )
+    {
+        return TileRows;
+    }
+
+    static boost::uint64_t vector_stride(
+        matrix_bounds bounds
+        )
+    {
+        return 1;
+    }
+
+    static blas::index_order order()
+    {
+        return blas::column_major;
+    }
+
+    /// Returns the number of elements needed to store a matrix with
+    /// dimensions \a bounds, including the padding of the edge tiles.
+    static boost::uint64_t storage_size(
+        matrix_bounds bounds
+        )
+    {
+        return tile_grid_rows(bounds) * TileRows
+             * tile_grid_cols(bounds) * TileCols;
+    }
+
+    /// Returns the dimensions of the storage tiles.
+    static matrix_bounds tile_bounds(
+        matrix_bounds bounds
+        )
+    {
+        return matrix_bounds(TileRows, TileCols);
+    }
+
+    /// Returns the dimensions of the part of the storage tile containing
+    /// (\a row, \a col) that starts at (\a row, \a col).
+    static matrix_bounds tile_extents(
+        boost::uint64_t row
+      , boost::uint64_t col
+      , matrix_bounds bounds
+      , matrix_offsets offsets = matrix_offsets(0, 0)
+        )
+    {
+        boost::uint64_t const r = row + offsets.rows;
+        boost::uint64_t const c = col + offsets.cols;
+
+        return matrix_bounds(
+            (std::min)(TileRows - r % TileRows, bounds.rows - r)
+          , (std::min)(TileCols - c % TileCols, bounds.cols - c));
+    }
+
+    template <
+        typename T
+    >
+    static T* compute_pointer(
+        T* base
+      , matrix_bounds bounds
+      , matrix_offsets offsets
+        )
+    { 
+        return base + index(0, 0, bounds, offsets);
+    }
+
+  private:
+    static boost::uint64_t tile_grid_rows(
+        matrix_bounds bounds
+        )
+    {
+        return (bounds.rows + TileRows - 1) / TileRows;
+    }
+
+    static boost::uint64_t tile_grid_cols(
+        matrix_bounds bounds
+        )
+    {
+        return (bounds.cols + TileCols - 1) / TileCols;
+    }
+};
+
 }}
 
 #endif // HPXLA_951BCE80_0D7A_4AE5_85AB_2064E2E25DC3
@@ -10,6 +10,11 @@
 
 #include <hpxla/local_matrix.hpp>
 
+#include <vector>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
 #if !defined(HPXLA_NO_LIBHPX)
     #include <hpx/runtime/naming/name.hpp>
 #endif
@@ -17,7 +22,57 @@
 namespace hpxla { namespace policy
 {
 
+namespace detail
+{
+
+// A dimension of extent n split into g blocks is divided as evenly as
+// possible: the first n % g blocks get one more element than the others.
+// Because of this, the block containing an index can be computed directly.
+
+inline boost::uint64_t block_extent(
+    boost::uint64_t block
+  , boost::uint64_t n
+  , boost::uint64_t g
+    )
+{
+    BOOST_ASSERT(block < g);
+    return n / g + (block < n % g ? 1 : 0);
+}
+
+inline boost::uint64_t block_offset(
+    boost::uint64_t block
+  , boost::uint64_t n
+  , boost::uint64_t g
+    )
+{
+    BOOST_ASSERT(block < g);
+    return block * (n / g) + (std::min)(block, n % g);
+}
+
+inline boost::uint64_t block_index(
+    boost::uint64_t x
+  , boost::uint64_t n
+  , boost::uint64_t g
+    )
+{
+    BOOST_ASSERT(x < n);
+
+    boost::uint64_t const q = n / g;
+    boost::uint64_t const r = n % g;
+
+    if (x < r * (q + 1))
+        return x / (q + 1);
+
+    return r + (x - r * (q + 1)) / q;
+}
+
+}
+
 #if !defined(HPXLA_NO_LIBHPX)
+    /// Splits a matrix into a grid of \a partitions blocks. The prime factors
+    /// of \a partitions are distributed between the rows and the columns of
+    /// the grid so that the blocks are as close to square as possible. Blocks
+    /// are numbered in column-major order.
     template <
         typename LocalMatrixPolicy  
     >
@@ -25,23 +80,107 @@ namespace hpxla { namespace policy
     {
         typedef local_matrix<boost::int64_t, LocalMatrixPolicy> offset_matrix;
         typedef local_matrix<hpx::naming::id_type, LocalMatrixPolicy> gid_matrix;
-    
+
+        /// Returns the number of blocks in each row and column of the grid.
+        static matrix_bounds grid_dimensions(
+            boost::uint64_t partitions
+          , matrix_bounds bounds
+            )
+        {
+            BOOST_ASSERT(0 < partitions);
+
+            std::vector<boost::uint64_t> factors;
+
+            for (boost::uint64_t f = 2; f * f <= partitions; ++f)
+                while (0 == partitions % f)
+                {
+                    factors.push_back(f);
+                    partitions /= f;
+                }
+
+            if (1 < partitions)
+                factors.push_back(partitions);
+
+            // Hand out the largest factors first, each to the dimension in
+            // which the blocks are currently longest.
+            matrix_bounds grid(1, 1);
+
+            for (std::size_t i = factors.size(); i != 0; --i)
+            {
+                if (bounds.rows * grid.cols >= bounds.cols * grid.rows)
+                    grid.rows *= factors[i - 1];
+                else
+                    grid.cols *= factors[i - 1];
+            }
+
+            return grid;
+        }
+
+        /// Returns the dimensions of the largest block. Blocks in the last
+        /// rows and columns of the grid may be one element smaller.
         static matrix_bounds submatrix_dimensions( 
             boost::uint64_t partitions
           , matrix_bounds bounds
             )
         {
-            // IMPLEMENT
-            return matrix_bounds();
+            matrix_bounds const grid = grid_dimensions(partitions, bounds);
+
+            return matrix_bounds(
+                detail::block_extent(0, bounds.rows, grid.rows)
+              , detail::block_extent(0, bounds.cols, grid.cols));
+        }
+
+        /// Returns the position in the grid \a grid of the block containing
+        /// element (\a row, \a col).
+        static matrix_bounds submatrix_index(
+            boost::uint64_t row
+          , boost::uint64_t col
+          , matrix_bounds grid
+          , matrix_bounds bounds
+            )
+        {
+            return matrix_bounds(
+                detail::block_index(row, bounds.rows, grid.rows)
+              , detail::block_index(col, bounds.cols, grid.cols));
+        }
+
+        /// Returns the dimensions of the block at (\a i, \a j) in the grid
+        /// \a grid.
+        static matrix_bounds submatrix_extents(
+            boost::uint64_t i
+          , boost::uint64_t j
+          , matrix_bounds grid
+          , matrix_bounds bounds
+            )
+        {
+            return matrix_bounds(
+                detail::block_extent(i, bounds.rows, grid.rows)
+              , detail::block_extent(j, bounds.cols, grid.cols));
         }
-    
+
+        /// Returns a \a partitions x 2 matrix. Row p holds the row and column
+        /// of the first element of block p.
         static offset_matrix create_offsets(
             boost::uint64_t partitions
           , matrix_bounds bounds
             )
         {
-            // IMPLEMENT
-            return offset_matrix();
+            matrix_bounds const grid = grid_dimensions(partitions, bounds);
+
+            offset_matrix offsets(partitions, 2);
+
+            for (boost::uint64_t j = 0; j < grid.cols; ++j)
+                for (boost::uint64_t i = 0; i < grid.rows; ++i)
+                {
+                    boost::uint64_t const p = j * grid.rows + i;
+
+                    offsets(p, 0)
+                        = detail::block_offset(i, bounds.rows, grid.rows);
+                    offsets(p, 1)
+                        = detail::block_offset(j, bounds.cols, grid.cols);
+                }
+
+            return offsets;
         }
     };
 #endif
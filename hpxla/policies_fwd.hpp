@@ -8,8 +8,11 @@
 #if !defined(HPXLA_9B468CF3_FEEA_4716_AB59_4C4329D65D85)
 #define HPXLA_9B468CF3_FEEA_4716_AB59_4C4329D65D85
 
+#include <cstddef>
 #include <memory>
 
+#include <boost/cstdint.hpp>
+
 #include <hpx/util/unused.hpp>
 
 namespace hpxla { namespace policy
@@ -18,16 +21,80 @@ namespace hpxla { namespace policy
 struct column_major_indexing;
 struct row_major_indexing;
 
+template <
+    boost::uint64_t Multiple = 16
+  , std::size_t ElementSize = sizeof(double)
+>
+struct padded_column_major_indexing;
+
+template <
+    boost::uint64_t Multiple = 16
+  , std::size_t ElementSize = sizeof(double)
+>
+struct padded_row_major_indexing;
+
+template <
+    boost::uint64_t TileRows
+  , boost::uint64_t TileCols
+>
+struct tiled_indexing;
+
+struct block_cyclic_distribution;
+
+template <
+    typename T
+  , std::size_t Alignment = 64
+>
+struct aligned_allocator;
+
+struct deep_copy;
+struct copy_on_write;
+
+/// The indexing policy which a matrix of \a T uses for \a IndexingPolicy.
+/// Most indexing policies don't depend on the type of the elements; the
+/// padded ones pad the leading dimension by its size in bytes, so they are
+/// given sizeof(T).
+template <
+    typename IndexingPolicy
+  , typename T
+>
+struct bind_indexing
+{
+    typedef IndexingPolicy type;
+};
+
+template <
+    boost::uint64_t Multiple
+  , std::size_t ElementSize
+  , typename T
+>
+struct bind_indexing<padded_column_major_indexing<Multiple, ElementSize>, T>
+{
+    typedef padded_column_major_indexing<Multiple, sizeof(T)> type;
+};
+
+template <
+    boost::uint64_t Multiple
+  , std::size_t ElementSize
+  , typename T
+>
+struct bind_indexing<padded_row_major_indexing<Multiple, ElementSize>, T>
+{
+    typedef padded_row_major_indexing<Multiple, sizeof(T)> type;
+};
+
 }
 
 template <
     typename IndexingPolicy = policy::column_major_indexing
   , typename AllocationPolicy = std::allocator<hpx::util::unused_type>
+  , typename CopyPolicy = policy::deep_copy
 >
 struct local_matrix_policy
 {
     typedef IndexingPolicy indexing_policy_type;
     typedef AllocationPolicy allocation_policy_type;
+    typedef CopyPolicy copy_policy_type;
 };
 
 template <
@@ -35,18 +102,21 @@ template <
   , typename PartitioningPolicy = hpx::util::unused_type
   , typename DistributionPolicy = hpx::util::unused_type
   , typename AllocationPolicy = std::allocator<hpx::util::unused_type>
+  , typename CopyPolicy = policy::deep_copy
 >
 struct distributed_matrix_policy
 {
     typedef local_matrix_policy<
         IndexingPolicy
       , AllocationPolicy
+      , CopyPolicy
     > local_policy_type;
 
     typedef IndexingPolicy indexing_policy_type;
     typedef PartitioningPolicy partitioning_policy_type;
     typedef DistributionPolicy distribution_policy_type;
     typedef AllocationPolicy allocation_policy_type;
+    typedef CopyPolicy copy_policy_type;
 };
 
 }
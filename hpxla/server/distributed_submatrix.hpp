@@ -8,16 +8,53 @@
 #if !defined(HPXLA_8F16F3F2_9DEB_4D29_9657_19EA59788895)
 #define HPXLA_8F16F3F2_9DEB_4D29_9657_19EA59788895
 
+#include <hpxla/local_blas.hpp>
 #include <hpxla/local_matrix.hpp>
+#include <hpxla/storage_buffer.hpp>
 
 #include <hpx/hpx_fwd.hpp>
 #include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/mutex.hpp>
 
+#include <map>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
 #include <boost/serialization/complex.hpp>
+#include <boost/serialization/vector.hpp>
 
 namespace hpxla { namespace server
 {
 
+/// One step of a SUMMA multiply: the region [a_lower, a_upper) of block \a a
+/// of A, and the region [b_lower, b_upper) of block \a b of B.
+struct summa_panel
+{
+    hpx::naming::id_type a;
+    matrix_bounds a_lower;
+    matrix_bounds a_upper;
+
+    hpx::naming::id_type b;
+    matrix_bounds b_lower;
+    matrix_bounds b_upper;
+
+    template <
+        typename Archive
+    >
+    void serialize(
+        Archive& ar
+      , unsigned int
+        )
+    {
+        ar & a & a_lower & a_upper & b & b_lower & b_upper;
+    }
+};
+
 template <
     typename T
   , typename Policy = distributed_matrix_policy<> 
@@ -39,6 +76,14 @@ struct HPX_COMPONENT_EXPORT distributed_submatrix
         void(local_matrix_type&, matrix_bounds, matrix_bounds)
     > apply_function_type;
 
+    typedef hpx::util::function<
+        value_type(local_matrix_type const&, matrix_bounds, matrix_bounds)
+    > evaluate_function_type;
+
+    typedef hpx::util::function<
+        value_type(value_type, value_type)
+    > combine_function_type;
+
     typedef Policy policy_type;
     typedef typename Policy::indexing_policy_type indexing_policy_type;
     typedef typename Policy::partitioning_policy_type partitioning_policy_type;
@@ -48,6 +93,81 @@ struct HPX_COMPONENT_EXPORT distributed_submatrix
   private:
     local_matrix_type data_;
 
+    typedef hpx::shared_future<local_matrix_type> panel_future;
+    typedef boost::shared_ptr<panel_future> panel_pointer;
+
+    /// The pieces of panels which the summa calls on this locality are
+    /// fetching or multiplying, keyed by block and region. The blocks of C in
+    /// one block row need the same pieces of A, and those in one block column
+    /// the same pieces of B, so the blocks of C which share a locality share
+    /// one fetch of each piece. An entry lives only as long as some summa
+    /// call holds it; a later multiply fetches its panels again.
+    struct panel_cache
+    {
+        typedef boost::tuple<
+            hpx::naming::gid_type
+          , boost::uint64_t, boost::uint64_t
+          , boost::uint64_t, boost::uint64_t
+        > key_type;
+
+        typedef std::map<key_type, boost::weak_ptr<panel_future> > map_type;
+
+        hpx::lcos::local::mutex mtx;
+        map_type panels;
+    };
+
+    /// Returns the region [\a lower, \a upper) of \a block, fetching it
+    /// unless another summa call on this locality already is.
+    static panel_pointer fetch_panel(
+        hpx::naming::id_type const& block
+      , matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        typedef typename distributed_submatrix::get_region_action action_type;
+        typedef typename panel_cache::map_type map_type;
+
+        static panel_cache cache;
+
+        typename panel_cache::key_type const key(block.get_gid()
+          , lower.rows, lower.cols, upper.rows, upper.cols);
+
+        hpx::lcos::local::mutex::scoped_lock l(cache.mtx);
+
+        typename map_type::iterator it = cache.panels.find(key);
+
+        if (it != cache.panels.end())
+        {
+            panel_pointer p = it->second.lock();
+
+            if (p)
+                return p;
+        }
+
+        // Drop the pieces which no call holds any more.
+        for (it = cache.panels.begin(); it != cache.panels.end();)
+        {
+            if (it->second.expired())
+                cache.panels.erase(it++);
+            else
+                ++it;
+        }
+
+        panel_pointer const p = boost::make_shared<panel_future>(
+            hpx::async<action_type>(block, lower, upper));
+
+        cache.panels[key] = p;
+
+        return p;
+    }
+
+    // Reads go through a const reference, so that they don't make a
+    // copy-on-write data_ duplicate storage that it shares.
+    local_matrix_type const& const_data() const
+    {
+        return data_;
+    }
+
   public:
     void initialize_from_dimensions(
         size_type rows
@@ -59,12 +179,33 @@ struct HPX_COMPONENT_EXPORT distributed_submatrix
         data_ = boost::move(local_matrix_type(rows, cols, init, offsets));
     }
 
+    // m is taken by value and moved into data_. If the action hands over the
+    // deserialized argument as an rvalue, this saves the copy which the old
+    // const reference version made; if it doesn't, m is copied once, as
+    // before. The clients only send matrices which aren't whole (see
+    // local_matrix::whole()) this way.
     void initialize_from_matrix(
-        local_matrix_type const& m
+        local_matrix_type m
       , matrix_offsets offsets 
         )
     {
-        data_ = boost::move(local_matrix_type(m, offsets));
+        data_ = boost::move(local_matrix_type(boost::move(m), offsets));
+    }
+
+    /// Adopts the storage which arrived in \a buffer, without copying it.
+    void initialize_from_storage(
+        storage_buffer<local_matrix_type> buffer
+      , matrix_offsets offsets
+        )
+    {
+        typename local_matrix_type::storage_type storage;
+        buffer.release(storage);
+
+        matrix_bounds const bounds = buffer.bounds();
+
+        data_ = boost::move(local_matrix_type(boost::move(storage)
+                                            , bounds.rows, bounds.cols
+                                            , offsets));
     }
 
     value_type lookup(
@@ -72,10 +213,117 @@ struct HPX_COMPONENT_EXPORT distributed_submatrix
       , size_type col
         )
     {
-        return data_(row, col);
+        return const_data()(row, col);
+    }
+
+    /// Returns the values of the elements at each of \a coords, in the same
+    /// order, in a single reply.
+    std::vector<value_type> lookup_batch(
+        std::vector<matrix_bounds> const& coords
+        )
+    {
+        std::vector<value_type> values;
+        values.reserve(coords.size());
+
+        for (std::size_t p = 0; p < coords.size(); ++p)
+            values.push_back(const_data()(coords[p].rows, coords[p].cols));
+
+        return values;
+    }
+
+    /// Returns a copy of the elements in the half-open region
+    /// [\a lower, \a upper).
+    local_matrix_type get_region(
+        matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        BOOST_ASSERT(lower.rows <= upper.rows);
+        BOOST_ASSERT(lower.cols <= upper.cols);
+        BOOST_ASSERT(upper.rows <= data_.rows());
+        BOOST_ASSERT(upper.cols <= data_.columns());
+
+        local_matrix_type region(upper.rows - lower.rows
+                               , upper.cols - lower.cols);
+
+        for (size_type j = 0; j < region.columns(); ++j)
+            for (size_type i = 0; i < region.rows(); ++i)
+                region(i, j) = const_data()(lower.rows + i, lower.cols + j);
+
+        return region;
+    }
+
+    /// Overwrites the elements starting at \a lower with the elements of
+    /// \a m.
+    void put_region(
+        matrix_bounds lower
+      , local_matrix_type const& m
+        )
+    {
+        BOOST_ASSERT(lower.rows + m.rows() <= data_.rows());
+        BOOST_ASSERT(lower.cols + m.columns() <= data_.columns());
+
+        for (size_type j = 0; j < m.columns(); ++j)
+            for (size_type i = 0; i < m.rows(); ++i)
+                data_(lower.rows + i, lower.cols + j) = m(i, j);
+    }
+
+    /// Computes C = alpha * A * B + beta * C for this block of C, where A and
+    /// B are the concatenations of the \a panels of A (along the columns) and
+    /// of B (along the rows). The panels are fetched from the blocks which own
+    /// them (see fetch_panel()), and the next panel is fetched while the
+    /// current one is being multiplied. As in BLAS, C isn't read when \a beta
+    /// is zero.
+    void summa(
+        std::vector<summa_panel> const& panels
+      , value_type alpha
+      , value_type beta
+        )
+    {
+        if (panels.empty())
+        {
+            for (size_type j = 0; j < data_.columns(); ++j)
+                for (size_type i = 0; i < data_.rows(); ++i)
+                {
+                    if (value_type(0) == beta)
+                        data_(i, j) = value_type();
+                    else
+                        data_(i, j) *= beta;
+                }
+            return;
+        }
+
+        panel_pointer next_a = fetch_panel
+            (panels[0].a, panels[0].a_lower, panels[0].a_upper);
+        panel_pointer next_b = fetch_panel
+            (panels[0].b, panels[0].b_lower, panels[0].b_upper);
+
+        for (std::size_t p = 0; p < panels.size(); ++p)
+        {
+            // Holding the pointers keeps the pieces in the cache until this
+            // call is done with them.
+            panel_pointer const a = next_a;
+            panel_pointer const b = next_b;
+
+            if (p + 1 < panels.size())
+            {
+                summa_panel const& n = panels[p + 1];
+                next_a = fetch_panel(n.a, n.a_lower, n.a_upper);
+                next_b = fetch_panel(n.b, n.b_lower, n.b_upper);
+            }
+
+            local_matrix_type const& A = a->get();
+            local_matrix_type const& B = b->get();
+
+            BOOST_ASSERT(A.rows() == data_.rows());
+            BOOST_ASSERT(B.columns() == data_.columns());
+
+            // Only the first panel scales the old contents of C.
+            blas::gemm(A, B, data_, alpha, (0 == p) ? beta : value_type(1));
+        }
     }
 
-    // TODO: Allow functions with return values to be used.
+    // Use evaluate for functions with return values.
     void apply(
         apply_function_type const& f
       , matrix_bounds lower
@@ -86,18 +334,89 @@ struct HPX_COMPONENT_EXPORT distributed_submatrix
         f(data_, lower, upper);
     }
 
+    /// Like apply, but returns the result of \a f.
+    value_type evaluate(
+        evaluate_function_type const& f
+      , matrix_bounds lower
+      , matrix_bounds upper
+        )
+    {
+        BOOST_ASSERT(lower.rows <= upper.rows);
+        BOOST_ASSERT(lower.cols <= upper.cols);
+        BOOST_ASSERT(upper.rows <= data_.rows());
+        BOOST_ASSERT(upper.cols <= data_.columns());
+
+        return f(data_, lower, upper);
+    }
+
+    /// Applies \a map to this block and to each of the blocks in
+    /// \a children, and folds the results together with \a combine, which
+    /// must be associative. The children are split into two subtrees, each of
+    /// which is reduced by its first block, so the reduction forms a binary
+    /// tree and only one value is sent back across each edge.
+    value_type reduce(
+        evaluate_function_type const& map
+      , combine_function_type const& combine
+      , std::vector<hpx::naming::id_type> const& children
+        )
+    {
+        typedef typename distributed_submatrix::reduce_action action_type;
+
+        std::size_t const split[3] =
+            { 0, (children.size() + 1) / 2, children.size() };
+
+        // Start the subtrees before doing the local work.
+        std::vector<hpx::lcos::future<value_type> > subtrees;
+        subtrees.reserve(2);
+
+        for (std::size_t s = 0; s < 2; ++s)
+        {
+            if (split[s] == split[s + 1])
+                continue;
+
+            std::vector<hpx::naming::id_type> const grandchildren(
+                children.begin() + split[s] + 1
+              , children.begin() + split[s + 1]);
+
+            subtrees.push_back(hpx::async<action_type>(
+                children[split[s]], map, combine, grandchildren));
+        }
+
+        value_type result = map(data_, matrix_bounds(0, 0)
+                              , matrix_bounds(data_.rows(), data_.columns()));
+
+        for (std::size_t s = 0; s < subtrees.size(); ++s)
+            result = combine(result, subtrees[s].get());
+
+        return result;
+    }
+
     enum action_codes
     {
         action_initialize_from_dimensions
       , action_initialize_from_matrix
+      , action_initialize_from_storage
       , action_lookup
+      , action_lookup_batch
+      , action_get_region
+      , action_put_region
       , action_apply
+      , action_evaluate
+      , action_reduce
+      , action_summa
     };
 
     HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, initialize_from_dimensions);
     HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, initialize_from_matrix);
+    HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, initialize_from_storage);
     HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, lookup);
+    HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, lookup_batch);
+    HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, get_region);
+    HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, put_region);
     HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, apply);
+    HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, evaluate);
+    HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, reduce);
+    HPX_DEFINE_COMPONENT_ACTION(distributed_submatrix, summa);
 };
 
 typedef distributed_submatrix<
@@ -156,6 +475,18 @@ typedef distributed_submatrix<
     >
 > cdr_distributed_submatrix;
 
+// Blocks of copy-on-write distributed matrices (see policy::copy_on_write).
+typedef distributed_submatrix<
+    double
+  , distributed_matrix_policy<
+        policy::column_major_indexing
+      , hpx::util::unused_type
+      , hpx::util::unused_type
+      , std::allocator<hpx::util::unused_type>
+      , policy::copy_on_write
+    >
+> rdc_cow_distributed_submatrix;
+
 }}
 
 HPX_REGISTER_ACTION_DECLARATION(
@@ -164,12 +495,33 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rfc_distributed_submatrix::initialize_from_matrix_action
   , rfc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfc_distributed_submatrix::initialize_from_storage_action
+  , rfc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rfc_distributed_submatrix::lookup_action
   , rfc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfc_distributed_submatrix::lookup_batch_action
+  , rfc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfc_distributed_submatrix::get_region_action
+  , rfc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfc_distributed_submatrix::put_region_action
+  , rfc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rfc_distributed_submatrix::apply_action
   , rfc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfc_distributed_submatrix::evaluate_action
+  , rfc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfc_distributed_submatrix::reduce_action
+  , rfc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfc_distributed_submatrix::summa_action
+  , rfc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rfr_distributed_submatrix::initialize_from_dimensions_action
@@ -177,12 +529,33 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rfr_distributed_submatrix::initialize_from_matrix_action
   , rfr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfr_distributed_submatrix::initialize_from_storage_action
+  , rfr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rfr_distributed_submatrix::lookup_action
   , rfr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfr_distributed_submatrix::lookup_batch_action
+  , rfr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfr_distributed_submatrix::get_region_action
+  , rfr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfr_distributed_submatrix::put_region_action
+  , rfr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rfr_distributed_submatrix::apply_action
   , rfr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfr_distributed_submatrix::evaluate_action
+  , rfr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfr_distributed_submatrix::reduce_action
+  , rfr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rfr_distributed_submatrix::summa_action
+  , rfr_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdc_distributed_submatrix::initialize_from_dimensions_action
@@ -190,12 +563,33 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdc_distributed_submatrix::initialize_from_matrix_action
   , rdc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_distributed_submatrix::initialize_from_storage_action
+  , rdc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdc_distributed_submatrix::lookup_action
   , rdc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_distributed_submatrix::lookup_batch_action
+  , rdc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_distributed_submatrix::get_region_action
+  , rdc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_distributed_submatrix::put_region_action
+  , rdc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdc_distributed_submatrix::apply_action
   , rdc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_distributed_submatrix::evaluate_action
+  , rdc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_distributed_submatrix::reduce_action
+  , rdc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_distributed_submatrix::summa_action
+  , rdc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdr_distributed_submatrix::initialize_from_dimensions_action
@@ -203,12 +597,33 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdr_distributed_submatrix::initialize_from_matrix_action
   , rdr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdr_distributed_submatrix::initialize_from_storage_action
+  , rdr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdr_distributed_submatrix::lookup_action
   , rdr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdr_distributed_submatrix::lookup_batch_action
+  , rdr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdr_distributed_submatrix::get_region_action
+  , rdr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdr_distributed_submatrix::put_region_action
+  , rdr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::rdr_distributed_submatrix::apply_action
   , rdr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdr_distributed_submatrix::evaluate_action
+  , rdr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdr_distributed_submatrix::reduce_action
+  , rdr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdr_distributed_submatrix::summa_action
+  , rdr_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfc_distributed_submatrix::initialize_from_dimensions_action
@@ -216,12 +631,33 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfc_distributed_submatrix::initialize_from_matrix_action
   , cfc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfc_distributed_submatrix::initialize_from_storage_action
+  , cfc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfc_distributed_submatrix::lookup_action
   , cfc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfc_distributed_submatrix::lookup_batch_action
+  , cfc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfc_distributed_submatrix::get_region_action
+  , cfc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfc_distributed_submatrix::put_region_action
+  , cfc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfc_distributed_submatrix::apply_action
   , cfc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfc_distributed_submatrix::evaluate_action
+  , cfc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfc_distributed_submatrix::reduce_action
+  , cfc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfc_distributed_submatrix::summa_action
+  , cfc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfr_distributed_submatrix::initialize_from_dimensions_action
@@ -229,12 +665,33 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfr_distributed_submatrix::initialize_from_matrix_action
   , cfr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfr_distributed_submatrix::initialize_from_storage_action
+  , cfr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfr_distributed_submatrix::lookup_action
   , cfr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfr_distributed_submatrix::lookup_batch_action
+  , cfr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfr_distributed_submatrix::get_region_action
+  , cfr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfr_distributed_submatrix::put_region_action
+  , cfr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cfr_distributed_submatrix::apply_action
   , cfr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfr_distributed_submatrix::evaluate_action
+  , cfr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfr_distributed_submatrix::reduce_action
+  , cfr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cfr_distributed_submatrix::summa_action
+  , cfr_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdc_distributed_submatrix::initialize_from_dimensions_action
@@ -242,12 +699,33 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdc_distributed_submatrix::initialize_from_matrix_action
   , cdc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdc_distributed_submatrix::initialize_from_storage_action
+  , cdc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdc_distributed_submatrix::lookup_action
   , cdc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdc_distributed_submatrix::lookup_batch_action
+  , cdc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdc_distributed_submatrix::get_region_action
+  , cdc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdc_distributed_submatrix::put_region_action
+  , cdc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdc_distributed_submatrix::apply_action
   , cdc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdc_distributed_submatrix::evaluate_action
+  , cdc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdc_distributed_submatrix::reduce_action
+  , cdc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdc_distributed_submatrix::summa_action
+  , cdc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdr_distributed_submatrix::initialize_from_dimensions_action
@@ -255,12 +733,68 @@ HPX_REGISTER_ACTION_DECLARATION(
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdr_distributed_submatrix::initialize_from_matrix_action
   , cdr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdr_distributed_submatrix::initialize_from_storage_action
+  , cdr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdr_distributed_submatrix::lookup_action
   , cdr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdr_distributed_submatrix::lookup_batch_action
+  , cdr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdr_distributed_submatrix::get_region_action
+  , cdr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdr_distributed_submatrix::put_region_action
+  , cdr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION_DECLARATION(
     hpxla::server::cdr_distributed_submatrix::apply_action
   , cdr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdr_distributed_submatrix::evaluate_action
+  , cdr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdr_distributed_submatrix::reduce_action
+  , cdr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::cdr_distributed_submatrix::summa_action
+  , cdr_distributed_submatrix_summa_action);
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::
+        rdc_cow_distributed_submatrix::initialize_from_dimensions_action
+  , rdc_cow_distributed_submatrix_initialize_from_dimensions_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::initialize_from_matrix_action
+  , rdc_cow_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::initialize_from_storage_action
+  , rdc_cow_distributed_submatrix_initialize_from_storage_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::lookup_action
+  , rdc_cow_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::lookup_batch_action
+  , rdc_cow_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::get_region_action
+  , rdc_cow_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::put_region_action
+  , rdc_cow_distributed_submatrix_put_region_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::apply_action
+  , rdc_cow_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::evaluate_action
+  , rdc_cow_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::reduce_action
+  , rdc_cow_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    hpxla::server::rdc_cow_distributed_submatrix::summa_action
+  , rdc_cow_distributed_submatrix_summa_action);
 
 #endif // HPXLA_8F16F3F2_9DEB_4D29_9657_19EA59788895
 
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_6E1F0B8D_42C7_4A95_9D3E_0C7A5B21F4E6)
+#define HPXLA_6E1F0B8D_42C7_4A95_9D3E_0C7A5B21F4E6
+
+#include <hpxla/local_matrix.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/move/move.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/split_member.hpp>
+
+namespace hpxla
+{
+
+/// The storage of a whole local_matrix (see local_matrix::whole()), for
+/// sending it to another locality. Like hpx::util::serialize_buffer, copies
+/// of a storage_buffer share the elements, so storing it in an action's
+/// arguments doesn't copy them. The storage is written to the archive as one
+/// array, in place, which HPX's archives send as a zero-copy chunk once it
+/// is big enough. The receiving end reads the elements straight into a new
+/// storage vector, and release() hands that over to the local_matrix
+/// constructor which adopts storage.
+template <
+    typename Matrix
+>
+struct storage_buffer
+{
+    typedef typename Matrix::storage_type storage_type;
+    typedef typename Matrix::indexing_policy_type indexing_policy_type;
+
+    enum init_mode
+    {
+        copy,      // The elements are copied.
+        reference  // The elements are shared with the matrix.
+    };
+
+  private:
+    boost::shared_ptr<storage_type> storage_;
+    matrix_bounds bounds_;
+
+    friend class boost::serialization::access;
+
+    template <
+        typename Archive
+    >
+    void save(
+        Archive& ar
+      , unsigned version
+        ) const
+    {
+        ar & bounds_;
+
+        if (storage_)
+            ar & boost::serialization::make_array(storage_->data()
+                                                , storage_->size());
+    }
+
+    template <
+        typename Archive
+    >
+    void load(
+        Archive& ar
+      , unsigned version
+        )
+    {
+        ar & bounds_;
+
+        storage_.reset();
+
+        if (bounds_.rows && bounds_.cols)
+        {
+            storage_ = boost::make_shared<storage_type>(
+                indexing_policy_type::storage_size(bounds_));
+
+            ar & boost::serialization::make_array(storage_->data()
+                                                , storage_->size());
+        }
+    }
+
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  public:
+    storage_buffer() : bounds_(0, 0) {}
+
+    /// Copies or references the storage of \a m. A referenced matrix must
+    /// not be written to until the action which carries the buffer has been
+    /// sent (e.g. until a synchronous action returns).
+    storage_buffer(
+        Matrix const& m
+      , init_mode mode
+        )
+      : bounds_(m.rows(), m.columns())
+    {
+        BOOST_ASSERT(m.whole());
+
+        boost::shared_ptr<storage_type> const& s = m.shared_storage();
+
+        if (s)
+            storage_ = (reference == mode)
+                     ? s : boost::make_shared<storage_type>(*s);
+    }
+
+    /// Takes the storage of \a m, which is left empty.
+    explicit storage_buffer(
+        BOOST_RV_REF(Matrix) m
+        )
+      : bounds_(m.rows(), m.columns())
+    {
+        BOOST_ASSERT(m.whole());
+
+        Matrix const taken(boost::move(m));
+        storage_ = taken.shared_storage();
+    }
+
+    matrix_bounds bounds() const
+    {
+        return bounds_;
+    }
+
+    /// Moves the elements into \a s, which must be empty. They are only
+    /// copied if the storage is still shared, e.g. with the sending matrix,
+    /// when the action didn't go through a parcel.
+    void release(
+        storage_type& s
+        )
+    {
+        BOOST_ASSERT(s.empty());
+
+        if (!storage_)
+            return;
+
+        if (storage_.unique())
+            s.swap(*storage_);
+        else
+            storage_type(*storage_).swap(s);
+
+        storage_.reset();
+    }
+};
+
+}
+
+#endif // HPXLA_6E1F0B8D_42C7_4A95_9D3E_0C7A5B21F4E6
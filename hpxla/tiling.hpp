@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_5BB9DC39_C24C_4A47_A427_92FE486AE015)
+#define HPXLA_5BB9DC39_C24C_4A47_A427_92FE486AE015
+
+#include <hpxla/config.hpp>
+#include <hpxla/matrix_dimensions.hpp>
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
+#if !defined(HPXLA_NO_LIBHPX)
+    #include <hpx/include/async.hpp>
+    #include <hpx/include/lcos.hpp>
+    #include <hpx/runtime/threads/thread_helpers.hpp>
+#endif
+
+namespace hpxla
+{
+
+namespace detail
+{
+
+template <
+    typename F
+>
+struct tile_task
+{
+    typedef void result_type;
+
+    tile_task(
+        F const& f
+      , matrix_bounds start
+      , matrix_bounds extents
+        )
+      : f_(f)
+      , start_(start)
+      , extents_(extents)
+    {}
+
+    void operator()()
+    {
+        f_(start_, extents_);
+    }
+
+  private:
+    F f_;
+    matrix_bounds start_;
+    matrix_bounds extents_;
+};
+
+}
+
+/// Returns the dimensions of the tiles that the tiled kernels (e.g. the local
+/// GEMM) hand to each HPX task, for a matrix stored in tiles of
+/// \a storage_tile: at most HPXLA_GEMM_TILE_SIZE rows and columns, and, if
+/// the storage tiles are smaller than that, a whole number of them.
+/// Initializing a matrix with the same tiles places each part of it on the
+/// NUMA node of the task that later works on it.
+inline matrix_bounds task_tile(
+    matrix_bounds storage_tile
+    )
+{
+    boost::uint64_t extent[2] = { storage_tile.rows, storage_tile.cols };
+
+    for (std::size_t k = 0; k < 2; ++k)
+    {
+        if (0 == extent[k] || HPXLA_GEMM_TILE_SIZE <= extent[k])
+            extent[k] = HPXLA_GEMM_TILE_SIZE;
+        else
+            extent[k] = (HPXLA_GEMM_TILE_SIZE / extent[k]) * extent[k];
+    }
+
+    return matrix_bounds(extent[0], extent[1]);
+}
+
+/// Invokes \a f(start, extents) once for each tile of a matrix with dimensions
+/// \a bounds. \a start is the position of the first element of the tile and
+/// \a extents are its dimensions, which are \a tile everywhere except along
+/// the bottom and right edges of the matrix. Tiles are enumerated in
+/// column-major order.
+///
+/// When called from an HPX thread, every tile except the last one is handed to
+/// a new HPX task, and the last one is processed by the calling thread. The
+/// call returns once all tiles have been processed. Otherwise, the tiles are
+/// processed in order on the calling thread.
+template <
+    typename F
+>
+inline void for_each_tile(
+    matrix_bounds bounds
+  , matrix_bounds tile
+  , F const& f
+    )
+{
+    BOOST_ASSERT(tile.rows && tile.cols);
+
+    std::vector<detail::tile_task<F> > tasks;
+
+    for (boost::uint64_t j = 0; j < bounds.cols; j += tile.cols)
+        for (boost::uint64_t i = 0; i < bounds.rows; i += tile.rows)
+            tasks.push_back(detail::tile_task<F>(f
+              , matrix_bounds(i, j)
+              , matrix_bounds((std::min)(tile.rows, bounds.rows - i)
+                            , (std::min)(tile.cols, bounds.cols - j))));
+
+#if !defined(HPXLA_NO_LIBHPX)
+    if (1 < tasks.size() && hpx::threads::get_self_ptr())
+    {
+        std::vector<hpx::lcos::future<void> > futures;
+        futures.reserve(tasks.size() - 1);
+
+        for (std::size_t k = 0; k < tasks.size() - 1; ++k)
+            futures.push_back(hpx::async(tasks[k]));
+
+        tasks.back()();
+
+        // Calling get() (instead of hpx::wait_all) propagates exceptions
+        // thrown by the tasks.
+        for (std::size_t k = 0; k < futures.size(); ++k)
+            futures[k].get();
+
+        return;
+    }
+#endif
+
+    for (std::size_t k = 0; k < tasks.size(); ++k)
+        tasks[k]();
+}
+
+}
+
+#endif // HPXLA_5BB9DC39_C24C_4A47_A427_92FE486AE015
+
@@ -0,0 +1,342 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPXLA_C607BA44_FC3B_49D0_BB0A_3A6435C57A44)
+#define HPXLA_C607BA44_FC3B_49D0_BB0A_3A6435C57A44
+
+#include <hpxla/matrix_dimensions.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/shared_ptr.hpp>
+
+#if !defined(HPXLA_NO_LIBHPX)
+    #include <hpx/include/async.hpp>
+    #include <hpx/include/lcos.hpp>
+    #include <hpx/lcos/local/promise.hpp>
+    #include <hpx/runtime/threads/thread_helpers.hpp>
+#endif
+
+namespace hpxla
+{
+
+namespace detail
+{
+
+/// The columns [first, last) of every row of a grid.
+struct all_columns
+{
+    explicit all_columns(boost::uint64_t cols_) : cols(cols_) {}
+
+    std::pair<boost::uint64_t, boost::uint64_t> operator()(
+        boost::uint64_t
+        ) const
+    {
+        return std::make_pair(boost::uint64_t(0), cols);
+    }
+
+    boost::uint64_t cols;
+};
+
+/// The tiles of a grid which are run: the columns [first[i], last[i]) of
+/// each row i. The tiles of row i are stored at offsets[i] onwards.
+struct wavefront_shape
+{
+    template <
+        typename Columns
+    >
+    wavefront_shape(
+        matrix_bounds grid_
+      , Columns const& columns
+        )
+      : grid(grid_)
+      , first(grid_.rows)
+      , last(grid_.rows)
+      , offsets(grid_.rows + 1, 0)
+    {
+        for (boost::uint64_t i = 0; i < grid.rows; ++i)
+        {
+            std::pair<boost::uint64_t, boost::uint64_t> const c = columns(i);
+
+            first[i] = (std::min)(c.first, grid.cols);
+            last[i] = (std::max)(first[i], (std::min)(c.second, grid.cols));
+            offsets[i + 1] = offsets[i] + (last[i] - first[i]);
+        }
+    }
+
+    bool active(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        return i < grid.rows && first[i] <= j && j < last[i];
+    }
+
+    boost::uint64_t index(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        BOOST_ASSERT(active(i, j));
+        return offsets[i] + (j - first[i]);
+    }
+
+    boost::uint64_t size() const
+    {
+        return offsets.back();
+    }
+
+    matrix_bounds const grid;
+    std::vector<boost::uint64_t> first;
+    std::vector<boost::uint64_t> last;
+    std::vector<boost::uint64_t> offsets;
+};
+
+#if !defined(HPXLA_NO_LIBHPX)
+/// The state of a call to for_each_wavefront: a counter of unfinished
+/// predecessors for each tile, the number of tiles which haven't finished,
+/// and the first exception thrown by a tile. Each task holds a reference to
+/// it, so it outlives the task which finishes the last tile even if the
+/// caller has already returned by then.
+template <
+    typename F
+>
+struct wavefront
+  : boost::enable_shared_from_this<wavefront<F> >
+  , boost::noncopyable
+{
+    wavefront(
+        wavefront_shape const& shape_
+      , F const& f_
+        )
+      : shape(shape_)
+      , f(f_)
+      , predecessors(new boost::atomic<boost::uint32_t>[shape_.size()])
+      , remaining(shape_.size())
+      , failed(false)
+    {
+        for (boost::uint64_t i = 0; i < shape.grid.rows; ++i)
+            for (boost::uint64_t j = shape.first[i]; j < shape.last[i]; ++j)
+                predecessors[shape.index(i, j)].store(
+                    (i != 0 && shape.active(i - 1, j)) + (j != shape.first[i]));
+    }
+
+    /// Runs tile (i, j), and then the tiles it is the last predecessor of.
+    /// One of those is run by this thread; if there is another, it gets a new
+    /// task.
+    void run(
+        boost::uint64_t i
+      , boost::uint64_t j
+        );
+
+    /// Waits for the last tile, and rethrows the first exception that any
+    /// tile threw.
+    void wait()
+    {
+        done.get_future().get();
+
+        if (error)
+            boost::rethrow_exception(error);
+    }
+
+  private:
+    // Returns true if (i, j) has no more unfinished predecessors.
+    bool release(
+        boost::uint64_t i
+      , boost::uint64_t j
+        )
+    {
+        return 1 == predecessors[shape.index(i, j)].fetch_sub(1);
+    }
+
+    wavefront_shape const& shape;
+    F const& f;
+
+    boost::scoped_array<boost::atomic<boost::uint32_t> > predecessors;
+    boost::atomic<boost::uint64_t> remaining;
+
+    // After a tile throws, the rest of the tiles are released without being
+    // run, so that every tile is still reached.
+    boost::atomic<bool> failed;
+    boost::exception_ptr error;
+
+    hpx::lcos::local::promise<void> done;
+};
+
+template <
+    typename F
+>
+struct wavefront_task
+{
+    typedef void result_type;
+
+    wavefront_task(
+        boost::shared_ptr<wavefront<F> > const& w
+      , boost::uint64_t i
+      , boost::uint64_t j
+        )
+      : w_(w)
+      , i_(i)
+      , j_(j)
+    {}
+
+    void operator()() const
+    {
+        w_->run(i_, j_);
+    }
+
+  private:
+    boost::shared_ptr<wavefront<F> > w_;
+    boost::uint64_t i_;
+    boost::uint64_t j_;
+};
+
+template <
+    typename F
+>
+inline void wavefront<F>::run(
+    boost::uint64_t i
+  , boost::uint64_t j
+    )
+{
+    while (true)
+    {
+        if (!failed.load())
+        {
+            try
+            {
+                f(i, j);
+            }
+
+            catch (...)
+            {
+                if (!failed.exchange(true))
+                    error = boost::current_exception();
+            }
+        }
+
+        bool const down = shape.active(i + 1, j) && release(i + 1, j);
+        bool const right = shape.active(i, j + 1) && release(i, j + 1);
+
+        // Keep going down the column, which is usually what the data of the
+        // tile we just finished is next to.
+        if (down && right)
+            hpx::async(wavefront_task<F>(this->shared_from_this(), i, j + 1));
+
+        // Once this tile is counted as finished, and unless this thread has
+        // another tile to run, another thread may finish the last tile and
+        // return; shape and f must not be touched after it. *this is kept
+        // alive by the caller of run().
+        if (1 == remaining.fetch_sub(1))
+        {
+            done.set_value();
+            return;
+        }
+
+        if (down)
+            ++i;
+
+        else if (right)
+            ++j;
+
+        else
+            return;
+    }
+}
+#endif
+
+}
+
+/// Invokes \a f(i, j) once for each tile (i, j) of a \a grid.rows by
+/// \a grid.cols grid for which \a columns(i) returns a half-open range
+/// [first, last) that holds j, after \a f(i - 1, j) and \a f(i, j - 1) have
+/// returned (if those tiles are in their rows' ranges). This is the
+/// dependency pattern of a wavefront, e.g. the blocks of a dynamic
+/// programming matrix like Smith-Waterman's; \a columns restricts it to a
+/// band of the matrix, and the tiles outside of the band cost nothing.
+///
+/// When called from an HPX thread, each tile has a counter of its unfinished
+/// predecessors. The tile that brings a counter to zero runs that tile next
+/// (or spawns a new HPX task for it, if it already has one to run), so tasks
+/// never wait on each other. The call returns once all tiles have been
+/// processed, and rethrows the first exception thrown by \a f; once \a f has
+/// thrown, it is not invoked again.
+///
+/// Otherwise (outside of an HPX thread, with HPXLA_NO_LIBHPX, or for a single
+/// tile), the tiles are processed on the calling thread row by row, from the
+/// top row down, and each row from left to right. Note that this is not the
+/// column-major order of for_each_tile.
+template <
+    typename F
+  , typename Columns
+>
+inline void for_each_wavefront(
+    matrix_bounds grid
+  , F const& f
+  , Columns const& columns
+    )
+{
+    detail::wavefront_shape const shape(grid, columns);
+
+    if (shape.size() == 0)
+        return;
+
+#if !defined(HPXLA_NO_LIBHPX)
+    if (1 < shape.size() && hpx::threads::get_self_ptr())
+    {
+        // Tiles with no predecessors are where the wavefront starts.
+        std::vector<std::pair<boost::uint64_t, boost::uint64_t> > sources;
+
+        for (boost::uint64_t i = 0; i < grid.rows; ++i)
+            if (  shape.first[i] != shape.last[i]
+               && (i == 0 || !shape.active(i - 1, shape.first[i])))
+                sources.push_back(std::make_pair(i, shape.first[i]));
+
+        boost::shared_ptr<detail::wavefront<F> > const w
+            = boost::make_shared<detail::wavefront<F> >(shape, f);
+
+        for (std::size_t k = 1; k < sources.size(); ++k)
+            hpx::async(detail::wavefront_task<F>(w
+              , sources[k].first, sources[k].second));
+
+        w->run(sources[0].first, sources[0].second);
+        w->wait();
+        return;
+    }
+#endif
+
+    for (boost::uint64_t i = 0; i < grid.rows; ++i)
+        for (boost::uint64_t j = shape.first[i]; j < shape.last[i]; ++j)
+            f(i, j);
+}
+
+/// Invokes \a f(i, j) once for each tile (i, j) of a \a grid.rows by
+/// \a grid.cols grid, after \a f(i - 1, j) and \a f(i, j - 1) have returned.
+template <
+    typename F
+>
+inline void for_each_wavefront(
+    matrix_bounds grid
+  , F const& f
+    )
+{
+    for_each_wavefront(grid, f, detail::all_columns(grid.cols));
+}
+
+}
+
+#endif // HPXLA_C607BA44_FC3B_49D0_BB0A_3A6435C57A44
+
@@ -41,6 +41,10 @@ typedef hpx::components::managed_component<
     hpxla::server::cdr_distributed_submatrix
 > cdr_distributed_submatrix_type;
 
+typedef hpx::components::managed_component<
+    hpxla::server::rdc_cow_distributed_submatrix
+> rdc_cow_distributed_submatrix_type;
+
 HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(
     rfc_distributed_submatrix_type, rfc_distributed_submatrix);
 HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(
@@ -57,6 +61,8 @@ HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(
     cdc_distributed_submatrix_type, cdc_distributed_submatrix);
 HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(
     cdr_distributed_submatrix_type, cdr_distributed_submatrix);
+HPX_REGISTER_MINIMAL_COMPONENT_FACTORY(
+    rdc_cow_distributed_submatrix_type, rdc_cow_distributed_submatrix);
 
 HPX_REGISTER_ACTION(
     hpxla::server::rfc_distributed_submatrix::initialize_from_dimensions_action
@@ -64,12 +70,33 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::rfc_distributed_submatrix::initialize_from_matrix_action
   , rfc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfc_distributed_submatrix::initialize_from_storage_action
+  , rfc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rfc_distributed_submatrix::lookup_action
   , rfc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfc_distributed_submatrix::lookup_batch_action
+  , rfc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfc_distributed_submatrix::get_region_action
+  , rfc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfc_distributed_submatrix::put_region_action
+  , rfc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rfc_distributed_submatrix::apply_action
   , rfc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfc_distributed_submatrix::evaluate_action
+  , rfc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfc_distributed_submatrix::reduce_action
+  , rfc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfc_distributed_submatrix::summa_action
+  , rfc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION(
     hpxla::server::rfr_distributed_submatrix::initialize_from_dimensions_action
@@ -77,12 +104,33 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::rfr_distributed_submatrix::initialize_from_matrix_action
   , rfr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfr_distributed_submatrix::initialize_from_storage_action
+  , rfr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rfr_distributed_submatrix::lookup_action
   , rfr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfr_distributed_submatrix::lookup_batch_action
+  , rfr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfr_distributed_submatrix::get_region_action
+  , rfr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfr_distributed_submatrix::put_region_action
+  , rfr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rfr_distributed_submatrix::apply_action
   , rfr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfr_distributed_submatrix::evaluate_action
+  , rfr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfr_distributed_submatrix::reduce_action
+  , rfr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rfr_distributed_submatrix::summa_action
+  , rfr_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION(
     hpxla::server::rdc_distributed_submatrix::initialize_from_dimensions_action
@@ -90,12 +138,33 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::rdc_distributed_submatrix::initialize_from_matrix_action
   , rdc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_distributed_submatrix::initialize_from_storage_action
+  , rdc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rdc_distributed_submatrix::lookup_action
   , rdc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_distributed_submatrix::lookup_batch_action
+  , rdc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_distributed_submatrix::get_region_action
+  , rdc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_distributed_submatrix::put_region_action
+  , rdc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rdc_distributed_submatrix::apply_action
   , rdc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_distributed_submatrix::evaluate_action
+  , rdc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_distributed_submatrix::reduce_action
+  , rdc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_distributed_submatrix::summa_action
+  , rdc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION(
     hpxla::server::rdr_distributed_submatrix::initialize_from_dimensions_action
@@ -103,12 +172,33 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::rdr_distributed_submatrix::initialize_from_matrix_action
   , rdr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdr_distributed_submatrix::initialize_from_storage_action
+  , rdr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rdr_distributed_submatrix::lookup_action
   , rdr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdr_distributed_submatrix::lookup_batch_action
+  , rdr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdr_distributed_submatrix::get_region_action
+  , rdr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdr_distributed_submatrix::put_region_action
+  , rdr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::rdr_distributed_submatrix::apply_action
   , rdr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdr_distributed_submatrix::evaluate_action
+  , rdr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdr_distributed_submatrix::reduce_action
+  , rdr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdr_distributed_submatrix::summa_action
+  , rdr_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION(
     hpxla::server::cfc_distributed_submatrix::initialize_from_dimensions_action
@@ -116,12 +206,33 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::cfc_distributed_submatrix::initialize_from_matrix_action
   , cfc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfc_distributed_submatrix::initialize_from_storage_action
+  , cfc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cfc_distributed_submatrix::lookup_action
   , cfc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfc_distributed_submatrix::lookup_batch_action
+  , cfc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfc_distributed_submatrix::get_region_action
+  , cfc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfc_distributed_submatrix::put_region_action
+  , cfc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cfc_distributed_submatrix::apply_action
   , cfc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfc_distributed_submatrix::evaluate_action
+  , cfc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfc_distributed_submatrix::reduce_action
+  , cfc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfc_distributed_submatrix::summa_action
+  , cfc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION(
     hpxla::server::cfr_distributed_submatrix::initialize_from_dimensions_action
@@ -129,12 +240,33 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::cfr_distributed_submatrix::initialize_from_matrix_action
   , cfr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfr_distributed_submatrix::initialize_from_storage_action
+  , cfr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cfr_distributed_submatrix::lookup_action
   , cfr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfr_distributed_submatrix::lookup_batch_action
+  , cfr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfr_distributed_submatrix::get_region_action
+  , cfr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfr_distributed_submatrix::put_region_action
+  , cfr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cfr_distributed_submatrix::apply_action
   , cfr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfr_distributed_submatrix::evaluate_action
+  , cfr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfr_distributed_submatrix::reduce_action
+  , cfr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cfr_distributed_submatrix::summa_action
+  , cfr_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION(
     hpxla::server::cdc_distributed_submatrix::initialize_from_dimensions_action
@@ -142,12 +274,33 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::cdc_distributed_submatrix::initialize_from_matrix_action
   , cdc_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdc_distributed_submatrix::initialize_from_storage_action
+  , cdc_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cdc_distributed_submatrix::lookup_action
   , cdc_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdc_distributed_submatrix::lookup_batch_action
+  , cdc_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdc_distributed_submatrix::get_region_action
+  , cdc_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdc_distributed_submatrix::put_region_action
+  , cdc_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cdc_distributed_submatrix::apply_action
   , cdc_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdc_distributed_submatrix::evaluate_action
+  , cdc_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdc_distributed_submatrix::reduce_action
+  , cdc_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdc_distributed_submatrix::summa_action
+  , cdc_distributed_submatrix_summa_action);
 
 HPX_REGISTER_ACTION(
     hpxla::server::cdr_distributed_submatrix::initialize_from_dimensions_action
@@ -155,11 +308,65 @@ HPX_REGISTER_ACTION(
 HPX_REGISTER_ACTION(
     hpxla::server::cdr_distributed_submatrix::initialize_from_matrix_action
   , cdr_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdr_distributed_submatrix::initialize_from_storage_action
+  , cdr_distributed_submatrix_initialize_from_storage_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cdr_distributed_submatrix::lookup_action
   , cdr_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdr_distributed_submatrix::lookup_batch_action
+  , cdr_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdr_distributed_submatrix::get_region_action
+  , cdr_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdr_distributed_submatrix::put_region_action
+  , cdr_distributed_submatrix_put_region_action);
 HPX_REGISTER_ACTION(
     hpxla::server::cdr_distributed_submatrix::apply_action
   , cdr_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdr_distributed_submatrix::evaluate_action
+  , cdr_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdr_distributed_submatrix::reduce_action
+  , cdr_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::cdr_distributed_submatrix::summa_action
+  , cdr_distributed_submatrix_summa_action);
 
-
+HPX_REGISTER_ACTION(
+    hpxla::server::
+        rdc_cow_distributed_submatrix::initialize_from_dimensions_action
+  , rdc_cow_distributed_submatrix_initialize_from_dimensions_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::initialize_from_matrix_action
+  , rdc_cow_distributed_submatrix_initialize_from_matrix_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::initialize_from_storage_action
+  , rdc_cow_distributed_submatrix_initialize_from_storage_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::lookup_action
+  , rdc_cow_distributed_submatrix_lookup_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::lookup_batch_action
+  , rdc_cow_distributed_submatrix_lookup_batch_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::get_region_action
+  , rdc_cow_distributed_submatrix_get_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::put_region_action
+  , rdc_cow_distributed_submatrix_put_region_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::apply_action
+  , rdc_cow_distributed_submatrix_apply_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::evaluate_action
+  , rdc_cow_distributed_submatrix_evaluate_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::reduce_action
+  , rdc_cow_distributed_submatrix_reduce_action);
+HPX_REGISTER_ACTION(
+    hpxla::server::rdc_cow_distributed_submatrix::summa_action
+  , rdc_cow_distributed_submatrix_summa_action);
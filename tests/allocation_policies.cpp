@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpxla/local_matrix.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+
+#include <complex>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+using hpxla::local_matrix;
+using hpxla::local_matrix_policy;
+using hpxla::matrix_bounds;
+using hpxla::matrix_offsets;
+
+using hpxla::policy::aligned_allocator;
+using hpxla::policy::allocation_statistics;
+using hpxla::policy::arena;
+using hpxla::policy::arena_allocator;
+using hpxla::policy::column_major_indexing;
+using hpxla::policy::padded_column_major_indexing;
+using hpxla::policy::padded_row_major_indexing;
+using hpxla::policy::pool_allocator;
+
+using hpx::util::report_errors;
+using hpx::util::unused_type;
+
+typedef local_matrix<
+    double
+  , local_matrix_policy<column_major_indexing, pool_allocator<unused_type> >
+> pool_matrix;
+
+typedef local_matrix<
+    double
+  , local_matrix_policy<column_major_indexing, arena_allocator<unused_type> >
+> arena_matrix;
+
+typedef local_matrix<
+    float
+  , local_matrix_policy<
+        padded_column_major_indexing<>
+      , aligned_allocator<unused_type>
+    >
+> aligned_matrix;
+
+typedef local_matrix<
+    double
+  , local_matrix_policy<
+        padded_column_major_indexing<>
+      , aligned_allocator<unused_type, 2 * 1024 * 1024>
+    >
+> huge_page_matrix;
+
+bool aligned(
+    void const* p
+  , std::size_t alignment
+    )
+{
+    return 0 == reinterpret_cast<std::size_t>(p) % alignment;
+}
+
+int main()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Pool allocator
+    {
+        pool_allocator<double>::reset_statistics();
+
+        // The storage and the control block of the first matrix come from the
+        // global heap.
+        {
+            pool_matrix m0(100, 100, 1.0);
+
+            HPX_TEST_EQ(2U, pool_allocator<double>::statistics().misses);
+            HPX_TEST_EQ(0U, pool_allocator<double>::statistics().hits);
+        }
+
+        HPX_TEST_EQ(2U, pool_allocator<double>::statistics().releases);
+
+        // Matrices of the same size reuse them.
+        for (int i = 0; i < 10; ++i)
+        {
+            pool_matrix m0(100, 100, 2.0);
+
+            HPX_TEST_EQ(2.0, m0(99, 99));
+        }
+
+        allocation_statistics const s = pool_allocator<double>::statistics();
+
+        HPX_TEST_EQ(2U, s.misses);
+        HPX_TEST_EQ(20U, s.hits);
+        HPX_TEST_EQ(22U, s.releases);
+        HPX_TEST_EQ(0U, s.overflows);
+        HPX_TEST(0.9 < s.hit_rate());
+
+        // Copies are pooled too.
+        {
+            pool_matrix m0(10, 10, 3.0);
+            pool_matrix m1(m0);
+
+            m1(0, 0) = 4.0;
+
+            HPX_TEST_EQ(3.0, m0(0, 0));
+            HPX_TEST_EQ(4.0, m1(0, 0));
+            HPX_TEST_EQ(3.0, m1(9, 9));
+        }
+
+        // Blocks which are too large to pool go straight to the heap.
+        {
+            pool_allocator<char> alloc;
+
+            pool_allocator<char>::reset_statistics();
+
+            char* p = alloc.allocate(64 * 1024 * 1024);
+            alloc.deallocate(p, 64 * 1024 * 1024);
+
+            HPX_TEST_EQ(1U, pool_allocator<char>::statistics().misses);
+            HPX_TEST_EQ(1U, pool_allocator<char>::statistics().overflows);
+        }
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Arena allocator
+    {
+        arena a(1024 * 1024);
+
+        arena_allocator<unused_type> const alloc(a);
+
+        {
+            arena_matrix m0(100, 100, 1.0, matrix_offsets(0, 0), alloc);
+
+            HPX_TEST(&a == m0.get_allocator().get_arena());
+            HPX_TEST_EQ(1U, a.chunks());
+            HPX_TEST_EQ(1.0, m0(99, 99));
+
+            // Copies use the same arena.
+            arena_matrix m1(m0);
+
+            HPX_TEST(&a == m1.get_allocator().get_arena());
+            HPX_TEST_EQ(1U, a.chunks());
+            HPX_TEST_EQ(1.0, m1(99, 99));
+        }
+
+        // Temporaries which are destroyed in LIFO order give their memory
+        // back, so the arena doesn't grow.
+        for (int i = 0; i < 100; ++i)
+        {
+            arena_matrix m0(100, 100, 2.0, matrix_offsets(0, 0), alloc);
+
+            HPX_TEST_EQ(2.0, m0(0, 0));
+        }
+
+        HPX_TEST_EQ(1U, a.chunks());
+
+        allocation_statistics const s = a.statistics();
+
+        HPX_TEST_EQ(1U, s.misses);
+        HPX_TEST_EQ(2U * 102U - 1U, s.hits);
+        HPX_TEST_EQ(2U * 102U, s.releases);
+
+        // An allocation which is larger than a chunk gets its own chunk.
+        {
+            arena_matrix m0(1024, 1024, 3.0, matrix_offsets(0, 0), alloc);
+
+            HPX_TEST_EQ(2U, a.chunks());
+            HPX_TEST_EQ(3.0, m0(1023, 1023));
+        }
+
+        // Without an arena, memory comes from the global heap.
+        {
+            arena_matrix m0(10, 10, 4.0);
+
+            HPX_TEST(0 == m0.get_allocator().get_arena());
+            HPX_TEST_EQ(4.0, m0(9, 9));
+        }
+
+        // Memory is aligned as requested.
+        {
+            arena b(4096);
+
+            for (std::size_t n = 1; n < 100; n += 7)
+            {
+                void* p = b.allocate(n, 64);
+                HPX_TEST_EQ(0U, reinterpret_cast<std::size_t>(p) % 64);
+            }
+        }
+
+        // An aligned allocation near the end of a chunk, whose padding can
+        // run past the end, gets a new chunk. Where the padding ends depends
+        // on where the chunk lands, so several arenas, which are alive at the
+        // same time, are tried.
+        {
+            std::vector<boost::shared_ptr<arena> > arenas;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                arenas.push_back(boost::make_shared<arena>(1024));
+                arena& b = *arenas.back();
+
+                b.allocate(1008);
+                char* const p = static_cast<char*>(b.allocate(32, 64));
+
+                HPX_TEST_EQ(2U, b.chunks());
+                HPX_TEST_EQ(0U, reinterpret_cast<std::size_t>(p) % 64);
+
+                // The new chunk is used for the next allocation.
+                char* const q = static_cast<char*>(b.allocate(32, 64));
+
+                HPX_TEST_EQ(2U, b.chunks());
+                HPX_TEST_EQ(64, q - p);
+            }
+        }
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Aligned allocator and padded indexing
+    {
+        typedef padded_column_major_indexing<> indexer;
+
+        HPX_TEST_EQ(0U, indexer::leading_dimension(matrix_bounds(0, 3)));
+        HPX_TEST_EQ(16U, indexer::leading_dimension(matrix_bounds(1, 3)));
+        HPX_TEST_EQ(112U, indexer::leading_dimension(matrix_bounds(100, 3)));
+
+        // Powers of two are moved off of multiples of the critical stride
+        // (4 KiB, or 512 of the default 8 byte elements).
+        HPX_TEST_EQ(528U, indexer::leading_dimension(matrix_bounds(512, 3)));
+        HPX_TEST_EQ(2064U
+                  , indexer::leading_dimension(matrix_bounds(2048, 3)));
+        HPX_TEST_EQ(528U * 7U, indexer::storage_size(matrix_bounds(500, 7)));
+
+        // Matrices pad by the size of their elements.
+        {
+            typedef local_matrix<
+                float
+              , local_matrix_policy<padded_column_major_indexing<> >
+            >::indexing_policy_type float_indexer;
+
+            HPX_TEST_EQ(512U
+                , float_indexer::leading_dimension(matrix_bounds(512, 3)));
+            HPX_TEST_EQ(1040U
+                , float_indexer::leading_dimension(matrix_bounds(1024, 3)));
+        }
+
+        {
+            typedef local_matrix<
+                double
+              , local_matrix_policy<padded_column_major_indexing<> >
+            >::indexing_policy_type double_indexer;
+
+            HPX_TEST_EQ(256U
+                , double_indexer::leading_dimension(matrix_bounds(256, 3)));
+            HPX_TEST_EQ(528U
+                , double_indexer::leading_dimension(matrix_bounds(512, 3)));
+        }
+
+        {
+            typedef local_matrix<
+                std::complex<double>
+              , local_matrix_policy<padded_column_major_indexing<> >
+            > complex_matrix;
+
+            typedef complex_matrix::indexing_policy_type complex_indexer;
+
+            HPX_TEST_EQ(112U
+                , complex_indexer::leading_dimension(matrix_bounds(100, 3)));
+            HPX_TEST_EQ(272U
+                , complex_indexer::leading_dimension(matrix_bounds(256, 3)));
+            HPX_TEST_EQ(528U
+                , complex_indexer::leading_dimension(matrix_bounds(512, 3)));
+
+            complex_matrix m0(256, 4, std::complex<double>(1.0, 2.0));
+
+            HPX_TEST_EQ(272U, m0.leading_dimension());
+            HPX_TEST(std::complex<double>(1.0, 2.0) == m0(255, 3));
+
+            // Rows are padded in the same way.
+            typedef local_matrix<
+                std::complex<double>
+              , local_matrix_policy<padded_row_major_indexing<> >
+            >::indexing_policy_type complex_row_indexer;
+
+            HPX_TEST_EQ(272U
+                , complex_row_indexer::leading_dimension(
+                      matrix_bounds(3, 256)));
+
+            // 256 complex<double>s are 4 KiB, so no multiple of 256 of them
+            // can avoid the critical stride.
+            typedef local_matrix<
+                std::complex<double>
+              , local_matrix_policy<padded_column_major_indexing<256> >
+            >::indexing_policy_type wide_indexer;
+
+            HPX_TEST_EQ(256U
+                , wide_indexer::leading_dimension(matrix_bounds(200, 3)));
+        }
+
+        // Every column starts on a cache line.
+        {
+            aligned_matrix m0(100, 9, 1.0f);
+
+            HPX_TEST_EQ(112U, m0.leading_dimension());
+
+            for (std::size_t j = 0; j < m0.columns(); ++j)
+                HPX_TEST(aligned(&m0(0, j), 64));
+
+            aligned_matrix m1(m0);
+
+            HPX_TEST(aligned(m1.data(), 64));
+            HPX_TEST_EQ(1.0f, m1(99, 8));
+        }
+
+        {
+            huge_page_matrix m0(512, 600, 2.0);
+
+            HPX_TEST(aligned(m0.data(), 2 * 1024 * 1024));
+            HPX_TEST_EQ(528U, m0.leading_dimension());
+            HPX_TEST_EQ(2.0, m0(511, 599));
+        }
+    }
+    // }}}
+
+    return report_errors();
+}
+
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpxla/distributed_gemm.hpp>
+#include <hpxla/local_blas.hpp>
+
+#include <limits>
+
+using hpxla::distributed_gemm;
+using hpxla::distributed_matrix;
+using hpxla::distributed_matrix_policy;
+using hpxla::matrix_bounds;
+
+using hpxla::policy::block_cyclic_distribution;
+using hpxla::policy::column_major_indexing;
+
+using hpx::util::report_errors;
+
+typedef distributed_matrix<
+    double
+  , distributed_matrix_policy<
+        column_major_indexing
+      , hpx::util::unused_type
+      , block_cyclic_distribution
+    >
+> matrix_type;
+
+typedef matrix_type::submatrix_type::local_matrix_type local_matrix_type;
+
+/// Copies each block of \a m into \a d.
+void scatter(
+    local_matrix_type const& m
+  , matrix_type const& d
+    )
+{
+    for (boost::uint64_t j = 0; j < d.grid().cols; ++j)
+        for (boost::uint64_t i = 0; i < d.grid().rows; ++i)
+        {
+            matrix_bounds const o = d.block_offsets(i, j);
+            matrix_bounds const e = d.block_extents(i, j);
+
+            local_matrix_type block(e.rows, e.cols);
+
+            for (boost::uint64_t c = 0; c < e.cols; ++c)
+                for (boost::uint64_t r = 0; r < e.rows; ++r)
+                    block(r, c) = m(o.rows + r, o.cols + c);
+
+            d.block(i, j).put_region_sync(matrix_bounds(0, 0), block);
+        }
+}
+
+/// Returns \a processes localities for a process grid, reusing the
+/// localities round-robin when there are fewer of them.
+std::vector<hpx::naming::id_type> process_localities(
+    boost::uint64_t processes
+    )
+{
+    std::vector<hpx::naming::id_type> const all = hpx::find_all_localities();
+    std::vector<hpx::naming::id_type> localities;
+
+    for (boost::uint64_t p = 0; p < processes; ++p)
+        localities.push_back(all[p % all.size()]);
+
+    return localities;
+}
+
+void test_gemm(
+    matrix_bounds grid
+  , matrix_bounds blocks
+  , double beta
+    )
+{
+    block_cyclic_distribution const dist(grid, blocks);
+
+    std::vector<hpx::naming::id_type> const localities
+        = process_localities(dist.processes());
+
+    // A is 7 x 5, B is 5 x 6.
+    local_matrix_type A(7, 5), B(5, 6), C(7, 6);
+
+    for (boost::uint64_t j = 0; j < 5; ++j)
+        for (boost::uint64_t i = 0; i < 7; ++i)
+            A(i, j) = double(i + 2 * j);
+
+    for (boost::uint64_t j = 0; j < 6; ++j)
+        for (boost::uint64_t i = 0; i < 5; ++i)
+            B(i, j) = double(3 * i) - double(j);
+
+    for (boost::uint64_t j = 0; j < 6; ++j)
+        for (boost::uint64_t i = 0; i < 7; ++i)
+            C(i, j) = double(i * j);
+
+    matrix_type dA(7, 5, dist, 0.0, localities)
+              , dB(5, 6, dist, 0.0, localities)
+              , dC(7, 6, dist, 0.0, localities);
+
+    scatter(A, dA);
+    scatter(B, dB);
+
+    // When beta is zero, C must not be read, so whatever it held (here NaNs
+    // and infinities) must not show up in the result.
+    if (0.0 == beta)
+    {
+        local_matrix_type garbage(7, 6);
+
+        for (boost::uint64_t j = 0; j < 6; ++j)
+            for (boost::uint64_t i = 0; i < 7; ++i)
+                garbage(i, j) = ((i + j) % 2)
+                              ? std::numeric_limits<double>::quiet_NaN()
+                              : std::numeric_limits<double>::infinity();
+
+        scatter(garbage, dC);
+    }
+    else
+        scatter(C, dC);
+
+    distributed_gemm(dA, dB, dC, 2.0, beta);
+
+    hpxla::blas::gemm(A, B, C, 2.0, beta);
+
+    for (boost::uint64_t j = 0; j < 6; ++j)
+        for (boost::uint64_t i = 0; i < 7; ++i)
+            HPX_TEST_EQ(C(i, j), dC.lookup_sync(i, j));
+}
+
+int hpx_main()
+{
+    // Several blocks in every dimension, with ragged edges, all owned by one
+    // process.
+    test_gemm(matrix_bounds(1, 1), matrix_bounds(3, 2), 0.0);
+    test_gemm(matrix_bounds(1, 1), matrix_bounds(3, 2), 1.5);
+
+    // A single block.
+    test_gemm(matrix_bounds(1, 1), matrix_bounds(8, 8), 1.0);
+
+    // A square process grid.
+    test_gemm(matrix_bounds(2, 2), matrix_bounds(3, 2), 0.0);
+    test_gemm(matrix_bounds(2, 2), matrix_bounds(3, 2), 1.5);
+
+    // Non-square process grids, and a non-square grid of blocks (3 x 2 for
+    // A, 2 x 2 for B, 3 x 2 for C).
+    test_gemm(matrix_bounds(2, 3), matrix_bounds(3, 3), 0.0);
+    test_gemm(matrix_bounds(3, 1), matrix_bounds(3, 3), 1.5);
+    test_gemm(matrix_bounds(1, 2), matrix_bounds(3, 3), 0.0);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(0, hpx::init(argc, argv));
+    return report_errors();
+}
+
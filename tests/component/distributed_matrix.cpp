@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpxla/distributed_matrix.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using hpxla::distributed_matrix;
+using hpxla::distributed_matrix_policy;
+using hpxla::local_matrix_policy;
+using hpxla::matrix_bounds;
+using hpxla::matrix_offsets;
+
+using hpxla::policy::block_cyclic_distribution;
+using hpxla::policy::column_major_indexing;
+using hpxla::policy::copy_on_write;
+using hpxla::policy::copy_statistics;
+using hpxla::policy::prime_factor_partitioning;
+
+using hpx::util::report_errors;
+
+template <
+    typename Matrix
+>
+typename Matrix::value_type block_sum(
+    Matrix const& m
+  , matrix_bounds lower
+  , matrix_bounds upper
+    )
+{
+    typename Matrix::value_type sum = 0;
+
+    for (boost::uint64_t j = lower.cols; j < upper.cols; ++j)
+        for (boost::uint64_t i = lower.rows; i < upper.rows; ++i)
+            sum += m(i, j);
+
+    return sum;
+}
+
+template <
+    typename Matrix
+>
+typename Matrix::value_type block_max(
+    Matrix const& m
+  , matrix_bounds lower
+  , matrix_bounds upper
+    )
+{
+    typename Matrix::value_type max = m(lower.rows, lower.cols);
+
+    for (boost::uint64_t j = lower.cols; j < upper.cols; ++j)
+        for (boost::uint64_t i = lower.rows; i < upper.rows; ++i)
+            max = (std::max)(max, m(i, j));
+
+    return max;
+}
+
+template <
+    typename T
+>
+T plus(
+    T a
+  , T b
+    )
+{
+    return a + b;
+}
+
+template <
+    typename T
+>
+T maximum(
+    T a
+  , T b
+    )
+{
+    return (std::max)(a, b);
+}
+
+void test_partitioning()
+{
+    typedef prime_factor_partitioning<local_matrix_policy<> > partitioning;
+
+    // 12 = 3 * 2 * 2; a square matrix gets a 4 x 3 grid.
+    matrix_bounds grid
+        = partitioning::grid_dimensions(12, matrix_bounds(60, 60));
+    HPX_TEST_EQ(12U, grid.rows * grid.cols);
+    HPX_TEST(grid.rows == 4 || grid.cols == 4);
+
+    // A tall matrix gets all of the factors in its rows.
+    grid = partitioning::grid_dimensions(8, matrix_bounds(1000, 10));
+    HPX_TEST_EQ(8U, grid.rows);
+    HPX_TEST_EQ(1U, grid.cols);
+
+    // 7 is prime.
+    grid = partitioning::grid_dimensions(7, matrix_bounds(10, 100));
+    HPX_TEST_EQ(1U, grid.rows);
+    HPX_TEST_EQ(7U, grid.cols);
+
+    // 10 rows split in 4 blocks: 3, 3, 2, 2.
+    matrix_bounds const bounds(10, 1);
+    grid = partitioning::grid_dimensions(4, bounds);
+
+    HPX_TEST_EQ(4U, grid.rows);
+
+    matrix_bounds const largest = partitioning::submatrix_dimensions(4, bounds);
+    HPX_TEST_EQ(3U, largest.rows);
+    HPX_TEST_EQ(1U, largest.cols);
+
+    partitioning::offset_matrix offsets
+        = partitioning::create_offsets(4, bounds);
+
+    HPX_TEST_EQ(4U, offsets.rows());
+    HPX_TEST_EQ(2U, offsets.columns());
+
+    HPX_TEST_EQ(0, offsets(0, 0));
+    HPX_TEST_EQ(3, offsets(1, 0));
+    HPX_TEST_EQ(6, offsets(2, 0));
+    HPX_TEST_EQ(8, offsets(3, 0));
+
+    for (boost::uint64_t p = 0; p < 4; ++p)
+        HPX_TEST_EQ(0, offsets(p, 1));
+
+    // Every element must be routed to the block which contains it.
+    for (boost::uint64_t i = 0; i < bounds.rows; ++i)
+    {
+        matrix_bounds const b
+            = partitioning::submatrix_index(i, 0, grid, bounds);
+        matrix_bounds const e
+            = partitioning::submatrix_extents(b.rows, b.cols, grid, bounds);
+
+        boost::int64_t const first = offsets(b.rows, 0);
+
+        HPX_TEST(first <= boost::int64_t(i));
+        HPX_TEST(boost::int64_t(i) < first + boost::int64_t(e.rows));
+    }
+}
+
+void test_block_cyclic_distribution()
+{
+    // 2 x 3 process grid, 4 x 2 blocks, on a 10 x 7 matrix.
+    block_cyclic_distribution const d(matrix_bounds(2, 3), matrix_bounds(4, 2));
+    matrix_bounds const bounds(10, 7);
+
+    HPX_TEST_EQ(6U, d.processes());
+
+    matrix_bounds const grid = d.grid_dimensions(bounds);
+    HPX_TEST_EQ(3U, grid.rows);
+    HPX_TEST_EQ(4U, grid.cols);
+
+    // Blocks are dealt out cyclically; processes are numbered row-major.
+    HPX_TEST_EQ(0U, d.process_of(0, 0));
+    HPX_TEST_EQ(1U, d.process_of(0, 1));
+    HPX_TEST_EQ(2U, d.process_of(0, 2));
+    HPX_TEST_EQ(0U, d.process_of(0, 3));
+    HPX_TEST_EQ(3U, d.process_of(1, 0));
+    HPX_TEST_EQ(0U, d.process_of(2, 0));
+    HPX_TEST_EQ(5U, d.process_of(1, 2));
+
+    // The last row and column of blocks are clipped to the matrix.
+    HPX_TEST_EQ(2U, d.block_extents(2, 3, bounds).rows);
+    HPX_TEST_EQ(1U, d.block_extents(2, 3, bounds).cols);
+    HPX_TEST_EQ(4U, d.block_extents(1, 1, bounds).rows);
+    HPX_TEST_EQ(2U, d.block_extents(1, 1, bounds).cols);
+
+    // Every element must be routed to the block which contains it.
+    for (boost::uint64_t i = 0; i < bounds.rows; ++i)
+        for (boost::uint64_t j = 0; j < bounds.cols; ++j)
+        {
+            matrix_bounds const b = d.block_index(i, j);
+            matrix_bounds const o = d.block_offsets(b.rows, b.cols);
+            matrix_bounds const e = d.block_extents(b.rows, b.cols, bounds);
+
+            HPX_TEST(o.rows <= i && i < o.rows + e.rows);
+            HPX_TEST(o.cols <= j && j < o.cols + e.cols);
+        }
+}
+
+void test_distributed_matrix()
+{
+    typedef distributed_matrix<
+        double
+      , distributed_matrix_policy<
+            column_major_indexing
+        >
+    > matrix_type;
+
+    matrix_type m(7, 5, 3.0, 6);
+
+    HPX_TEST_EQ(7U, m.rows());
+    HPX_TEST_EQ(5U, m.columns());
+    HPX_TEST_EQ(6U, m.grid().rows * m.grid().cols);
+
+    for (boost::uint64_t i = 0; i < m.rows(); ++i)
+        for (boost::uint64_t j = 0; j < m.columns(); ++j)
+            HPX_TEST_EQ(3.0, m.lookup_sync(i, j));
+
+    typedef matrix_type::submatrix_type::local_matrix_type local_matrix_type;
+
+    // 7 x 5 elements, each 3.0.
+    HPX_TEST_EQ(105.0, m.reduce_sync(&block_sum<local_matrix_type>
+                                   , &plus<double>));
+
+    // Single blocks can be evaluated where they live.
+    matrix_bounds const e = m.block_extents(0, 0);
+    HPX_TEST_EQ(3.0 * e.rows * e.cols
+              , m.block(0, 0).evaluate_sync(&block_sum<local_matrix_type>
+                                          , matrix_bounds(0, 0), e));
+
+void test_block_cyclic_matrix()
+{
+    typedef distributed_matrix<
+        float
+      , distributed_matrix_policy<
+            column_major_indexing
+          , hpx::util::unused_type
+          , block_cyclic_distribution
+        >
+    > matrix_type;
+
+    matrix_type m(9, 5
+                , block_cyclic_distribution(matrix_bounds(1, 1)
+                                          , matrix_bounds(4, 2))
+                , 2.0f);
+
+    HPX_TEST_EQ(9U, m.rows());
+    HPX_TEST_EQ(5U, m.columns());
+    HPX_TEST_EQ(3U, m.grid().rows);
+    HPX_TEST_EQ(3U, m.grid().cols);
+
+    HPX_TEST_EQ(1U, m.block_extents(2, 2).rows);
+    HPX_TEST_EQ(1U, m.block_extents(2, 2).cols);
+
+    for (boost::uint64_t i = 0; i < m.rows(); ++i)
+        for (boost::uint64_t j = 0; j < m.columns(); ++j)
+            HPX_TEST_EQ(2.0f, m.lookup_sync(i, j));
+
+    typedef matrix_type::submatrix_type::local_matrix_type local_matrix_type;
+
+    HPX_TEST_EQ(2.0f, m.reduce_sync(&block_max<local_matrix_type>
+                                  , &maximum<float>));
+}
+
+void test_copy_on_write_matrix()
+{
+    typedef distributed_matrix<
+        double
+      , distributed_matrix_policy<
+            column_major_indexing
+          , hpx::util::unused_type
+          , hpx::util::unused_type
+          , std::allocator<hpx::util::unused_type>
+          , copy_on_write
+        >
+    > matrix_type;
+
+    typedef matrix_type::submatrix_type::local_matrix_type local_matrix_type;
+
+    // The blocks use the copy policy of the matrix.
+    HPX_TEST(local_matrix_type::copy_policy_type::lazy);
+
+    // A single block, on this locality.
+    matrix_type m(8, 6, 0.0, 1, std::vector<hpx::naming::id_type>(
+        1, hpx::find_here()));
+
+    // The block is loaded with a piece of a larger matrix, which it shares
+    // until either of them is written to.
+    local_matrix_type const source(10, 10, 5.0);
+    local_matrix_type const piece(source, matrix_bounds(8, 6)
+                                , matrix_offsets(1, 2));
+
+    copy_on_write::reset_statistics();
+
+    m.block(0, 0).initialize_sync(piece, matrix_offsets(1, 2));
+
+    for (boost::uint64_t i = 0; i < m.rows(); ++i)
+        for (boost::uint64_t j = 0; j < m.columns(); ++j)
+            HPX_TEST_EQ(5.0, m.lookup_sync(i, j));
+
+    copy_statistics s = copy_on_write::statistics();
+
+    HPX_TEST(0 < s.deferred);
+    HPX_TEST_EQ(0U, s.materialized);
+
+    // Writing to the block gives it storage of its own.
+    m.block(0, 0).put_region_sync(matrix_bounds(0, 0)
+                                , local_matrix_type(1, 1, 7.0));
+
+    HPX_TEST_EQ(7.0, m.lookup_sync(0, 0));
+    HPX_TEST_EQ(5.0, m.lookup_sync(1, 0));
+    HPX_TEST_EQ(5.0, source(1, 2));
+
+    s = copy_on_write::statistics();
+
+    HPX_TEST_EQ(1U, s.materialized);
+}
+
+int hpx_main()
+{
+    test_partitioning();
+    test_block_cyclic_distribution();
+    test_distributed_matrix();
+    test_block_cyclic_matrix();
+    test_copy_on_write_matrix();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(0, hpx::init(argc, argv));
+    return report_errors();
+}
+
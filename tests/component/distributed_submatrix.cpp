@@ -9,6 +9,7 @@ using hpxla::distributed_submatrix;
 using hpxla::server::rfc_distributed_submatrix;
 using hpxla::distributed_matrix_policy;
 using hpxla::policy::column_major_indexing;
+using hpxla::matrix_bounds;
 
 using hpx::find_here;
 
@@ -33,6 +34,49 @@ int hpx_main()
             }
         }
 
+        // Write a 2 x 3 region, then read back a region which overlaps it.
+        distributed_submatrix_type::local_matrix_type m(2, 3);
+
+        for(int r = 0; r < 2; r++) {
+            for(int c = 0; c < 3; c++) {
+                m(r, c) = float(10 * r + c);
+            }
+        }
+
+        dsm.put_region_async(matrix_bounds(1, 2), m).get();
+
+        distributed_submatrix_type::local_matrix_type region
+            = dsm.get_region_async(matrix_bounds(0, 1), matrix_bounds(4, 5))
+                .get();
+
+        HPX_TEST_EQ(region.rows(), 4U);
+        HPX_TEST_EQ(region.columns(), 4U);
+
+        for(int r = 0; r < 4; r++) {
+            for(int c = 0; c < 4; c++) {
+                bool const written = 1 <= r && r < 3 && 1 <= c;
+                HPX_TEST_EQ(region(r, c)
+                          , written ? float(10 * (r - 1) + (c - 1)) : 1.0f);
+            }
+        }
+
+        // Empty regions are allowed.
+        HPX_TEST(dsm.get_region_sync(matrix_bounds(2, 2)
+                                   , matrix_bounds(2, 2)).empty());
+
+        // Batched lookup.
+        std::vector<matrix_bounds> coords;
+        coords.push_back(matrix_bounds(0, 0));
+        coords.push_back(matrix_bounds(2, 4));
+        coords.push_back(matrix_bounds(1, 2));
+
+        std::vector<float> values = dsm.lookup_async(coords).get();
+
+        HPX_TEST_EQ(values.size(), 3U);
+        HPX_TEST_EQ(values[0], 1.0f);
+        HPX_TEST_EQ(values[1], 12.0f);
+        HPX_TEST_EQ(values[2], 0.0f);
+
     }
     return hpx::finalize();
 }
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpxla/local_matrix.hpp>
+#include <hpxla/policies/copy_policies.hpp>
+
+#include <sstream>
+#include <vector>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+using hpxla::local_matrix;
+using hpxla::local_matrix_policy;
+using hpxla::local_matrix_view;
+using hpxla::matrix_offsets;
+
+using hpxla::policy::column_major_indexing;
+using hpxla::policy::copy_on_write;
+using hpxla::policy::copy_statistics;
+
+using hpx::util::report_errors;
+using hpx::util::unused_type;
+
+typedef local_matrix<
+    double
+  , local_matrix_policy<
+        column_major_indexing
+      , std::allocator<unused_type>
+      , copy_on_write
+    >
+> cow_matrix;
+
+typedef cow_matrix::view_type cow_view;
+
+int main()
+{
+    std::size_t const bytes = 10 * 10 * sizeof(double);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Deferred copies
+    {
+        copy_on_write::reset_statistics();
+
+        cow_matrix const m0(10, 10, 1.0);
+        cow_matrix const m1(m0);
+
+        // Reading a copy doesn't duplicate the storage.
+        HPX_TEST_EQ(m0.data(), m1.data());
+        HPX_TEST_EQ(1.0, m1(9, 9));
+
+        std::vector<cow_matrix> v(3, m0);
+
+        for (std::size_t k = 0; k < v.size(); ++k)
+            HPX_TEST_EQ(m0.data()
+                      , static_cast<cow_matrix const&>(v[k]).data());
+
+        cow_matrix m2;
+        m2 = m1;
+
+        HPX_TEST_EQ(m0.data(), static_cast<cow_matrix const&>(m2).data());
+
+        copy_statistics const s = copy_on_write::statistics();
+
+        HPX_TEST_EQ(5U, s.deferred);
+        HPX_TEST_EQ(0U, s.materialized);
+        HPX_TEST_EQ(5U * bytes, s.saved_bytes());
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Materialized copies
+    {
+        copy_on_write::reset_statistics();
+
+        cow_matrix m0(10, 10, 1.0);
+        cow_matrix m1(m0);
+        cow_matrix m2(m0);
+
+        // Writing to a copy gives it storage of its own.
+        m1(0, 0) = 2.0;
+
+        HPX_TEST_EQ(1.0, m0(0, 0));
+        HPX_TEST_EQ(2.0, m1(0, 0));
+        HPX_TEST_EQ(1.0, m2(0, 0));
+
+        // So does writing to the original.
+        m0(1, 1) = 3.0;
+
+        HPX_TEST_EQ(3.0, m0(1, 1));
+        HPX_TEST_EQ(1.0, m1(1, 1));
+        HPX_TEST_EQ(1.0, m2(1, 1));
+
+        // The last owner of the storage writes to it in place.
+        double const* p2 = static_cast<cow_matrix const&>(m2).data();
+
+        m2(2, 2) = 4.0;
+
+        HPX_TEST_EQ(p2, m2.data());
+        HPX_TEST_EQ(1.0, m0(2, 2));
+        HPX_TEST_EQ(1.0, m1(2, 2));
+
+        copy_statistics const s = copy_on_write::statistics();
+
+        HPX_TEST_EQ(2U, s.deferred);
+        HPX_TEST_EQ(2U, s.materialized);
+        HPX_TEST_EQ(0U, s.saved_bytes());
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Views
+    {
+        copy_on_write::reset_statistics();
+
+        cow_matrix m0(10, 10, 1.0);
+        cow_matrix m1(m0);
+
+        // Taking a mutable view of a copy makes it stop sharing the storage.
+        cow_view v1 = m1.view();
+
+        v1(0, 0) = 2.0;
+
+        HPX_TEST_EQ(1.0, m0(0, 0));
+        HPX_TEST_EQ(2.0, m1(0, 0));
+
+        // A matrix is copied eagerly while views of it exist.
+        cow_matrix m2(m1);
+
+        HPX_TEST(static_cast<cow_matrix const&>(m1).data()
+              != static_cast<cow_matrix const&>(m2).data());
+
+        v1(0, 0) = 3.0;
+
+        HPX_TEST_EQ(3.0, m1(0, 0));
+        HPX_TEST_EQ(2.0, m2(0, 0));
+
+        copy_statistics const s = copy_on_write::statistics();
+
+        HPX_TEST_EQ(1U, s.deferred);
+        HPX_TEST_EQ(1U, s.materialized);
+    }
+
+    {
+        copy_on_write::reset_statistics();
+
+        cow_matrix m0(10, 10, 1.0);
+        cow_matrix m1(m0);
+
+        // A copy of the view of a const matrix can be written to, so taking
+        // it makes the matrix stop sharing the storage, too.
+        cow_view v1 = static_cast<cow_matrix const&>(m1).view();
+
+        v1(0, 0) = 2.0;
+
+        HPX_TEST_EQ(1.0, m0(0, 0));
+        HPX_TEST_EQ(2.0, m1(0, 0));
+
+        // A matrix which doesn't share its storage keeps it.
+        cow_matrix const m2(10, 10, 4.0);
+
+        HPX_TEST(m2.view().data() == m2.data());
+
+        copy_statistics const s = copy_on_write::statistics();
+
+        HPX_TEST_EQ(1U, s.deferred);
+        HPX_TEST_EQ(1U, s.materialized);
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Moves and serialization
+    {
+        cow_matrix m0(10, 10, 1.0);
+        cow_matrix m1(m0);
+
+        // The moved-to matrix takes over the sharing.
+        cow_matrix m2(boost::move(m1));
+
+        m2(0, 0) = 2.0;
+
+        HPX_TEST_EQ(1.0, m0(0, 0));
+        HPX_TEST_EQ(2.0, m2(0, 0));
+
+        // A deserialized matrix has storage of its own.
+        cow_matrix m3(m0);
+
+        std::stringstream ss;
+
+        {
+            boost::archive::binary_oarchive oa(ss);
+            oa << m0;
+        }
+
+        {
+            boost::archive::binary_iarchive ia(ss);
+            ia >> m3;
+        }
+
+        m3(0, 0) = 4.0;
+
+        HPX_TEST_EQ(1.0, m0(0, 0));
+        HPX_TEST_EQ(4.0, m3(0, 0));
+        HPX_TEST_EQ(1.0, m3(9, 9));
+    }
+    // }}}
+
+    return report_errors();
+}
+
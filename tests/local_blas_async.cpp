@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpxla/local_blas_async.hpp>
+#include <hpxla/compare_real.hpp>
+
+using namespace hpxla::blas;
+
+using hpxla::compare_real;
+
+using hpxla::local_matrix;
+using hpxla::local_matrix_policy;
+
+using hpxla::policy::column_major_indexing;
+using hpxla::policy::row_major_indexing;
+
+using hpx::util::report_errors;
+
+template <
+    typename Matrix
+>
+void test_real()
+{
+    typedef typename Matrix::value_type value_type;
+    typedef typename Matrix::view_type view_type;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Level 1
+    {
+        Matrix x{1, 2, 3, 4, 5}, y(5);
+
+        HPX_TEST(compare_real(15.0, async::asum(x).get()));
+        HPX_TEST_EQ(4U, async::iamax(x).get());
+
+        // y = 2 * (5 * x) 
+        hpx::future<view_type> fy = async::axpy(5, x, y);
+        fy = async::scal(2, boost::move(fy));
+
+        view_type vy = fy.get();
+
+        HPX_TEST_EQ(10, vy(0));
+        HPX_TEST_EQ(50, vy(4));
+
+        // The views share storage with y.
+        HPX_TEST_EQ(10, y(0));
+        HPX_TEST_EQ(50, y(4));
+
+        HPX_TEST(compare_real(550.0, async::dot(x, y).get()));
+    }
+
+    {
+        // Scalars can be futures, too.
+        Matrix x{1, 2, 3, 4, 5}, y(5);
+
+        hpx::future<value_type> a = async::nrm2(Matrix{3, 4});
+
+        async::axpy(boost::move(a), x, y).get();
+
+        HPX_TEST(compare_real(value_type(5),  y(0)));
+        HPX_TEST(compare_real(value_type(25), y(4)));
+
+        async::swap(x, y).get();
+
+        HPX_TEST(compare_real(value_type(25), x(4)));
+        HPX_TEST(compare_real(value_type(5),  y(4)));
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Level 2 and 3
+    {
+        Matrix a{ { 1, 2, 3 }
+                , { 4, 5, 6 } };
+
+        Matrix b{ { 7,  8  }
+                , { 9,  10 }
+                , { 11, 12 } };
+
+        Matrix x{ 1, 1 };
+
+        // (A * B) * x, expressed as a dataflow chain.
+        hpx::future<view_type> c = async::gemm(a, b, Matrix());
+        hpx::future<view_type> y = async::gemv(boost::move(c), x, Matrix());
+
+        view_type r = y.get();
+
+        HPX_TEST_EQ(2U, r.rows());
+        HPX_TEST_EQ(122, r(0));
+        HPX_TEST_EQ(293, r(1));
+    }
+    // }}}
+}
+
+int hpx_main()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    test_real<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                column_major_indexing
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                row_major_indexing
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                row_major_indexing
+            >
+        >
+    >();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(0, hpx::init(argc, argv));
+    return report_errors();
+}
+
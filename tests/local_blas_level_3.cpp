@@ -5,14 +5,211 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <hpx/hpx_init.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
 #include <hpxla/local_blas.hpp>
+#include <hpxla/compare_real.hpp>
+
+using namespace hpxla::blas;
+
+using hpxla::compare_real;
+
+using hpxla::local_matrix;
+using hpxla::local_matrix_policy;
+
+using hpxla::policy::column_major_indexing;
+using hpxla::policy::row_major_indexing;
+using hpxla::policy::tiled_indexing;
+using hpxla::policy::padded_column_major_indexing;
+using hpxla::policy::padded_row_major_indexing;
+using hpxla::policy::aligned_allocator;
 
 using hpx::util::report_errors;
 
-int main()
+template <
+    typename Matrix
+>
+void test_real()
+{
+    typedef typename Matrix::value_type value_type;
+    typedef typename Matrix::size_type size_type;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ GEMM
+    {
+        Matrix a{ { 1, 2, 3 }
+                , { 4, 5, 6 } };
+
+        Matrix b{ { 7,  8  }
+                , { 9,  10 }
+                , { 11, 12 } };
+
+        Matrix c;
+
+        // C is resized because beta is 0.
+        gemm(a, b, c);
+
+        HPX_TEST_EQ(2U, c.rows());
+        HPX_TEST_EQ(2U, c.columns());
+
+        HPX_TEST_EQ(58,  c(0, 0));
+        HPX_TEST_EQ(64,  c(0, 1));
+        HPX_TEST_EQ(139, c(1, 0));
+        HPX_TEST_EQ(154, c(1, 1));
+
+        // C = 2 * A * B + C
+        gemm(a, b, c, 2, 1);
+
+        HPX_TEST_EQ(174, c(0, 0));
+        HPX_TEST_EQ(192, c(0, 1));
+        HPX_TEST_EQ(417, c(1, 0));
+        HPX_TEST_EQ(462, c(1, 1));
+    }
+
+    {
+        // A^T * B^T
+        Matrix a{ { 1, 4 }
+                , { 2, 5 }
+                , { 3, 6 } };
+
+        Matrix b{ { 7, 9,  11 }
+                , { 8, 10, 12 } };
+
+        Matrix c;
+
+        gemm(a, b, c, 1, 0, transpose, transpose);
+
+        HPX_TEST_EQ(2U, c.rows());
+        HPX_TEST_EQ(2U, c.columns());
+
+        HPX_TEST_EQ(58,  c(0, 0));
+        HPX_TEST_EQ(64,  c(0, 1));
+        HPX_TEST_EQ(139, c(1, 0));
+        HPX_TEST_EQ(154, c(1, 1));
+    }
+
+    {
+        // Large enough to be split into several tiles, including partial tiles
+        // along the bottom and right edges of C.
+        size_type const m = HPXLA_GEMM_TILE_SIZE + 17;
+        size_type const n = 2 * HPXLA_GEMM_TILE_SIZE + 3;
+        size_type const k = 31;
+
+        Matrix a(m, k), b(k, n), c(m, n, 1);
+
+        for (size_type i = 0; i < m; ++i)
+            for (size_type l = 0; l < k; ++l)
+                a(i, l) = value_type((i + l) % 7);
+
+        for (size_type l = 0; l < k; ++l)
+            for (size_type j = 0; j < n; ++j)
+                b(l, j) = value_type((l * j) % 5) - 2;
+
+        gemm(a, b, c, 2, 1);
+
+        for (size_type i = 0; i < m; ++i)
+        {
+            for (size_type j = 0; j < n; ++j)
+            {
+                value_type r = 0;
+
+                for (size_type l = 0; l < k; ++l)
+                    r += a(i, l) * b(l, j);
+
+                HPX_TEST(compare_real(2 * r + 1, c(i, j)));
+            }
+        }
+    }
+    // }}}
+}
+
+int hpx_main()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    test_real<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                column_major_indexing
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                row_major_indexing
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                row_major_indexing
+            >
+        >
+    >();
+
+    // Tile sizes which do not divide the matrix dimensions, so that the blocks
+    // of A, B and C are not aligned with each other.
+    test_real<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                tiled_indexing<7, 5>
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                tiled_indexing<16, 3>
+            >
+        >
+    >();
+
+    // Leading dimensions which are larger than the matrix dimensions.
+    test_real<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                padded_column_major_indexing<>
+              , aligned_allocator<hpx::util::unused_type>
+            >
+        >
+    >();
+
+    test_real<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                padded_row_major_indexing<>
+              , aligned_allocator<hpx::util::unused_type>
+            >
+        >
+    >();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
 {
+    HPX_TEST_EQ(0, hpx::init(argc, argv));
     return report_errors();
 }
 
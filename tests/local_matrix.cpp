@@ -8,6 +8,13 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <hpxla/local_matrix.hpp>
+#include <hpxla/storage_buffer.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+
+#include <sstream>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
 
 // NOTE: The view() method of local_matrix<> is tested in local_matrix_view.cpp.
 // The order() and leading_dimension() methods are tested in the local BLAS
@@ -16,9 +23,19 @@
 using hpxla::local_matrix;
 using hpxla::local_matrix_policy;
 using hpxla::matrix_bounds;
+using hpxla::matrix_offsets;
+using hpxla::storage_buffer;
 
 using hpxla::policy::column_major_indexing;
 using hpxla::policy::row_major_indexing;
+using hpxla::policy::tiled_indexing;
+using hpxla::policy::pool_allocator;
+using hpxla::policy::arena_allocator;
+using hpxla::policy::aligned_allocator;
+using hpxla::policy::default_init_allocator;
+using hpxla::policy::copy_on_write;
+using hpxla::policy::padded_column_major_indexing;
+using hpxla::policy::padded_row_major_indexing;
 
 using hpx::util::report_errors;
 
@@ -27,6 +44,8 @@ template <
 >
 void test()
 {
+    typedef typename Matrix::indexing_policy_type indexer;
+
     ///////////////////////////////////////////////////////////////////////////
     // Constructors.
 
@@ -209,6 +228,46 @@ void test()
         HPX_TEST_EQ(m2(1, 1), 1);
     } // }}}
 
+    { // {{{ First-touch ctor.
+        Matrix m0(37, 19, 5, hpxla::first_touch);
+
+        HPX_TEST(!m0.empty());
+
+        HPX_TEST_EQ(37U, m0.rows());
+        HPX_TEST_EQ(19U, m0.columns());
+
+        for (std::size_t i = 0; i < m0.rows(); ++i)
+            for (std::size_t j = 0; j < m0.columns(); ++j)
+                HPX_TEST_EQ(m0(i, j), 5);
+
+        Matrix m1(0, 3, 5, hpxla::first_touch);
+
+        HPX_TEST(m1.empty());
+    } // }}}
+
+    { // {{{ Uninitialized ctor.
+        typedef typename Matrix::value_type value_type;
+
+        Matrix m0(37, 19, hpxla::uninitialized);
+
+        HPX_TEST(!m0.empty());
+
+        HPX_TEST_EQ(37U, m0.rows());
+        HPX_TEST_EQ(19U, m0.columns());
+
+        for (std::size_t i = 0; i < m0.rows(); ++i)
+            for (std::size_t j = 0; j < m0.columns(); ++j)
+                m0(i, j) = value_type(i * 100 + j);
+
+        for (std::size_t i = 0; i < m0.rows(); ++i)
+            for (std::size_t j = 0; j < m0.columns(); ++j)
+                HPX_TEST_EQ(m0(i, j), value_type(i * 100 + j));
+
+        Matrix m1(3, 0, hpxla::uninitialized);
+
+        HPX_TEST(m1.empty());
+    } // }}}
+
     { // {{{ Copy ctor.
         Matrix m0{ { 17, 42 }
                  , { 42, 17 } };
@@ -285,6 +344,116 @@ void test()
         HPX_TEST_EQ(0U, m0.columns());
     } // }}}
 
+    { // {{{ Move + offsets ctor.
+        Matrix m0(4, 3, 5);
+
+        typename Matrix::const_pointer p0 = &m0(0, 0);
+
+        Matrix m1(boost::move(m0), matrix_offsets(1, 1));
+
+        // The storage must have been handed over, not copied.
+        HPX_TEST(m0.empty());
+        HPX_TEST_EQ(p0, &m1(0, 0) - indexer::index(0, 0, matrix_bounds(4, 3)
+                                                , matrix_offsets(1, 1)));
+    } // }}}
+
+    { // {{{ Storage adoption ctor.
+        typedef typename Matrix::storage_type storage_type;
+        typedef typename Matrix::value_type value_type;
+
+        matrix_bounds bounds(3, 2);
+
+        storage_type s(indexer::storage_size(bounds));
+
+        for (std::size_t i = 0; i < bounds.rows; ++i)
+            for (std::size_t j = 0; j < bounds.cols; ++j)
+                s[indexer::index(i, j, bounds)] = value_type(i * 10 + j);
+
+        typename Matrix::const_pointer p0 = s.data();
+
+        Matrix m0(boost::move(s), 3, 2);
+
+        HPX_TEST_EQ(3U, m0.rows());
+        HPX_TEST_EQ(2U, m0.columns());
+
+        // The buffer must have been adopted without reallocating it.
+        HPX_TEST_EQ(p0, m0.data());
+
+        HPX_TEST_EQ(m0(0, 0), 0);
+        HPX_TEST_EQ(m0(1, 0), 10);
+        HPX_TEST_EQ(m0(2, 1), 21);
+    } // }}}
+
+    { // {{{ Storage buffers.
+        typedef storage_buffer<Matrix> buffer_type;
+        typedef typename Matrix::storage_type storage_type;
+        typedef typename Matrix::const_pointer const_pointer;
+        typedef typename Matrix::value_type value_type;
+
+        Matrix m0(4, 3);
+
+        for (std::size_t i = 0; i < m0.rows(); ++i)
+            for (std::size_t j = 0; j < m0.columns(); ++j)
+                m0(i, j) = value_type(i * 10 + j);
+
+        HPX_TEST(m0.whole());
+        HPX_TEST(!Matrix(m0, matrix_bounds(2, 2)).whole());
+
+        std::stringstream ss;
+
+        {
+            boost::archive::binary_oarchive oa(ss);
+            buffer_type const b(m0, buffer_type::reference);
+            oa << b;
+        }
+
+        buffer_type r;
+
+        {
+            boost::archive::binary_iarchive ia(ss);
+            ia >> r;
+        }
+
+        HPX_TEST_EQ(4U, r.bounds().rows);
+        HPX_TEST_EQ(3U, r.bounds().cols);
+
+        // The received storage is adopted without reallocating it.
+        storage_type s;
+        r.release(s);
+
+        const_pointer const p0 = s.data();
+
+        Matrix m1(boost::move(s), 4, 3);
+
+        HPX_TEST_EQ(p0, static_cast<Matrix const&>(m1).data());
+
+        for (std::size_t i = 0; i < m1.rows(); ++i)
+            for (std::size_t j = 0; j < m1.columns(); ++j)
+                HPX_TEST_EQ(m0(i, j), m1(i, j));
+
+        // Taking the storage of a matrix doesn't copy it either.
+        const_pointer const p1 = static_cast<Matrix const&>(m1).data();
+
+        buffer_type t(boost::move(m1));
+
+        HPX_TEST(m1.empty());
+
+        storage_type s1;
+        t.release(s1);
+
+        HPX_TEST_EQ(p1, s1.data());
+
+        // Storage that is still referenced by a matrix is copied.
+        buffer_type c(m0, buffer_type::reference);
+
+        storage_type s2;
+        c.release(s2);
+
+        HPX_TEST(static_cast<Matrix const&>(m0).data() != s2.data());
+        HPX_TEST_EQ(s2[indexer::index(3, 2, matrix_bounds(4, 3))]
+                  , value_type(32));
+    } // }}}
+
     ///////////////////////////////////////////////////////////////////////////
     // Assignment operators.
 
@@ -417,7 +586,6 @@ void test()
 
     { // {{{ Raw access and indexing.
         typedef typename Matrix::pointer pointer;
-        typedef typename Matrix::indexing_policy_type indexer;
 
         Matrix m0{ { 1, 2, 3 }
                  , { 4, 5, 6 } };
@@ -450,6 +618,40 @@ void test()
         HPX_TEST_EQ(m0(1, 2), 7);
         HPX_TEST_EQ(p0[indexer::index(1, 2, bounds)], 7); 
     } // }}} 
+
+    ///////////////////////////////////////////////////////////////////////////
+
+    { // {{{ Tile extents.
+        typedef typename Matrix::pointer pointer;
+        typedef typename Matrix::size_type size_type;
+
+        Matrix m0(5, 7);
+
+        size_type const ld = m0.leading_dimension();
+        bool const column_major = hpxla::blas::column_major == m0.index_order();
+
+        // Every element of the block returned by tile_extents() must be
+        // reachable from the first element of the block through the leading
+        // dimension.
+        for (size_type i = 0; i < m0.rows(); ++i)
+        {
+            for (size_type j = 0; j < m0.columns(); ++j)
+            {
+                matrix_bounds const t = m0.tile_extents(i, j);
+
+                HPX_TEST(0 < t.rows && i + t.rows <= m0.rows());
+                HPX_TEST(0 < t.cols && j + t.cols <= m0.columns());
+
+                pointer p = &m0(i, j);
+
+                for (size_type k = 0; k < t.rows; ++k)
+                    for (size_type l = 0; l < t.cols; ++l)
+                        HPX_TEST_EQ(p + (column_major ? l * ld + k
+                                                      : k * ld + l)
+                                  , &m0(i + k, j + l));
+            }
+        }
+    } // }}}
 }
 
 int main()
@@ -491,6 +693,108 @@ int main()
         >
     >();
 
+    test<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                tiled_indexing<2, 2>
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                tiled_indexing<2, 3>
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+              , pool_allocator<hpx::util::unused_type>
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                tiled_indexing<2, 2>
+              , arena_allocator<hpx::util::unused_type>
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                padded_column_major_indexing<>
+              , aligned_allocator<hpx::util::unused_type>
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                padded_row_major_indexing<4>
+              , aligned_allocator<hpx::util::unused_type, 128>
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+              , default_init_allocator<std::allocator<hpx::util::unused_type> >
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                tiled_indexing<4, 3>
+              , default_init_allocator<
+                    aligned_allocator<hpx::util::unused_type>
+                >
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+              , std::allocator<hpx::util::unused_type>
+              , copy_on_write
+            >
+        >
+    >();
+
+    test<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                tiled_indexing<2, 3>
+              , pool_allocator<hpx::util::unused_type>
+              , copy_on_write
+            >
+        >
+    >();
+
     return report_errors();
 }
 
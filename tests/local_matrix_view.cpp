@@ -8,11 +8,185 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <hpxla/local_matrix_view.hpp>
+#include <hpxla/local_matrix.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+
+#include <sstream>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+
+using hpxla::local_matrix_view;
+using hpxla::local_matrix_policy;
+using hpxla::matrix_bounds;
+using hpxla::matrix_offsets;
+
+using hpxla::policy::column_major_indexing;
+using hpxla::policy::default_init_allocator;
+using hpxla::policy::row_major_indexing;
+using hpxla::policy::tiled_indexing;
+using hpxla::policy::padded_column_major_indexing;
+using hpxla::policy::padded_row_major_indexing;
 
 using hpx::util::report_errors;
+using hpx::util::unused_type;
+
+template <
+    typename View
+>
+View round_trip(
+    View const& v
+    )
+{
+    std::stringstream ss;
+
+    {
+        boost::archive::binary_oarchive oa(ss);
+        oa << v;
+    }
+
+    View r;
+
+    {
+        boost::archive::binary_iarchive ia(ss);
+        ia >> r;
+    }
+
+    return r;
+}
+
+template <
+    typename View
+>
+void test()
+{
+    typedef typename View::size_type size_type;
+    typedef typename View::value_type value_type;
+
+    View m0(6, 5);
+
+    for (size_type i = 0; i < m0.rows(); ++i)
+        for (size_type j = 0; j < m0.columns(); ++j)
+            m0(i, j) = value_type(i * 10 + j);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Serialization.
+
+    { // {{{ Whole matrix.
+        View r = round_trip(m0);
+
+        HPX_TEST_EQ(m0.rows(), r.rows());
+        HPX_TEST_EQ(m0.columns(), r.columns());
+
+        for (size_type i = 0; i < r.rows(); ++i)
+            for (size_type j = 0; j < r.columns(); ++j)
+                HPX_TEST_EQ(m0(i, j), r(i, j));
+    } // }}}
+
+    { // {{{ Subview.
+        View v(m0, matrix_bounds(3, 2), matrix_offsets(2, 1));
+
+        View r = round_trip(v);
+
+        HPX_TEST_EQ(3U, r.rows());
+        HPX_TEST_EQ(2U, r.columns());
+
+        for (size_type i = 0; i < r.rows(); ++i)
+            for (size_type j = 0; j < r.columns(); ++j)
+                HPX_TEST_EQ(v(i, j), r(i, j));
+    } // }}}
+
+    { // {{{ Empty.
+        View r = round_trip(View());
+
+        HPX_TEST_EQ(0U, r.rows());
+        HPX_TEST_EQ(0U, r.columns());
+    } // }}}
+}
 
 int main()
 {
+    ///////////////////////////////////////////////////////////////////////////
+    test<
+        local_matrix_view<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+            >
+        >
+    >();
+
+    test<
+        local_matrix_view<
+            double
+          , local_matrix_policy<
+                row_major_indexing
+            >
+        >
+    >();
+
+    test<
+        local_matrix_view<
+            double
+          , local_matrix_policy<
+                tiled_indexing<4, 2>
+            >
+        >
+    >();
+
+    test<
+        local_matrix_view<
+            double
+          , local_matrix_policy<
+                padded_column_major_indexing<8>
+            >
+        >
+    >();
+
+    test<
+        local_matrix_view<
+            double
+          , local_matrix_policy<
+                padded_row_major_indexing<8>
+            >
+        >
+    >();
+
+    // Deserialized storage isn't initialized before it is read.
+    test<
+        local_matrix_view<
+            double
+          , local_matrix_policy<
+                tiled_indexing<4, 2>
+              , default_init_allocator<std::allocator<unused_type> >
+            >
+        >
+    >();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Single tile views.
+    {
+        typedef local_matrix_view<
+            double
+          , local_matrix_policy<
+                tiled_indexing<4, 2>
+            >
+        > tiled_view;
+
+        tiled_view m0(6, 5);
+
+        HPX_TEST(!m0.in_single_tile());
+        HPX_TEST(tiled_view(m0, matrix_bounds(4, 2)).in_single_tile());
+        HPX_TEST(tiled_view(m0, matrix_bounds(2, 1), matrix_offsets(4, 2))
+                     .in_single_tile());
+        HPX_TEST(!tiled_view(m0, matrix_bounds(2, 1), matrix_offsets(3, 0))
+                      .in_single_tile());
+        HPX_TEST(tiled_view().in_single_tile());
+
+        HPX_TEST(local_matrix_view<double>(6, 5).in_single_tile());
+    }
+    // }}}
+
     return report_errors();
 }
 
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpxla/local_matrix.hpp>
+#include <hpxla/numa.hpp>
+#include <hpxla/policies/allocation_policies.hpp>
+
+#include <cstring>
+#include <new>
+
+using hpxla::first_touch;
+using hpxla::get_page_placement;
+using hpxla::local_matrix;
+using hpxla::local_matrix_policy;
+using hpxla::page_placement;
+
+using hpxla::policy::aligned_allocator;
+using hpxla::policy::column_major_indexing;
+using hpxla::policy::default_init_allocator;
+using hpxla::policy::padded_column_major_indexing;
+using hpxla::policy::tiled_indexing;
+
+using hpx::util::report_errors;
+using hpx::util::unused_type;
+
+template <
+    typename Matrix
+>
+void test_first_touch(
+    boost::uint64_t rows
+  , boost::uint64_t cols
+    )
+{
+    typedef typename Matrix::value_type value_type;
+
+    Matrix m(rows, cols, value_type(3), first_touch);
+
+    HPX_TEST_EQ(rows, m.rows());
+    HPX_TEST_EQ(cols, m.columns());
+
+    boost::uint64_t wrong = 0;
+
+    for (boost::uint64_t j = 0; j < cols; ++j)
+        for (boost::uint64_t i = 0; i < rows; ++i)
+            if (value_type(3) != m(i, j))
+                ++wrong;
+
+    HPX_TEST_EQ(0U, wrong);
+
+    // Every page of the matrix has been touched.
+    page_placement const p = get_page_placement(m);
+
+    HPX_TEST(0 < p.pages());
+    HPX_TEST_EQ(0U, p.unplaced);
+}
+
+int hpx_main()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ First-touch initialization
+    test_first_touch<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+              , default_init_allocator<std::allocator<unused_type> >
+            >
+        >
+    >(1000, 700);
+
+    test_first_touch<
+        local_matrix<
+            float
+          , local_matrix_policy<
+                padded_column_major_indexing<>
+              , default_init_allocator<aligned_allocator<unused_type> >
+            >
+        >
+    >(513, 1025);
+
+    test_first_touch<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                tiled_indexing<64, 64>
+              , default_init_allocator<std::allocator<unused_type> >
+            >
+        >
+    >(300, 200);
+
+    // Without default_init_allocator, the storage is also initialized by the
+    // vector, but the result is the same.
+    test_first_touch<
+        local_matrix<
+            double
+          , local_matrix_policy<
+                column_major_indexing
+            >
+        >
+    >(100, 100);
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Page placement
+    {
+        std::size_t const bytes = 64 * 1024 * 1024;
+
+        char* p = static_cast<char*>(::operator new(bytes));
+
+        page_placement const before = get_page_placement(p, bytes);
+
+        std::memset(p, 1, bytes);
+
+        page_placement const after = get_page_placement(p, bytes);
+
+        HPX_TEST_EQ(before.pages(), after.pages());
+        HPX_TEST(bytes / 4096 <= after.pages());
+        HPX_TEST_EQ(0U, after.unplaced);
+
+        // Most of a large block hasn't been touched before it is written.
+        if (0 == before.unknown)
+            HPX_TEST(before.pages() / 2 < before.unplaced);
+
+        ::operator delete(p);
+
+        HPX_TEST_EQ(0U, get_page_placement(p, 0).pages());
+    }
+    // }}}
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(0, hpx::init(argc, argv));
+    return report_errors();
+}
+
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+// Compares the throughput of local_matrix_view<>'s serialization, which writes
+// contiguous blocks of storage, with serializing each element individually.
+
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <hpxla/local_matrix.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/program_options.hpp>
+
+using hpxla::local_matrix_view;
+using hpxla::local_matrix_policy;
+using hpxla::matrix_bounds;
+using hpxla::matrix_offsets;
+
+using hpxla::policy::column_major_indexing;
+
+typedef local_matrix_view<
+    double
+  , local_matrix_policy<column_major_indexing>
+> view_type;
+
+typedef view_type::size_type size_type;
+
+// The element-by-element serialization that local_matrix_view<> used to do.
+struct per_element
+{
+    static char const* name()
+    {
+        return "Per-Element";
+    }
+
+    template <
+        typename Archive
+    >
+    static void save(
+        Archive& ar
+      , view_type const& v
+        )
+    {
+        matrix_bounds extents(v.rows(), v.columns());
+
+        ar & extents;
+
+        for (size_type i = 0; i < v.rows(); ++i)
+            for (size_type j = 0; j < v.columns(); ++j)
+                ar & v(i, j);
+    }
+};
+
+struct bulk
+{
+    static char const* name()
+    {
+        return "Bulk";
+    }
+
+    template <
+        typename Archive
+    >
+    static void save(
+        Archive& ar
+      , view_type const& v
+        )
+    {
+        ar & v;
+    }
+};
+
+template <
+    typename Path
+>
+void benchmark(
+    char const* layout
+  , view_type const& v
+  , std::size_t iterations
+    )
+{
+    std::stringstream ss;
+    std::size_t bytes = 0;
+
+    hpx::util::high_resolution_timer t;
+
+    for (std::size_t x = 0; x < iterations; ++x)
+    {
+        ss.str(std::string());
+
+        {
+            boost::archive::binary_oarchive oa(ss
+              , boost::archive::no_header | boost::archive::no_tracking);
+            Path::save(oa, v);
+        }
+
+        bytes += ss.str().size();
+    }
+
+    double runtime = t.elapsed();
+
+    std::cout << layout << ","
+              << v.rows() << ","
+              << v.columns() << ","
+              << Path::name() << ","
+              << iterations << ","
+              << bytes << ","
+              << runtime << ","
+              << (bytes / runtime) / (1024 * 1024) << "\n";
+}
+
+int main(int argc, char** argv)
+{
+    using namespace boost::program_options;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Parse command line.
+    variables_map vm;
+
+    options_description cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "help,h"
+        , "print out program usage (this message)")
+
+        ( "size"
+        , value<size_type>()->default_value(1024)
+        , "number of rows and columns of the matrix")
+
+        ( "iterations"
+        , value<std::size_t>()->default_value(16)
+        , "number of times to serialize each matrix")
+
+        ( "no-header"
+        , "do not print out the CSV header for the benchmark data")
+        ;
+
+    store(command_line_parser(argc, argv).options(cmdline).run(), vm);
+
+    notify(vm);
+
+    // Print help screen.
+    if (vm.count("help"))
+    {
+        std::cout << cmdline;
+        return 0;
+    }
+
+    size_type const n = vm["size"].as<size_type>();
+    std::size_t const iterations = vm["iterations"].as<std::size_t>();
+
+    view_type m(n, n);
+
+    for (size_type i = 0; i < n; ++i)
+        for (size_type j = 0; j < n; ++j)
+            m(i, j) = double(i * n + j);
+
+    // Every column of this view is contiguous, but the view as a whole is not.
+    view_type sub(m, matrix_bounds(n / 2, n / 2), matrix_offsets(n / 4, n / 4));
+
+    if (!vm.count("no-header"))
+        std::cout
+            << "HPXLA Local Matrix Serialization Performance\n"
+            << "Layout,Rows,Columns,Path,Iterations,Bytes,"
+               "Total Walltime (s),Throughput (MB/s)\n";
+
+    benchmark<per_element>("Whole", m, iterations);
+    benchmark<bulk>("Whole", m, iterations);
+
+    benchmark<per_element>("Subview", sub, iterations);
+    benchmark<bulk>("Subview", sub, iterations);
+
+    return 0;
+}
+
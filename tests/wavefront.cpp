@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2012 Bryce Adelstein-Lelbach
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <hpxla/wavefront.hpp>
+#include <hpxla/local_matrix.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/atomic.hpp>
+
+using hpxla::for_each_wavefront;
+using hpxla::local_matrix;
+using hpxla::matrix_bounds;
+
+using hpx::util::report_errors;
+
+// Numbers each tile in the order it runs, after checking that the tiles it
+// depends on have already been numbered. Tiles which are never run are -2.
+struct number_tiles
+{
+    number_tiles(
+        local_matrix<boost::int64_t>& order_
+      , boost::atomic<boost::int64_t>& next_
+      , boost::atomic<boost::uint64_t>& early_
+        )
+      : order(order_)
+      , next(next_)
+      , early(early_)
+    {}
+
+    void operator()(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        if (  (i != 0 && order(i - 1, j) == -1)
+           || (j != 0 && order(i, j - 1) == -1))
+            ++early;
+
+        order(i, j) = next++;
+    }
+
+    local_matrix<boost::int64_t>& order;
+    boost::atomic<boost::int64_t>& next;
+    boost::atomic<boost::uint64_t>& early;
+};
+
+void test_order(
+    matrix_bounds grid
+    )
+{
+    local_matrix<boost::int64_t> order(grid.rows, grid.cols, -1);
+    boost::atomic<boost::int64_t> next(0);
+    boost::atomic<boost::uint64_t> early(0);
+
+    for_each_wavefront(grid, number_tiles(order, next, early));
+
+    HPX_TEST_EQ(boost::int64_t(grid.rows * grid.cols), next.load());
+    HPX_TEST_EQ(0U, early.load());
+
+    for (boost::uint64_t j = 0; j < grid.cols; ++j)
+        for (boost::uint64_t i = 0; i < grid.rows; ++i)
+            HPX_TEST(0 <= order(i, j));
+}
+
+// The tiles within width of the diagonal which is offset columns to the
+// right of the main one.
+struct band
+{
+    band(
+        boost::int64_t offset_
+      , boost::int64_t width_
+        )
+      : offset(offset_)
+      , width(width_)
+    {}
+
+    std::pair<boost::uint64_t, boost::uint64_t> operator()(
+        boost::uint64_t i
+        ) const
+    {
+        boost::int64_t const zero = 0;
+        boost::int64_t const first = boost::int64_t(i) + offset - width;
+        boost::int64_t const last = boost::int64_t(i) + offset + width + 1;
+
+        return std::make_pair(boost::uint64_t((std::max)(first, zero))
+                            , boost::uint64_t((std::max)(last, zero)));
+    }
+
+    bool contains(
+        boost::uint64_t i
+      , boost::uint64_t j
+        ) const
+    {
+        std::pair<boost::uint64_t, boost::uint64_t> const c = (*this)(i);
+        return c.first <= j && j < c.second;
+    }
+
+    boost::int64_t offset;
+    boost::int64_t width;
+};
+
+void test_band_order(
+    matrix_bounds grid
+  , band b
+    )
+{
+    local_matrix<boost::int64_t> order(grid.rows, grid.cols, -1);
+    boost::atomic<boost::int64_t> next(0);
+    boost::atomic<boost::uint64_t> early(0);
+
+    boost::int64_t tiles = 0;
+
+    for (boost::uint64_t j = 0; j < grid.cols; ++j)
+    {
+        for (boost::uint64_t i = 0; i < grid.rows; ++i)
+        {
+            if (b.contains(i, j))
+                ++tiles;
+            else
+                order(i, j) = -2;
+        }
+    }
+
+    for_each_wavefront(grid, number_tiles(order, next, early), b);
+
+    HPX_TEST_EQ(0U, early.load());
+
+    for (boost::uint64_t j = 0; j < grid.cols; ++j)
+    {
+        for (boost::uint64_t i = 0; i < grid.rows; ++i)
+        {
+            if (b.contains(i, j))
+                HPX_TEST(0 <= order(i, j));
+            else
+                HPX_TEST_EQ(-2, order(i, j));
+        }
+    }
+
+    HPX_TEST_EQ(tiles, next.load());
+}
+
+// Throws from one tile.
+struct throw_at
+{
+    throw_at(
+        boost::uint64_t i_
+      , boost::uint64_t j_
+      , boost::atomic<boost::uint64_t>& after_
+        )
+      : i(i_)
+      , j(j_)
+      , after(after_)
+    {}
+
+    void operator()(
+        boost::uint64_t i_
+      , boost::uint64_t j_
+        ) const
+    {
+        if (i_ == i && j_ == j)
+            throw std::runtime_error("tile failed");
+
+        // The successors of the tile which throws must not run.
+        if (i_ >= i && j_ >= j)
+            ++after;
+    }
+
+    boost::uint64_t i;
+    boost::uint64_t j;
+    boost::atomic<boost::uint64_t>& after;
+};
+
+int hpx_main()
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Dependencies
+    test_order(matrix_bounds(1, 1));
+    test_order(matrix_bounds(1, 17));
+    test_order(matrix_bounds(17, 1));
+    test_order(matrix_bounds(8, 8));
+    test_order(matrix_bounds(31, 57));
+    test_order(matrix_bounds(200, 3));
+
+    test_band_order(matrix_bounds(20, 20), band(0, 0));
+    test_band_order(matrix_bounds(20, 20), band(0, 2));
+    test_band_order(matrix_bounds(30, 12), band(-5, 3));
+    test_band_order(matrix_bounds(12, 30), band(7, 1));
+
+    // Rows which miss the grid entirely.
+    test_band_order(matrix_bounds(40, 10), band(-15, 2));
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Empty grids
+    {
+        boost::atomic<boost::uint64_t> after(0);
+
+        for_each_wavefront(matrix_bounds(0, 5), throw_at(0, 0, after));
+        for_each_wavefront(matrix_bounds(5, 0), throw_at(0, 0, after));
+    }
+    // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // {{{ Exceptions
+    {
+        boost::atomic<boost::uint64_t> after(0);
+
+        bool caught = false;
+
+        try
+        {
+            for_each_wavefront(matrix_bounds(9, 13), throw_at(4, 6, after));
+        }
+
+        catch (std::runtime_error const&)
+        {
+            caught = true;
+        }
+
+        HPX_TEST(caught);
+        HPX_TEST_EQ(0U, after.load());
+    }
+    // }}}
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(0, hpx::init(argc, argv));
+    return report_errors();
+}
+